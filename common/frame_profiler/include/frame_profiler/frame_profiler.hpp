@@ -0,0 +1,94 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FRAME_PROFILER__FRAME_PROFILER_HPP_
+#define FRAME_PROFILER__FRAME_PROFILER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace frame_profiler
+{
+using Clock = std::chrono::steady_clock;
+
+/// @note number of zones each thread keeps; older zones are overwritten once the buffer is full
+constexpr std::size_t zone_capacity = 1 << 16;
+
+/**
+ * @brief Whether zones are recorded.
+ * @note Initially true only if the environment variable FRAME_PROFILER_OUTPUT is set. It names the
+ * file the Chrome trace is written to when the process exits.
+ */
+auto enabled() noexcept -> bool;
+
+auto enable(bool) noexcept -> void;
+
+/**
+ * @brief Append a zone to the ring buffer of the calling thread.
+ * @param name must outlive the profiler, i.e. a string literal or __func__.
+ */
+auto record(const char * name, Clock::time_point begin, Clock::time_point end) -> void;
+
+/// @brief Drop every zone recorded so far by every thread.
+auto clear() -> void;
+
+/**
+ * @brief Write the recorded zones as Chrome trace event JSON.
+ * @note The format is accepted by chrome://tracing and ui.perfetto.dev alike.
+ */
+auto writeChromeTrace(std::ostream &) -> void;
+
+auto writeChromeTrace(const std::string & path) -> void;
+
+class ScopedZone
+{
+public:
+  explicit ScopedZone(const char * name) noexcept
+  : name_(enabled() ? name : nullptr), begin_(name_ ? Clock::now() : Clock::time_point())
+  {
+  }
+
+  ~ScopedZone()
+  {
+    if (name_) {
+      record(name_, begin_, Clock::now());
+    }
+  }
+
+  ScopedZone(const ScopedZone &) = delete;
+
+  auto operator=(const ScopedZone &) -> ScopedZone & = delete;
+
+private:
+  const char * const name_;
+
+  const Clock::time_point begin_;
+};
+}  // namespace frame_profiler
+
+#define FRAME_PROFILER_CONCATENATE_(A, B) A##B
+#define FRAME_PROFILER_CONCATENATE(A, B) FRAME_PROFILER_CONCATENATE_(A, B)
+
+/// @note expands to nothing unless built with -DFRAME_PROFILER_ENABLED=ON
+#ifdef FRAME_PROFILER_ENABLED
+#define FRAME_PROFILER_ZONE(NAME)                                \
+  const ::frame_profiler::ScopedZone FRAME_PROFILER_CONCATENATE( \
+    frame_profiler_zone_, __LINE__)(NAME)
+#else
+#define FRAME_PROFILER_ZONE(NAME) static_cast<void>(0)
+#endif
+
+#endif  // FRAME_PROFILER__FRAME_PROFILER_HPP_
@@ -0,0 +1,200 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <frame_profiler/frame_profiler.hpp>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace frame_profiler
+{
+namespace
+{
+struct Zone
+{
+  const char * name;
+
+  Clock::time_point begin;
+
+  Clock::time_point end;
+};
+
+class ZoneBuffer
+{
+public:
+  explicit ZoneBuffer(std::uint32_t id) : thread_id(id), zones_(zone_capacity) {}
+
+  auto push(const Zone & zone) -> void
+  {
+    /// @note only contended while a trace is being written
+    std::lock_guard<std::mutex> lock(mutex_);
+    zones_[count_++ % zones_.size()] = zone;
+  }
+
+  auto clear() -> void
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    count_ = 0;
+  }
+
+  template <typename Function>
+  auto forEach(Function && function) const -> void
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto i = count_ > zones_.size() ? count_ - zones_.size() : 0; i < count_; ++i) {
+      function(zones_[i % zones_.size()]);
+    }
+  }
+
+  const std::uint32_t thread_id;
+
+private:
+  mutable std::mutex mutex_;
+
+  std::vector<Zone> zones_;
+
+  std::size_t count_ = 0;
+};
+
+/// @note "ts" counts from the epoch of steady_clock, which is shared by every process on the host,
+/// so the traces of the processes of one simulation line up when opened together.
+auto write(std::ostream & os, const std::vector<std::shared_ptr<ZoneBuffer>> & buffers) -> void
+{
+  const auto microseconds = [](const auto & duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  };
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  auto separator = "\n";
+  for (const auto & buffer : buffers) {
+    buffer->forEach([&](const Zone & zone) {
+      os << separator << "{\"name\":\"";
+      for (auto c = zone.name; *c; ++c) {
+        if (*c == '"' or *c == '\\') {
+          os << '\\';
+        }
+        os << *c;
+      }
+      os << "\",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":" << std::fixed << std::setprecision(3)
+         << microseconds(zone.begin.time_since_epoch()) << ",\"dur\":"
+         << microseconds(zone.end - zone.begin) << ",\"pid\":" << ::getpid() << ",\"tid\":"
+         << buffer->thread_id << "}";
+      separator = ",\n";
+    });
+  }
+  os << "\n]}\n";
+}
+
+/// @note "%p" in FRAME_PROFILER_OUTPUT is replaced with the process ID so that processes sharing
+/// the environment do not overwrite each other's trace
+auto outputPath() -> std::string
+{
+  if (const auto output = std::getenv("FRAME_PROFILER_OUTPUT")) {
+    auto path = std::string(output);
+    if (const auto position = path.find("%p"); position != std::string::npos) {
+      path.replace(position, 2, std::to_string(::getpid()));
+    }
+    return path;
+  } else {
+    return "";
+  }
+}
+
+class Registry
+{
+public:
+  Registry()
+  : output_path(outputPath()), enabled(not output_path.empty())
+  {
+  }
+
+  ~Registry()
+  {
+    if (not output_path.empty()) {
+      if (std::ofstream ofs(output_path); ofs) {
+        write(ofs, buffers_);
+      }
+    }
+  }
+
+  auto attach() -> std::shared_ptr<ZoneBuffer>
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffers_.emplace_back(std::make_shared<ZoneBuffer>(buffers_.size()));
+  }
+
+  auto buffers() const -> std::vector<std::shared_ptr<ZoneBuffer>>
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffers_;
+  }
+
+  const std::string output_path;
+
+  std::atomic<bool> enabled;
+
+private:
+  mutable std::mutex mutex_;
+
+  /// @note shared with the threads so that zones outlive the thread that recorded them
+  std::vector<std::shared_ptr<ZoneBuffer>> buffers_;
+};
+
+auto registry() -> Registry &
+{
+  static Registry registry;
+  return registry;
+}
+}  // namespace
+
+auto enabled() noexcept -> bool { return registry().enabled.load(std::memory_order_relaxed); }
+
+auto enable(bool value) noexcept -> void
+{
+  registry().enabled.store(value, std::memory_order_relaxed);
+}
+
+auto record(const char * name, Clock::time_point begin, Clock::time_point end) -> void
+{
+  thread_local const auto buffer = registry().attach();
+  buffer->push({name, begin, end});
+}
+
+auto clear() -> void
+{
+  for (const auto & buffer : registry().buffers()) {
+    buffer->clear();
+  }
+}
+
+auto writeChromeTrace(std::ostream & os) -> void
+{
+  write(os, registry().buffers());
+}
+
+auto writeChromeTrace(const std::string & path) -> void
+{
+  if (std::ofstream ofs(path); ofs) {
+    writeChromeTrace(ofs);
+  }
+}
+}  // namespace frame_profiler
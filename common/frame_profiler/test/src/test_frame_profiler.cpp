@@ -0,0 +1,114 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <frame_profiler/frame_profiler.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+auto count(const std::string & string, const std::string & pattern) -> std::size_t
+{
+  std::size_t n = 0;
+  for (auto i = string.find(pattern); i != std::string::npos; i = string.find(pattern, i + 1)) {
+    ++n;
+  }
+  return n;
+}
+
+auto trace() -> std::string
+{
+  std::stringstream ss;
+  frame_profiler::writeChromeTrace(ss);
+  return ss.str();
+}
+
+TEST(FrameProfiler, NothingRecordedWhileDisabled)
+{
+  frame_profiler::clear();
+  frame_profiler::enable(false);
+  {
+    FRAME_PROFILER_ZONE("disabled");
+  }
+  EXPECT_EQ(count(trace(), "\"ph\":\"X\""), std::size_t(0));
+}
+
+TEST(FrameProfiler, NestedZones)
+{
+  frame_profiler::clear();
+  frame_profiler::enable(true);
+  {
+    FRAME_PROFILER_ZONE("outer");
+    {
+      FRAME_PROFILER_ZONE("inner");
+    }
+  }
+  frame_profiler::enable(false);
+  const auto json = trace();
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_EQ(count(json, "\"name\":\"outer\""), std::size_t(1));
+  EXPECT_EQ(count(json, "\"name\":\"inner\""), std::size_t(1));
+  /// @note a complete event is written when the zone ends, so the inner zone comes first
+  EXPECT_LT(json.find("\"inner\""), json.find("\"outer\""));
+}
+
+TEST(FrameProfiler, ZonesOfFinishedThreadsAreKept)
+{
+  frame_profiler::clear();
+  frame_profiler::enable(true);
+  std::thread([] { FRAME_PROFILER_ZONE("worker"); }).join();
+  {
+    FRAME_PROFILER_ZONE("main");
+  }
+  frame_profiler::enable(false);
+  const auto json = trace();
+  EXPECT_EQ(count(json, "\"name\":\"worker\""), std::size_t(1));
+  EXPECT_EQ(count(json, "\"name\":\"main\""), std::size_t(1));
+}
+
+TEST(FrameProfiler, RingBufferKeepsLatestZones)
+{
+  frame_profiler::clear();
+  frame_profiler::enable(true);
+  for (std::size_t i = 0; i < frame_profiler::zone_capacity; ++i) {
+    FRAME_PROFILER_ZONE("old");
+  }
+  for (std::size_t i = 0; i < 10; ++i) {
+    FRAME_PROFILER_ZONE("new");
+  }
+  frame_profiler::enable(false);
+  const auto json = trace();
+  EXPECT_EQ(count(json, "\"name\":\"old\""), frame_profiler::zone_capacity - 10);
+  EXPECT_EQ(count(json, "\"name\":\"new\""), std::size_t(10));
+}
+
+/// @note timestamps are relative to the steady_clock epoch shared by every process, not to the
+/// start of this one, so that the traces of several processes line up
+TEST(FrameProfiler, TimestampsCountFromClockEpoch)
+{
+  frame_profiler::clear();
+  const auto begin = frame_profiler::Clock::time_point(std::chrono::seconds(1));
+  frame_profiler::record("epoch", begin, begin + std::chrono::milliseconds(2));
+  const auto json = trace();
+  EXPECT_EQ(count(json, "\"ts\":1000000.000,\"dur\":2000.000,"), std::size_t(1));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GEOMETRY__INTERSECTION__ORIENTED_BOXES_HPP_
+#define GEOMETRY__INTERSECTION__ORIENTED_BOXES_HPP_
+
+#include <cstddef>
+#include <geometry_msgs/msg/pose.hpp>
+#include <traffic_simulator_msgs/msg/bounding_box.hpp>
+#include <utility>
+#include <vector>
+
+namespace math
+{
+namespace geometry
+{
+/**
+ * @brief Bounding box placed in the map, for a collision check between two of them.
+ * @note Same footprint and separating axis test as OrientedBoxes, without allocating anything.
+ */
+struct OrientedBox
+{
+  OrientedBox() = default;
+
+  OrientedBox(
+    const geometry_msgs::msg::Pose & pose, const traffic_simulator_msgs::msg::BoundingBox & bbox);
+
+  /// @note Center of the footprint and height of the center of the box.
+  double center_x, center_y, center_z;
+
+  double half_height;
+
+  /// @note Half of the footprint edges along the length and the width of the box.
+  double length_x, length_y, width_x, width_y;
+};
+
+/// @brief Same as checkCollision2D of both boxes.
+auto collides(const OrientedBox & box0, const OrientedBox & box1) -> bool;
+
+/// @brief Whether the footprints of both boxes intersect, regardless of height.
+auto intersects2D(const OrientedBox & box0, const OrientedBox & box1) -> bool;
+
+/**
+ * @brief Bounding boxes placed in the map, for collision checks between many of them at once.
+ * @note Each box is kept as the footprint get2DPolygon returns, the parallelogram its top face
+ *       projects to on the xy plane, plus its vertical extent. Attributes are stored in separate
+ *       arrays so the broad phase only streams the ones it reads.
+ *       Pairs are first culled by sweep and prune of the axis aligned bounds of the footprints
+ *       along x, then tested exactly by the separating axis theorem on the footprint edges.
+ *       Touching footprints collide, the same as boost::geometry::intersects.
+ */
+class OrientedBoxes
+{
+public:
+  OrientedBoxes() = default;
+
+  /// @return Index of the added box.
+  auto add(
+    const geometry_msgs::msg::Pose & pose, const traffic_simulator_msgs::msg::BoundingBox & bbox)
+    -> std::size_t;
+
+  auto clear() noexcept -> void;
+
+  auto reserve(const std::size_t size) -> void;
+
+  auto size() const noexcept -> std::size_t { return center_x_.size(); }
+
+  /// @brief Same as checkCollision2D of the boxes at index0 and index1.
+  auto collides(const std::size_t index0, const std::size_t index1) const -> bool;
+
+  /// @brief Whether the footprints at index0 and index1 intersect, regardless of height.
+  auto intersects2D(const std::size_t index0, const std::size_t index1) const -> bool;
+
+  /// @return Every pair of colliding boxes as (smaller index, larger index), in ascending order.
+  auto getCollidingPairs() const -> std::vector<std::pair<std::size_t, std::size_t>>;
+
+private:
+  auto get(const std::size_t index) const -> OrientedBox;
+
+  /// @note Center of the footprint and height of the center of the box.
+  std::vector<double> center_x_, center_y_, center_z_;
+
+  std::vector<double> half_height_;
+
+  /// @note Half of the footprint edges along the length and the width of the box.
+  std::vector<double> length_x_, length_y_, width_x_, width_y_;
+
+  /// @note Half size of the axis aligned bounds of the footprint.
+  std::vector<double> extent_x_, extent_y_;
+};
+}  // namespace geometry
+}  // namespace math
+
+#endif  // GEOMETRY__INTERSECTION__ORIENTED_BOXES_HPP_
@@ -0,0 +1,103 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GEOMETRY__SPLINE__AABB_TREE_HPP_
+#define GEOMETRY__SPLINE__AABB_TREE_HPP_
+
+#include <cstddef>
+#include <geometry_msgs/msg/point.hpp>
+#include <vector>
+
+namespace math
+{
+namespace geometry
+{
+/// @brief Axis aligned bounding box in 2D (x and y).
+struct AABB
+{
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+
+  static auto of(const std::vector<geometry_msgs::msg::Point> & points) -> AABB;
+
+  auto expand(double margin) const -> AABB;
+
+  auto merge(const AABB & other) const -> AABB;
+
+  auto overlaps(const AABB & other) const -> bool;
+};
+
+/**
+ * @brief Static bounding volume hierarchy over a sequence of boxes, such as the curves of a spline.
+ * @note Every node covers a contiguous range of the sequence and is split at its middle. The
+ *       curves of a spline that are neighbours in the sequence are neighbours in space too, so the
+ *       boxes of the nodes stay tight, and visiting the children in order yields the overlapping
+ *       boxes in the order of the sequence.
+ */
+class AABBTree
+{
+public:
+  AABBTree() = default;
+
+  explicit AABBTree(const std::vector<AABB> & boxes);
+
+  /**
+   * @brief Call visitor with the index of every box overlapping query until visitor returns true.
+   * @note Indices are visited in increasing order, or in decreasing order if backward is true.
+   * @return true if visitor returned true.
+   */
+  template <typename Visitor>
+  auto visitOverlapping(const AABB & query, bool backward, Visitor && visitor) const -> bool
+  {
+    return not nodes_.empty() and visit(0, query, backward, visitor);
+  }
+
+private:
+  struct Node
+  {
+    AABB box;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t left;
+    std::size_t right;
+  };
+
+  auto build(const std::vector<AABB> & boxes, std::size_t begin, std::size_t end) -> std::size_t;
+
+  template <typename Visitor>
+  auto visit(std::size_t node_index, const AABB & query, bool backward, Visitor & visitor) const
+    -> bool
+  {
+    const auto & node = nodes_[node_index];
+    if (not node.box.overlaps(query)) {
+      return false;
+    } else if (node.end - node.begin == 1) {
+      return visitor(node.begin);
+    } else if (backward) {
+      return visit(node.right, query, backward, visitor) or
+             visit(node.left, query, backward, visitor);
+    } else {
+      return visit(node.left, query, backward, visitor) or
+             visit(node.right, query, backward, visitor);
+    }
+  }
+
+  std::vector<Node> nodes_;
+};
+}  // namespace geometry
+}  // namespace math
+
+#endif  // GEOMETRY__SPLINE__AABB_TREE_HPP_
@@ -16,9 +16,12 @@
 
 #include <exception>
 #include <geometry/polygon/line_segment.hpp>
+#include <geometry/spline/aabb_tree.hpp>
 #include <geometry/spline/catmull_rom_spline_interface.hpp>
 #include <geometry/spline/hermite_curve.hpp>
 #include <geometry_msgs/msg/point.hpp>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <utility>
@@ -32,7 +35,14 @@ class CatmullRomSpline : public CatmullRomSplineInterface
 {
 public:
   CatmullRomSpline() = default;
-  explicit CatmullRomSpline(const std::vector<geometry_msgs::msg::Point> & control_points);
+  /**
+   * @note arc_length_parameterization is passed to every HermiteCurve of the spline. It is off for
+   *       the lanelet, route and waypoint splines of traffic_simulator, because it moves the point
+   *       each s maps to, and so the lanelet poses and the motion of NPCs in existing scenarios.
+   */
+  explicit CatmullRomSpline(
+    const std::vector<geometry_msgs::msg::Point> & control_points,
+    bool arc_length_parameterization = false);
   auto getLength() const -> double override { return total_length_; }
   auto getMaximum2DCurvature() const -> double;
   auto getPoint(const double s) const -> geometry_msgs::msg::Point;
@@ -42,7 +52,7 @@ public:
   auto getPose(const double s) const -> geometry_msgs::msg::Pose;
   auto getTrajectory(
     const double start_s, const double end_s, const double resolution,
-    const double offset = 0.0) const -> std::vector<geometry_msgs::msg::Point>;
+    const double offset = 0.0) const -> std::vector<geometry_msgs::msg::Point> override;
   auto getSValue(const geometry_msgs::msg::Pose & pose, double threshold_distance = 3.0) const
     -> std::optional<double>;
   auto getSquaredDistanceIn2D(const geometry_msgs::msg::Point & point, const double s) const
@@ -66,14 +76,24 @@ private:
     const -> std::vector<geometry_msgs::msg::Point>;
   auto getSInSplineCurve(const size_t curve_index, const double s) const -> double;
   auto getCurveIndexAndS(const double s) const -> std::pair<size_t, double>;
+  auto getCurveTree() const -> const AABBTree &;
   auto checkConnection() const -> bool;
   auto equals(const geometry_msgs::msg::Point & p0, const geometry_msgs::msg::Point & p1) const
     -> bool;
   std::vector<LineSegment> line_segments_;
   std::vector<HermiteCurve> curves_;
-  std::vector<double> length_list_;
+  /// @note Length of the spline up to the start of each curve, followed by the total length.
+  std::vector<double> accumulated_lengths_;
   std::vector<double> maximum_2d_curvatures_;
   double total_length_;
+
+  /// @note Built on the first query that needs it and shared by copies, since curves_ never change.
+  struct CurveTree
+  {
+    std::once_flag flag;
+    AABBTree tree;
+  };
+  std::shared_ptr<CurveTree> curve_tree_ = std::make_shared<CurveTree>();
 };
 }  // namespace geometry
 }  // namespace math
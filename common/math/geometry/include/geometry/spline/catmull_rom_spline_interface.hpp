@@ -30,6 +30,9 @@ class CatmullRomSplineInterface
 {
 public:
   virtual double getLength() const = 0;
+  virtual std::vector<geometry_msgs::msg::Point> getTrajectory(
+    const double start_s, const double end_s, const double resolution,
+    const double offset = 0.0) const = 0;
   virtual std::optional<double> getCollisionPointIn2D(
     const std::vector<geometry_msgs::msg::Point> & polygon,
     const bool search_backward = false) const = 0;
@@ -20,6 +20,7 @@
 #include <geometry/spline/catmull_rom_spline_interface.hpp>
 #include <geometry/spline/hermite_curve.hpp>
 #include <geometry_msgs/msg/point.hpp>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -33,7 +34,7 @@ class CatmullRomSubspline : public CatmullRomSplineInterface
 {
 public:
   explicit CatmullRomSubspline(
-    std::shared_ptr<math::geometry::CatmullRomSpline> spline, const double start_s,
+    std::shared_ptr<const math::geometry::CatmullRomSplineInterface> spline, const double start_s,
     const double end_s)
   : spline_(spline), start_s_(start_s), end_s_(end_s)
   {
@@ -41,12 +42,16 @@ public:
 
   double getLength() const override;
 
+  std::vector<geometry_msgs::msg::Point> getTrajectory(
+    const double start_s, const double end_s, const double resolution,
+    const double offset = 0.0) const override;
+
   std::optional<double> getCollisionPointIn2D(
     const std::vector<geometry_msgs::msg::Point> & polygon,
     const bool search_backward = false) const override;
 
 private:
-  std::shared_ptr<math::geometry::CatmullRomSpline> spline_;
+  std::shared_ptr<const math::geometry::CatmullRomSplineInterface> spline_;
   double start_s_;
   double end_s_;
 };
@@ -0,0 +1,87 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GEOMETRY__SPLINE__COMPOSITE_SPLINE_HPP_
+#define GEOMETRY__SPLINE__COMPOSITE_SPLINE_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <geometry/spline/catmull_rom_spline.hpp>
+#include <geometry/spline/catmull_rom_spline_interface.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/vector3.hpp>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace math
+{
+namespace geometry
+{
+/**
+ * @brief Path made of splines placed one after another, such as the center lines of a route.
+ * @note The splines are shared, not copied, and keep their own s coordinate. Appending a spline
+ *       or dropping one at either end does not touch the other splines, so a path that slides
+ *       along a route is updated without recomputing the curves it keeps.
+ *       Outside [0, getLength()], the path is extended along the tangent of its ends.
+ */
+class CompositeSpline : public CatmullRomSplineInterface
+{
+public:
+  CompositeSpline() = default;
+
+  auto getLength() const -> double override;
+
+  auto getPoint(const double s) const -> geometry_msgs::msg::Point;
+
+  auto getPoint(const double s, const double offset) const -> geometry_msgs::msg::Point;
+
+  auto getTrajectory(
+    const double start_s, const double end_s, const double resolution,
+    const double offset = 0.0) const -> std::vector<geometry_msgs::msg::Point> override;
+
+  auto getCollisionPointIn2D(
+    const std::vector<geometry_msgs::msg::Point> & polygon,
+    const bool search_backward = false) const -> std::optional<double> override;
+
+  auto size() const noexcept -> std::size_t { return pieces_.size(); }
+
+  auto pushBack(const std::shared_ptr<const CatmullRomSpline> & spline) -> void;
+
+  auto popBack() -> void;
+
+  auto popFront() -> void;
+
+private:
+  struct Piece
+  {
+    std::shared_ptr<const CatmullRomSpline> spline;
+
+    /// @note Relative to origin_, which is moved instead of every start_s when popping the front.
+    double start_s;
+  };
+
+  /// @brief Point and unit tangent vector at s.
+  auto getPointAndTangent(const double s) const
+    -> std::pair<geometry_msgs::msg::Point, geometry_msgs::msg::Vector3>;
+
+  std::deque<Piece> pieces_;
+
+  double origin_ = 0.0;
+};
+}  // namespace geometry
+}  // namespace math
+
+#endif  // GEOMETRY__SPLINE__COMPOSITE_SPLINE_HPP_
@@ -19,6 +19,7 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <geometry/solver/polynomial_solver.hpp>
+#include <geometry/spline/aabb_tree.hpp>
 #include <geometry_msgs/msg/point.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
@@ -39,12 +40,18 @@ private:
   math::geometry::PolynomialSolver solver_;
 
 public:
+  /**
+   * @note If arc_length_parameterization is true, the curve keeps a table of arc lengths and maps
+   *       denormalized s to the curve parameter through it, so that denormalized s is the distance
+   *       along the curve. Otherwise denormalized s is simply divided by the length of the curve.
+   */
   HermiteCurve(
     geometry_msgs::msg::Pose start_pose, geometry_msgs::msg::Pose goal_pose,
-    geometry_msgs::msg::Vector3 start_vec, geometry_msgs::msg::Vector3 goal_vec);
+    geometry_msgs::msg::Vector3 start_vec, geometry_msgs::msg::Vector3 goal_vec,
+    bool arc_length_parameterization = false);
   HermiteCurve(
     double ax, double bx, double cx, double dx, double ay, double by, double cy, double dy,
-    double az, double bz, double cz, double dz);
+    double az, double bz, double cz, double dz, bool arc_length_parameterization = false);
   std::vector<geometry_msgs::msg::Point> getTrajectory(size_t num_points = 30) const;
   const std::vector<geometry_msgs::msg::Point> getTrajectory(
     double start_s, double end_s, double resolution, bool denormalize_s = false) const;
@@ -56,6 +63,7 @@ public:
   double getMaximum2DCurvature() const;
   double getLength(size_t num_points) const;
   double getLength() const { return length_; }
+  AABB get2DBoundingBox() const;
   std::optional<double> getSValue(
     const geometry_msgs::msg::Pose & pose, double threshold_distance = 3.0,
     bool denormalize_s = false) const;
@@ -72,7 +80,16 @@ public:
 
 private:
   std::pair<double, double> get2DMinMaxCurvatureValue() const;
+  double getStepLength(double s, double delta_s) const;
+  std::vector<double> getArcLengthTable() const;
+  double normalize(double s) const;
+  double denormalize(double t) const;
   double length_;
+  /**
+   * @brief Arc lengths at evenly spaced values of the curve parameter, from 0 to length_.
+   * @note Empty if the curve is not arc length parameterized.
+   */
+  std::vector<double> arc_lengths_;
 };
 }  // namespace geometry
 }  // namespace math
@@ -15,6 +15,7 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <geometry/bounding_box.hpp>
+#include <geometry/intersection/oriented_boxes.hpp>
 
 // headers in Eigen
 #define EIGEN_MPL2_ONLY
@@ -40,18 +41,11 @@ std::optional<double> getPolygonDistance(
   const geometry_msgs::msg::Pose & pose0, const traffic_simulator_msgs::msg::BoundingBox & bbox0,
   const geometry_msgs::msg::Pose & pose1, const traffic_simulator_msgs::msg::BoundingBox & bbox1)
 {
-  const auto poly0 = get2DPolygon(pose0, bbox0);
-  const auto poly1 = get2DPolygon(pose1, bbox1);
-  if (boost::geometry::intersects(poly0, poly1)) {
-    return std::nullopt;
-  }
-  if (boost::geometry::intersects(poly1, poly0)) {
+  /// @note Separating axis test instead of boost::geometry::intersects on both polygons.
+  if (intersects2D(OrientedBox(pose0, bbox0), OrientedBox(pose1, bbox1))) {
     return std::nullopt;
   }
-  if (boost::geometry::disjoint(poly0, poly1)) {
-    return boost::geometry::distance(poly0, poly1);
-  }
-  return std::nullopt;
+  return boost::geometry::distance(get2DPolygon(pose0, bbox0), get2DPolygon(pose1, bbox1));
 }
 
 // inspiration taken from
@@ -60,40 +54,34 @@ std::optional<std::pair<geometry_msgs::msg::Pose, geometry_msgs::msg::Pose>> get
   const geometry_msgs::msg::Pose & pose0, const traffic_simulator_msgs::msg::BoundingBox & bbox0,
   const geometry_msgs::msg::Pose & pose1, const traffic_simulator_msgs::msg::BoundingBox & bbox1)
 {
-  const auto poly0 = get2DPolygon(pose0, bbox0);
-  const auto poly1 = get2DPolygon(pose1, bbox1);
-
-  if (boost::geometry::intersects(poly0, poly1)) {
+  if (intersects2D(OrientedBox(pose0, bbox0), OrientedBox(pose1, bbox1))) {
     return std::nullopt;
   }
-  if (boost::geometry::intersects(poly1, poly0)) {
-    return std::nullopt;
-  }
-  if (boost::geometry::disjoint(poly0, poly1)) {
-    auto point0 = boost_point();
-    auto point1 = boost_point();
-    auto min_distance = boost::numeric::bounds<double>::highest();
-
-    auto segments = boost::make_iterator_range(
-      boost::geometry::segments_begin(poly0), boost::geometry::segments_end(poly0));
-    auto points = boost::make_iterator_range(
-      boost::geometry::points_begin(poly1), boost::geometry::points_end(poly1));
-    for (auto && segment : segments) {
-      for (auto && point : points) {
-        auto nearest_point_from_segment =
-          pointToSegmentProjection(point, *segment.first, *segment.second);
-        auto distance = boost::geometry::distance(point, nearest_point_from_segment);
-        if (distance < min_distance) {
-          min_distance = distance;
-          point0 = point;
-          point1 = nearest_point_from_segment;
-        }
+
+  const auto poly0 = get2DPolygon(pose0, bbox0);
+  const auto poly1 = get2DPolygon(pose1, bbox1);
+  auto point0 = boost_point();
+  auto point1 = boost_point();
+  auto min_distance = boost::numeric::bounds<double>::highest();
+
+  auto segments = boost::make_iterator_range(
+    boost::geometry::segments_begin(poly0), boost::geometry::segments_end(poly0));
+  auto points = boost::make_iterator_range(
+    boost::geometry::points_begin(poly1), boost::geometry::points_end(poly1));
+  for (auto && segment : segments) {
+    for (auto && point : points) {
+      auto nearest_point_from_segment =
+        pointToSegmentProjection(point, *segment.first, *segment.second);
+      auto distance = boost::geometry::distance(point, nearest_point_from_segment);
+      if (distance < min_distance) {
+        min_distance = distance;
+        point0 = point;
+        point1 = nearest_point_from_segment;
       }
     }
-
-    return std::make_pair(toPose(point0), toPose(point1));
   }
-  return std::nullopt;
+
+  return std::make_pair(toPose(point0), toPose(point1));
 }
 
 boost_point pointToSegmentProjection(
@@ -22,6 +22,7 @@
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <geometry/bounding_box.hpp>
 #include <geometry/intersection/collision.hpp>
+#include <geometry/intersection/oriented_boxes.hpp>
 #include <vector>
 
 namespace math
@@ -37,17 +38,8 @@ bool checkCollision2D(
   if (z_diff_pose > (std::abs(bbox0.dimensions.z + bbox1.dimensions.z) * 0.5)) {
     return false;
   }
-  namespace bg = boost::geometry;
-  typedef bg::model::d2::point_xy<double> bg_point;
-  const bg::model::polygon<bg_point> poly0 = math::geometry::get2DPolygon(pose0, bbox0);
-  const bg::model::polygon<bg_point> poly1 = math::geometry::get2DPolygon(pose1, bbox1);
-  if (bg::intersects(poly0, poly1)) {
-    return true;
-  }
-  if (bg::disjoint(poly0, poly1)) {
-    return false;
-  }
-  return true;
+  /// @note Separating axis test on the same footprints as get2DPolygon.
+  return intersects2D(OrientedBox(pose0, bbox0), OrientedBox(pose1, bbox1));
 }
 
 bool contains(
@@ -0,0 +1,159 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <quaternion_operation/quaternion_operation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <geometry/intersection/oriented_boxes.hpp>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace math
+{
+namespace geometry
+{
+OrientedBox::OrientedBox(
+  const geometry_msgs::msg::Pose & pose, const traffic_simulator_msgs::msg::BoundingBox & bbox)
+{
+  /// @note Same transform as transformPoints(pose, getPointsFromBbox(bbox)) in get2DPolygon.
+  const auto rotation = quaternion_operation::getRotationMatrix(pose.orientation);
+  const auto up = bbox.center.z + bbox.dimensions.z * 0.5;
+  center_x = rotation(0, 0) * bbox.center.x + rotation(0, 1) * bbox.center.y +
+             rotation(0, 2) * up + pose.position.x;
+  center_y = rotation(1, 0) * bbox.center.x + rotation(1, 1) * bbox.center.y +
+             rotation(1, 2) * up + pose.position.y;
+  center_z = pose.position.z + bbox.center.z;
+  half_height = bbox.dimensions.z * 0.5;
+  length_x = rotation(0, 0) * bbox.dimensions.x * 0.5;
+  length_y = rotation(1, 0) * bbox.dimensions.x * 0.5;
+  width_x = rotation(0, 1) * bbox.dimensions.y * 0.5;
+  width_y = rotation(1, 1) * bbox.dimensions.y * 0.5;
+}
+
+auto collides(const OrientedBox & box0, const OrientedBox & box1) -> bool
+{
+  return std::abs(box0.center_z - box1.center_z) <=
+           std::abs(box0.half_height + box1.half_height) and
+         intersects2D(box0, box1);
+}
+
+auto intersects2D(const OrientedBox & box0, const OrientedBox & box1) -> bool
+{
+  const auto distance_x = box1.center_x - box0.center_x;
+  const auto distance_y = box1.center_y - box0.center_y;
+  /// @note Footprints are separated if their projections onto the normal of an edge are.
+  const auto separated_along = [&](const auto normal_x, const auto normal_y) {
+    const auto radius = [&](const auto & box) {
+      return std::abs(box.length_x * normal_x + box.length_y * normal_y) +
+             std::abs(box.width_x * normal_x + box.width_y * normal_y);
+    };
+    return std::abs(distance_x * normal_x + distance_y * normal_y) > radius(box0) + radius(box1);
+  };
+  return not(
+    separated_along(-box0.length_y, box0.length_x) or
+    separated_along(-box0.width_y, box0.width_x) or
+    separated_along(-box1.length_y, box1.length_x) or separated_along(-box1.width_y, box1.width_x));
+}
+
+auto OrientedBoxes::add(
+  const geometry_msgs::msg::Pose & pose, const traffic_simulator_msgs::msg::BoundingBox & bbox)
+  -> std::size_t
+{
+  const auto box = OrientedBox(pose, bbox);
+  center_x_.push_back(box.center_x);
+  center_y_.push_back(box.center_y);
+  center_z_.push_back(box.center_z);
+  half_height_.push_back(box.half_height);
+  length_x_.push_back(box.length_x);
+  length_y_.push_back(box.length_y);
+  width_x_.push_back(box.width_x);
+  width_y_.push_back(box.width_y);
+  extent_x_.push_back(std::abs(box.length_x) + std::abs(box.width_x));
+  extent_y_.push_back(std::abs(box.length_y) + std::abs(box.width_y));
+  return size() - 1;
+}
+
+auto OrientedBoxes::clear() noexcept -> void
+{
+  for (auto attribute : {&center_x_, &center_y_, &center_z_, &half_height_, &length_x_,
+                         &length_y_, &width_x_, &width_y_, &extent_x_, &extent_y_}) {
+    attribute->clear();
+  }
+}
+
+auto OrientedBoxes::reserve(const std::size_t size) -> void
+{
+  for (auto attribute : {&center_x_, &center_y_, &center_z_, &half_height_, &length_x_,
+                         &length_y_, &width_x_, &width_y_, &extent_x_, &extent_y_}) {
+    attribute->reserve(size);
+  }
+}
+
+auto OrientedBoxes::collides(const std::size_t index0, const std::size_t index1) const -> bool
+{
+  return geometry::collides(get(index0), get(index1));
+}
+
+auto OrientedBoxes::intersects2D(const std::size_t index0, const std::size_t index1) const -> bool
+{
+  return geometry::intersects2D(get(index0), get(index1));
+}
+
+auto OrientedBoxes::getCollidingPairs() const -> std::vector<std::pair<std::size_t, std::size_t>>
+{
+  std::vector<std::size_t> indices(size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::sort(indices.begin(), indices.end(), [this](const auto lhs, const auto rhs) {
+    return center_x_[lhs] - extent_x_[lhs] < center_x_[rhs] - extent_x_[rhs];
+  });
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  /// @note Boxes whose bounds along x contain the lower bound of the box being swept.
+  std::vector<std::size_t> active;
+  for (const auto index : indices) {
+    const auto min_x = center_x_[index] - extent_x_[index];
+    active.erase(
+      std::remove_if(
+        active.begin(), active.end(),
+        [&](const auto other) { return center_x_[other] + extent_x_[other] < min_x; }),
+      active.end());
+    for (const auto other : active) {
+      if (
+        std::abs(center_y_[index] - center_y_[other]) <= extent_y_[index] + extent_y_[other] and
+        collides(other, index)) {
+        pairs.emplace_back(std::min(index, other), std::max(index, other));
+      }
+    }
+    active.push_back(index);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+auto OrientedBoxes::get(const std::size_t index) const -> OrientedBox
+{
+  OrientedBox box;
+  box.center_x = center_x_[index];
+  box.center_y = center_y_[index];
+  box.center_z = center_z_[index];
+  box.half_height = half_height_[index];
+  box.length_x = length_x_[index];
+  box.length_y = length_y_[index];
+  box.width_x = width_x_[index];
+  box.width_y = width_y_[index];
+  return box;
+}
+}  // namespace geometry
+}  // namespace math
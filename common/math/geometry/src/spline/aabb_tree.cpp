@@ -0,0 +1,81 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <geometry/spline/aabb_tree.hpp>
+#include <limits>
+#include <vector>
+
+namespace math
+{
+namespace geometry
+{
+auto AABB::of(const std::vector<geometry_msgs::msg::Point> & points) -> AABB
+{
+  AABB box{
+    std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+  for (const auto & point : points) {
+    box.min_x = std::min(box.min_x, point.x);
+    box.min_y = std::min(box.min_y, point.y);
+    box.max_x = std::max(box.max_x, point.x);
+    box.max_y = std::max(box.max_y, point.y);
+  }
+  return box;
+}
+
+auto AABB::expand(double margin) const -> AABB
+{
+  return {min_x - margin, min_y - margin, max_x + margin, max_y + margin};
+}
+
+auto AABB::merge(const AABB & other) const -> AABB
+{
+  return {
+    std::min(min_x, other.min_x), std::min(min_y, other.min_y), std::max(max_x, other.max_x),
+    std::max(max_y, other.max_y)};
+}
+
+auto AABB::overlaps(const AABB & other) const -> bool
+{
+  return min_x <= other.max_x and other.min_x <= max_x and min_y <= other.max_y and
+         other.min_y <= max_y;
+}
+
+AABBTree::AABBTree(const std::vector<AABB> & boxes)
+{
+  if (not boxes.empty()) {
+    nodes_.reserve(2 * boxes.size() - 1);
+    build(boxes, 0, boxes.size());
+  }
+}
+
+auto AABBTree::build(const std::vector<AABB> & boxes, std::size_t begin, std::size_t end)
+  -> std::size_t
+{
+  const auto node_index = nodes_.size();
+  nodes_.push_back({boxes[begin], begin, end, 0, 0});
+  if (end - begin > 1) {
+    const auto middle = begin + (end - begin) / 2;
+    const auto left = build(boxes, begin, middle);
+    const auto right = build(boxes, middle, end);
+    /// @note nodes_ may not be referenced across the recursive calls, they can reallocate it.
+    nodes_[node_index].left = left;
+    nodes_[node_index].right = right;
+    nodes_[node_index].box = nodes_[left].box.merge(nodes_[right].box);
+  }
+  return node_index;
+}
+}  // namespace geometry
+}  // namespace math
@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <geometry/linear_algebra.hpp>
 #include <geometry/spline/catmull_rom_spline.hpp>
+#include <geometry/transform.hpp>
 #include <iostream>
 #include <limits>
 #include <optional>
@@ -27,6 +29,9 @@ namespace math
 {
 namespace geometry
 {
+/// @note Tolerance of the bounding boxes of queries for rounding errors of the collision checks.
+constexpr double bounding_box_margin = 1e-6;
+
 auto CatmullRomSpline::getPolygon(
   const double width, const size_t num_points, const double z_offset)
   -> std::vector<geometry_msgs::msg::Point>
@@ -122,7 +127,8 @@ auto CatmullRomSpline::getTrajectory(
   }
 }
 
-CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point> & control_points)
+CatmullRomSpline::CatmullRomSpline(
+  const std::vector<geometry_msgs::msg::Point> & control_points, bool arc_length_parameterization)
 : control_points(control_points), line_segments_(getLineSegments(control_points)), total_length_(0)
 {
   switch (control_points.size()) {
@@ -141,7 +147,7 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
       break;
     /// @note In this case, spline is interpreted as curve.
     default:
-      [this](const auto & control_points) -> void {
+      [this, arc_length_parameterization](const auto & control_points) -> void {
         size_t n = control_points.size() - 1;
         for (size_t i = 0; i < n; i++) {
           if (i == 0) {
@@ -169,7 +175,8 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
             bz = bz * 0.5;
             cz = cz * 0.5;
             dz = dz * 0.5;
-            curves_.emplace_back(HermiteCurve(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz));
+            curves_.emplace_back(HermiteCurve(
+              ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz, arc_length_parameterization));
           } else if (i == (n - 1)) {
             double ax = 0;
             double bx = control_points[i - 1].x - 2 * control_points[i].x + control_points[i + 1].x;
@@ -195,7 +202,8 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
             bz = bz * 0.5;
             cz = cz * 0.5;
             dz = dz * 0.5;
-            curves_.emplace_back(HermiteCurve(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz));
+            curves_.emplace_back(HermiteCurve(
+              ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz, arc_length_parameterization));
           } else {
             double ax = -1 * control_points[i - 1].x + 3 * control_points[i].x -
                         3 * control_points[i + 1].x + control_points[i + 2].x;
@@ -227,17 +235,17 @@ CatmullRomSpline::CatmullRomSpline(const std::vector<geometry_msgs::msg::Point>
             bz = bz * 0.5;
             cz = cz * 0.5;
             dz = dz * 0.5;
-            curves_.emplace_back(HermiteCurve(ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz));
+            curves_.emplace_back(HermiteCurve(
+              ax, bx, cx, dx, ay, by, cy, dy, az, bz, cz, dz, arc_length_parameterization));
           }
         }
+        accumulated_lengths_.reserve(curves_.size() + 1);
+        accumulated_lengths_.emplace_back(0);
         for (const auto & curve : curves_) {
-          length_list_.emplace_back(curve.getLength());
+          accumulated_lengths_.emplace_back(accumulated_lengths_.back() + curve.getLength());
           maximum_2d_curvatures_.emplace_back(curve.getMaximum2DCurvature());
         }
-        total_length_ = 0;
-        for (const auto & length : length_list_) {
-          total_length_ = total_length_ + length;
-        }
+        total_length_ = accumulated_lengths_.back();
         checkConnection();
       }(control_points);
       break;
@@ -250,30 +258,34 @@ auto CatmullRomSpline::getCurveIndexAndS(const double s) const -> std::pair<size
     return std::make_pair(0, s);
   }
   if (s >= total_length_) {
-    return std::make_pair(
-      curves_.size() - 1, s - (total_length_ - curves_[curves_.size() - 1].getLength()));
+    return std::make_pair(curves_.size() - 1, s - accumulated_lengths_[curves_.size() - 1]);
   }
-  double current_s = 0;
-  for (size_t i = 0; i < curves_.size(); i++) {
-    double prev_s = current_s;
-    current_s = current_s + length_list_[i];
-    if (prev_s <= s && s < current_s) {
-      return std::make_pair(i, s - prev_s);
-    }
+  /// @note The last curve whose start is not beyond s, skipping curves of zero length.
+  const auto iter = std::upper_bound(accumulated_lengths_.begin(), accumulated_lengths_.end(), s);
+  if (iter == accumulated_lengths_.begin() || iter == accumulated_lengths_.end()) {
+    THROW_SIMULATION_ERROR("failed to calculate curve index");  // LCOV_EXCL_LINE
   }
-  THROW_SIMULATION_ERROR("failed to calculate curve index");  // LCOV_EXCL_LINE
+  const auto index = static_cast<size_t>(iter - accumulated_lengths_.begin() - 1);
+  return std::make_pair(index, s - accumulated_lengths_[index]);
 }
 
-auto CatmullRomSpline::getSInSplineCurve(const size_t curve_index, const double s) const -> double
+auto CatmullRomSpline::getCurveTree() const -> const AABBTree &
 {
-  size_t n = curves_.size();
-  double ret = 0;
-  for (size_t i = 0; i < n; i++) {
-    if (i == curve_index) {
-      return ret + s;
-    } else {
-      ret = ret + curves_[i].getLength();
+  std::call_once(curve_tree_->flag, [this]() {
+    std::vector<AABB> boxes;
+    boxes.reserve(curves_.size());
+    for (const auto & curve : curves_) {
+      boxes.push_back(curve.get2DBoundingBox());
     }
+    curve_tree_->tree = AABBTree(boxes);
+  });
+  return curve_tree_->tree;
+}
+
+auto CatmullRomSpline::getSInSplineCurve(const size_t curve_index, const double s) const -> double
+{
+  if (curve_index < curves_.size()) {
+    return accumulated_lengths_[curve_index] + s;
   }
   THROW_SEMANTIC_ERROR("curve index does not match");  // LCOV_EXCL_LINE
 }
@@ -298,25 +310,16 @@ auto CatmullRomSpline::getCollisionPointIn2D(
   /// @note If the spline has three or more control points.
   const auto get_collision_point_2d_with_curve =
     [this](const auto & polygon, const auto search_backward) -> std::optional<double> {
-    size_t n = curves_.size();
-    if (search_backward) {
-      for (size_t i = 0; i < n; i++) {
-        auto s = curves_[n - 1 - i].getCollisionPointIn2D(polygon, search_backward);
-        if (s) {
-          return getSInSplineCurve(n - 1 - i, s.value());
-        }
-      }
-      return std::optional<double>();
-    } else {
-      for (size_t i = 0; i < n; i++) {
-        auto s = curves_[i].getCollisionPointIn2D(polygon, search_backward);
-        if (s) {
-          return std::optional<double>(getSInSplineCurve(i, s.value()));
+    /// @note Only curves whose bounding box overlaps the one of the polygon can collide with it.
+    std::optional<double> collision_s;
+    getCurveTree().visitOverlapping(
+      AABB::of(polygon).expand(bounding_box_margin), search_backward, [&](const auto i) {
+        if (const auto s = curves_[i].getCollisionPointIn2D(polygon, search_backward)) {
+          collision_s = getSInSplineCurve(i, s.value());
         }
-      }
-      return std::optional<double>();
-    }
-    return std::optional<double>();
+        return collision_s.has_value();
+      });
+    return collision_s;
   };
   /// @note If the spline has two control points. (Same as single line segment.)
   const auto get_collision_point_2d_with_line =
@@ -377,25 +380,15 @@ auto CatmullRomSpline::getCollisionPointIn2D(
   const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1,
   const bool search_backward) const -> std::optional<double>
 {
-  size_t n = curves_.size();
-  if (search_backward) {
-    for (size_t i = 0; i < n; i++) {
-      auto s = curves_[n - 1 - i].getCollisionPointIn2D(point0, point1, search_backward);
-      if (s) {
-        return getSInSplineCurve(n - 1 - i, s.value());
-      }
-    }
-    return std::nullopt;
-  } else {
-    for (size_t i = 0; i < n; i++) {
-      auto s = curves_[i].getCollisionPointIn2D(point0, point1, search_backward);
-      if (s) {
-        return getSInSplineCurve(i, s.value());
+  std::optional<double> collision_s;
+  getCurveTree().visitOverlapping(
+    AABB::of({point0, point1}).expand(bounding_box_margin), search_backward, [&](const auto i) {
+      if (const auto s = curves_[i].getCollisionPointIn2D(point0, point1, search_backward)) {
+        collision_s = getSInSplineCurve(i, s.value());
       }
-    }
-    return std::nullopt;
-  }
-  return std::nullopt;
+      return collision_s.has_value();
+    });
+  return collision_s;
 }
 
 auto CatmullRomSpline::getSValue(
@@ -428,16 +421,20 @@ auto CatmullRomSpline::getSValue(
       }
       return line_segments_[0].getSValue(pose, threshold_distance, true);
     default:
-      double s = 0;
-      for (size_t i = 0; i < curves_.size(); i++) {
-        auto s_value = curves_[i].getSValue(pose, threshold_distance, true);
-        if (s_value) {
-          s = s + s_value.value();
-          return s;
-        }
-        s = s + curves_[i].getLength();
-      }
-      return std::nullopt;
+      /// @note Same line as HermiteCurve::getSValue, only curves near it are tried.
+      geometry_msgs::msg::Point p0, p1;
+      p0.y = threshold_distance;
+      p1.y = -threshold_distance;
+      std::optional<double> s;
+      getCurveTree().visitOverlapping(
+        AABB::of(math::geometry::transformPoints(pose, {p0, p1})).expand(bounding_box_margin),
+        false, [&](const auto i) {
+          if (const auto s_value = curves_[i].getSValue(pose, threshold_distance, true)) {
+            s = accumulated_lengths_[i] + s_value.value();
+          }
+          return s.has_value();
+        });
+      return s;
   }
 }
 
@@ -22,6 +22,12 @@ namespace geometry
 {
 double CatmullRomSubspline::getLength() const { return end_s_ - start_s_; }
 
+std::vector<geometry_msgs::msg::Point> CatmullRomSubspline::getTrajectory(
+  const double start_s, const double end_s, const double resolution, const double offset) const
+{
+  return spline_->getTrajectory(start_s_ + start_s, start_s_ + end_s, resolution, offset);
+}
+
 std::optional<double> CatmullRomSubspline::getCollisionPointIn2D(
   const std::vector<geometry_msgs::msg::Point> & polygon, const bool search_backward) const
 {
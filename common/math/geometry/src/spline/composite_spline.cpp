@@ -0,0 +1,144 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <geometry/spline/composite_spline.hpp>
+#include <optional>
+#include <scenario_simulator_exception/exception.hpp>
+#include <utility>
+#include <vector>
+
+namespace math
+{
+namespace geometry
+{
+auto CompositeSpline::getLength() const -> double
+{
+  if (pieces_.empty()) {
+    return 0.0;
+  } else {
+    return pieces_.back().start_s + pieces_.back().spline->getLength() - origin_;
+  }
+}
+
+auto CompositeSpline::pushBack(const std::shared_ptr<const CatmullRomSpline> & spline) -> void
+{
+  pieces_.push_back({spline, origin_ + getLength()});
+}
+
+auto CompositeSpline::popBack() -> void
+{
+  pieces_.pop_back();
+  if (pieces_.empty()) {
+    origin_ = 0.0;
+  }
+}
+
+auto CompositeSpline::popFront() -> void
+{
+  pieces_.pop_front();
+  origin_ = pieces_.empty() ? 0.0 : pieces_.front().start_s;
+}
+
+auto CompositeSpline::getPointAndTangent(const double s) const
+  -> std::pair<geometry_msgs::msg::Point, geometry_msgs::msg::Vector3>
+{
+  if (pieces_.empty()) {
+    THROW_SIMULATION_ERROR("Composite spline is empty, so the point cannot be calculated.");
+  }
+  /// @note The last piece starting at or before s, or the first piece if s is before the path.
+  const auto iter = std::upper_bound(
+    pieces_.begin(), pieces_.end(), origin_ + s,
+    [](const auto value, const auto & piece) { return value < piece.start_s; });
+  const auto & piece = iter == pieces_.begin() ? pieces_.front() : *std::prev(iter);
+  const auto local_s = origin_ + s - piece.start_s;
+  const auto clamped_s = std::clamp(local_s, 0.0, piece.spline->getLength());
+  auto point = piece.spline->getPoint(clamped_s);
+  auto tangent = piece.spline->getTangentVector(clamped_s);
+  if (const auto norm = std::hypot(tangent.x, tangent.y, tangent.z); norm > 0) {
+    tangent.x /= norm;
+    tangent.y /= norm;
+    tangent.z /= norm;
+  }
+  point.x += tangent.x * (local_s - clamped_s);
+  point.y += tangent.y * (local_s - clamped_s);
+  point.z += tangent.z * (local_s - clamped_s);
+  return {point, tangent};
+}
+
+auto CompositeSpline::getPoint(const double s) const -> geometry_msgs::msg::Point
+{
+  return getPointAndTangent(s).first;
+}
+
+auto CompositeSpline::getPoint(const double s, const double offset) const
+  -> geometry_msgs::msg::Point
+{
+  const auto [point, tangent] = getPointAndTangent(s);
+  /// @note Same as CatmullRomSpline::getPoint, the normal vector is the tangent rotated in 2D.
+  const auto theta = std::atan2(tangent.x, -tangent.y);
+  geometry_msgs::msg::Point ret;
+  ret.x = point.x + offset * std::cos(theta);
+  ret.y = point.y + offset * std::sin(theta);
+  ret.z = point.z;
+  return ret;
+}
+
+auto CompositeSpline::getTrajectory(
+  const double start_s, const double end_s, const double resolution, const double offset) const
+  -> std::vector<geometry_msgs::msg::Point>
+{
+  std::vector<geometry_msgs::msg::Point> ret;
+  if (start_s > end_s) {
+    for (double s = start_s; s > end_s; s = s - std::fabs(resolution)) {
+      ret.emplace_back(getPoint(s, offset));
+    }
+  } else {
+    for (double s = start_s; s < end_s; s = s + std::fabs(resolution)) {
+      ret.emplace_back(getPoint(s, offset));
+    }
+  }
+  ret.emplace_back(getPoint(end_s, offset));
+  return ret;
+}
+
+auto CompositeSpline::getCollisionPointIn2D(
+  const std::vector<geometry_msgs::msg::Point> & polygon, const bool search_backward) const
+  -> std::optional<double>
+{
+  const auto get_collision_point = [&](const auto & piece) -> std::optional<double> {
+    if (const auto s = piece.spline->getCollisionPointIn2D(polygon, search_backward)) {
+      return piece.start_s - origin_ + s.value();
+    } else {
+      return std::nullopt;
+    }
+  };
+  if (search_backward) {
+    for (auto iter = pieces_.rbegin(); iter != pieces_.rend(); ++iter) {
+      if (const auto s = get_collision_point(*iter)) {
+        return s;
+      }
+    }
+  } else {
+    for (const auto & piece : pieces_) {
+      if (const auto s = get_collision_point(piece)) {
+        return s;
+      }
+    }
+  }
+  return std::nullopt;
+}
+}  // namespace geometry
+}  // namespace math
@@ -29,7 +29,7 @@ namespace geometry
 {
 HermiteCurve::HermiteCurve(
   double ax, double bx, double cx, double dx, double ay, double by, double cy, double dy, double az,
-  double bz, double cz, double dz)
+  double bz, double cz, double dz, bool arc_length_parameterization)
 : ax_(ax),
   bx_(bx),
   cx_(cx),
@@ -42,13 +42,15 @@ HermiteCurve::HermiteCurve(
   bz_(bz),
   cz_(cz),
   dz_(dz),
-  length_(getLength(100))
+  length_(getLength(100)),
+  arc_lengths_(arc_length_parameterization ? getArcLengthTable() : std::vector<double>())
 {
 }
 
 HermiteCurve::HermiteCurve(
   geometry_msgs::msg::Pose start_pose, geometry_msgs::msg::Pose goal_pose,
-  geometry_msgs::msg::Vector3 start_vec, geometry_msgs::msg::Vector3 goal_vec)
+  geometry_msgs::msg::Vector3 start_vec, geometry_msgs::msg::Vector3 goal_vec,
+  bool arc_length_parameterization)
 {
   ax_ = 2 * start_pose.position.x - 2 * goal_pose.position.x + start_vec.x + goal_vec.x;
   bx_ = -3 * start_pose.position.x + 3 * goal_pose.position.x - 2 * start_vec.x - goal_vec.x;
@@ -65,6 +67,9 @@ HermiteCurve::HermiteCurve(
   cz_ = start_vec.z;
   dz_ = start_pose.position.z;
   length_ = getLength(100);
+  if (arc_length_parameterization) {
+    arc_lengths_ = getArcLengthTable();
+  }
 }
 
 double HermiteCurve::getSquaredDistanceIn2D(
@@ -192,7 +197,7 @@ std::optional<double> HermiteCurve::getSValue(
     return std::nullopt;
   }
   if (denormalize_s) {
-    return s.value() * getLength();
+    return denormalize(s.value());
   }
   return s.value();
 }
@@ -233,7 +238,7 @@ std::vector<geometry_msgs::msg::Point> HermiteCurve::getTrajectory(size_t num_po
 const geometry_msgs::msg::Vector3 HermiteCurve::getNormalVector(double s, bool denormalize_s) const
 {
   if (denormalize_s) {
-    s = s / getLength();
+    s = normalize(s);
   }
   geometry_msgs::msg::Vector3 tangent_vec = getTangentVector(s);
   double theta = M_PI / 2.0;
@@ -246,7 +251,7 @@ const geometry_msgs::msg::Vector3 HermiteCurve::getNormalVector(double s, bool d
 const geometry_msgs::msg::Vector3 HermiteCurve::getTangentVector(double s, bool denormalize_s) const
 {
   if (denormalize_s) {
-    s = s / getLength();
+    s = normalize(s);
   }
   geometry_msgs::msg::Vector3 vec;
   vec.x = 3 * ax_ * s * s + 2 * bx_ * s + cx_;
@@ -258,7 +263,7 @@ const geometry_msgs::msg::Vector3 HermiteCurve::getTangentVector(double s, bool
 const geometry_msgs::msg::Pose HermiteCurve::getPose(double s, bool denormalize_s) const
 {
   if (denormalize_s) {
-    s = s / getLength();
+    s = normalize(s);
   }
   geometry_msgs::msg::Pose pose;
   geometry_msgs::msg::Vector3 tangent_vec = getTangentVector(s, false);
@@ -274,7 +279,7 @@ const geometry_msgs::msg::Pose HermiteCurve::getPose(double s, bool denormalize_
 double HermiteCurve::get2DCurvature(double s, bool denormalize_s) const
 {
   if (denormalize_s) {
-    s = s / getLength();
+    s = normalize(s);
   }
   double s2 = s * s;
   double x_dot = 3 * ax_ * s2 + 2 * bx_ * s + cx_;
@@ -323,19 +328,91 @@ double HermiteCurve::getLength(size_t num_points) const
    * @image html get_length_in_hermite_curve.png
    */
   for (size_t i = 0; i < num_points; i++) {
-    double s = i * delta_s;
-    double x_diff = (3 * s * s) * ax_ + 2 * s * bx_ + cx_;
-    double y_diff = (3 * s * s) * ay_ + 2 * s * by_ + cy_;
-    double z_diff = (3 * s * s) * az_ + 2 * s * bz_ + cz_;
-    ret = ret + std::sqrt(x_diff * x_diff + y_diff * y_diff + z_diff * z_diff) * delta_s;
+    ret = ret + getStepLength(i * delta_s, delta_s);
   }
   return ret;
 }
 
+/// @brief Length of the step of getLength from s to s + delta_s.
+double HermiteCurve::getStepLength(double s, double delta_s) const
+{
+  double x_diff = (3 * s * s) * ax_ + 2 * s * bx_ + cx_;
+  double y_diff = (3 * s * s) * ay_ + 2 * s * by_ + cy_;
+  double z_diff = (3 * s * s) * az_ + 2 * s * bz_ + cz_;
+  return std::sqrt(x_diff * x_diff + y_diff * y_diff + z_diff * z_diff) * delta_s;
+}
+
+/**
+ * @brief Get the 2D bounding box of the curve for s in [0, 1].
+ * @note The curve lies in the convex hull of its Bezier control points, so their bounding box is
+ *       a bounding box of the curve.
+ */
+AABB HermiteCurve::get2DBoundingBox() const
+{
+  std::vector<geometry_msgs::msg::Point> control_points(4);
+  control_points[0].x = dx_;
+  control_points[0].y = dy_;
+  control_points[1].x = dx_ + cx_ / 3;
+  control_points[1].y = dy_ + cy_ / 3;
+  control_points[2].x = dx_ + 2 * cx_ / 3 + bx_ / 3;
+  control_points[2].y = dy_ + 2 * cy_ / 3 + by_ / 3;
+  control_points[3].x = ax_ + bx_ + cx_ + dx_;
+  control_points[3].y = ay_ + by_ + cy_ + dy_;
+  return AABB::of(control_points);
+}
+
+/**
+ * @brief Partial sums of getLength(100), every 100 / 20 steps, so the last one equals length_.
+ * @return 21 arc lengths at curve parameters 0, 0.05, ..., 1.
+ */
+std::vector<double> HermiteCurve::getArcLengthTable() const
+{
+  constexpr size_t num_points = 100;
+  constexpr size_t num_intervals = 20;
+  double delta_s = 1.0 / num_points;
+  double length = 0.0;
+  std::vector<double> ret;
+  ret.reserve(num_intervals + 1);
+  ret.push_back(length);
+  for (size_t i = 0; i < num_points; i++) {
+    length = length + getStepLength(i * delta_s, delta_s);
+    if ((i + 1) % (num_points / num_intervals) == 0) {
+      ret.push_back(length);
+    }
+  }
+  return ret;
+}
+
+/**
+ * @brief Map denormalized s to the curve parameter.
+ * @note Outside [0, length] the curve is extrapolated linearly in s, as without the table.
+ */
+double HermiteCurve::normalize(double s) const
+{
+  if (arc_lengths_.empty() || s <= 0 || s >= length_) {
+    return s / getLength();
+  }
+  const auto index = static_cast<size_t>(
+    std::upper_bound(arc_lengths_.begin(), arc_lengths_.end(), s) - arc_lengths_.begin() - 1);
+  const double ratio = (s - arc_lengths_[index]) / (arc_lengths_[index + 1] - arc_lengths_[index]);
+  return (index + ratio) / (arc_lengths_.size() - 1);
+}
+
+/// @brief Map the curve parameter to denormalized s, inverse of normalize.
+double HermiteCurve::denormalize(double t) const
+{
+  if (arc_lengths_.empty() || t <= 0 || t >= 1) {
+    return t * getLength();
+  }
+  const double position = t * (arc_lengths_.size() - 1);
+  const auto index = static_cast<size_t>(position);
+  return arc_lengths_[index] + (position - index) * (arc_lengths_[index + 1] - arc_lengths_[index]);
+}
+
 const geometry_msgs::msg::Point HermiteCurve::getPoint(double s, bool denormalize_s) const
 {
   if (denormalize_s) {
-    s = s / getLength();
+    s = normalize(s);
   }
   geometry_msgs::msg::Point p;
 
@@ -0,0 +1,52 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <geometry/spline/aabb_tree.hpp>
+#include <vector>
+
+TEST(AABBTree, VisitOverlappingInOrder)
+{
+  std::vector<math::geometry::AABB> boxes;
+  for (int i = 0; i < 37; ++i) {
+    boxes.push_back({static_cast<double>(i), 0.0, i + 1.0, 1.0});
+  }
+  const math::geometry::AABBTree tree(boxes);
+  const math::geometry::AABB query{10.5, 0.5, 14.2, 0.6};
+  std::vector<std::size_t> indices;
+  EXPECT_FALSE(tree.visitOverlapping(query, false, [&](const auto i) {
+    indices.push_back(i);
+    return false;
+  }));
+  EXPECT_EQ(indices, (std::vector<std::size_t>{10, 11, 12, 13, 14}));
+  indices.clear();
+  EXPECT_TRUE(tree.visitOverlapping(query, true, [&](const auto i) {
+    indices.push_back(i);
+    return i == 12;
+  }));
+  EXPECT_EQ(indices, (std::vector<std::size_t>{14, 13, 12}));
+}
+
+TEST(AABBTree, Empty)
+{
+  const math::geometry::AABBTree tree;
+  EXPECT_FALSE(tree.visitOverlapping({0.0, 0.0, 1.0, 1.0}, false, [](const auto) { return true; }));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -240,6 +240,24 @@ TEST(CatmullRomSpline, GetPoint)
   EXPECT_DOUBLE_EQ(point.z, 0);
 }
 
+TEST(CatmullRomSpline, GetPointWithArcLengthParameterization)
+{
+  geometry_msgs::msg::Point p0;
+  geometry_msgs::msg::Point p1;
+  p1.x = 1;
+  geometry_msgs::msg::Point p2;
+  p2.x = 3;
+  geometry_msgs::msg::Point p3;
+  p3.x = 4;
+  auto points = {p0, p1, p2, p3};
+  auto spline = math::geometry::CatmullRomSpline(points, true);
+  EXPECT_NEAR(spline.getLength(), 4, 0.05);
+  for (double s = 0.25; s < spline.getLength(); s = s + 0.25) {
+    EXPECT_NEAR(spline.getPoint(s).x, s, 0.05);
+    EXPECT_DOUBLE_EQ(spline.getPoint(s).y, 0);
+  }
+}
+
 TEST(CatmullRomSpline, GetSValue)
 {
   geometry_msgs::msg::Point p0;
@@ -14,8 +14,14 @@
 
 #include <gtest/gtest.h>
 
+#include <quaternion_operation/quaternion_operation.h>
+
+#include <cmath>
 #include <geometry/intersection/collision.hpp>
+#include <geometry/intersection/oriented_boxes.hpp>
 #include <scenario_simulator_exception/exception.hpp>
+#include <utility>
+#include <vector>
 
 TEST(Collision, DifferentHeight)
 {
@@ -52,6 +58,64 @@ TEST(Collision, SameHeightNoCollision)
   EXPECT_FALSE(math::geometry::checkCollision2D(pose0, box, pose1, box));
 }
 
+TEST(Collision, RotatedNoCollision)
+{
+  /// @note The axis aligned bounds of the boxes overlap, but the boxes do not.
+  geometry_msgs::msg::Pose pose0;
+  geometry_msgs::msg::Vector3 rpy;
+  rpy.z = M_PI_4;
+  pose0.orientation = quaternion_operation::convertEulerAngleToQuaternion(rpy);
+  traffic_simulator_msgs::msg::BoundingBox box0;
+  box0.dimensions.x = 4.0;
+  box0.dimensions.y = 1.0;
+  box0.dimensions.z = 1.0;
+  geometry_msgs::msg::Pose pose1;
+  pose1.position.x = 1.5;
+  pose1.position.y = -1.5;
+  traffic_simulator_msgs::msg::BoundingBox box1;
+  box1.dimensions.x = 1.0;
+  box1.dimensions.y = 1.0;
+  box1.dimensions.z = 1.0;
+  EXPECT_FALSE(math::geometry::checkCollision2D(pose0, box0, pose1, box1));
+  pose1.position.x = 1.5;
+  pose1.position.y = 1.5;
+  EXPECT_TRUE(math::geometry::checkCollision2D(pose0, box0, pose1, box1));
+}
+
+TEST(Collision, Touching)
+{
+  geometry_msgs::msg::Pose pose0;
+  geometry_msgs::msg::Pose pose1;
+  traffic_simulator_msgs::msg::BoundingBox box;
+  box.dimensions.x = 1.0;
+  box.dimensions.y = 1.0;
+  box.dimensions.z = 1.0;
+  pose1.position.x = 1.0;
+  EXPECT_TRUE(math::geometry::checkCollision2D(pose0, box, pose1, box));
+}
+
+TEST(Collision, GetCollidingPairs)
+{
+  traffic_simulator_msgs::msg::BoundingBox box;
+  box.dimensions.x = 1.0;
+  box.dimensions.y = 1.0;
+  box.dimensions.z = 1.0;
+  math::geometry::OrientedBoxes boxes;
+  for (const auto & [x, z] : std::vector<std::pair<double, double>>{
+         {3.0, 0.0}, {0.0, 0.0}, {2.5, 0.0}, {0.0, 30.0}, {0.5, 0.0}, {10.0, 0.0}}) {
+    geometry_msgs::msg::Pose pose;
+    pose.position.x = x;
+    pose.position.z = z;
+    boxes.add(pose, box);
+  }
+  EXPECT_EQ(
+    boxes.getCollidingPairs(),
+    (std::vector<std::pair<std::size_t, std::size_t>>{{0, 2}, {1, 4}}));
+  boxes.clear();
+  EXPECT_EQ(boxes.size(), 0u);
+  EXPECT_TRUE(boxes.getCollidingPairs().empty());
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
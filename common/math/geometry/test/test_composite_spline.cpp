@@ -0,0 +1,115 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <geometry/spline/composite_spline.hpp>
+#include <memory>
+#include <scenario_simulator_exception/exception.hpp>
+#include <vector>
+
+#include "expect_eq_macros.hpp"
+
+auto makeLine(double x0, double x1) -> std::shared_ptr<const math::geometry::CatmullRomSpline>
+{
+  geometry_msgs::msg::Point p0;
+  p0.x = x0;
+  geometry_msgs::msg::Point p1;
+  p1.x = x1;
+  return std::make_shared<math::geometry::CatmullRomSpline>(
+    std::vector<geometry_msgs::msg::Point>{p0, p1});
+}
+
+auto makePoint(double x, double y) -> geometry_msgs::msg::Point
+{
+  geometry_msgs::msg::Point point;
+  point.x = x;
+  point.y = y;
+  return point;
+}
+
+TEST(CompositeSpline, GetPoint)
+{
+  math::geometry::CompositeSpline spline;
+  spline.pushBack(makeLine(0.0, 1.0));
+  spline.pushBack(makeLine(1.0, 3.0));
+  EXPECT_DOUBLE_EQ(spline.getLength(), 3.0);
+  EXPECT_POINT_EQ(spline.getPoint(0.5), makePoint(0.5, 0.0));
+  EXPECT_POINT_EQ(spline.getPoint(2.5), makePoint(2.5, 0.0));
+  EXPECT_POINT_EQ(spline.getPoint(2.5, 1.0), makePoint(2.5, 1.0));
+  /// @note Extended along the tangent of its ends.
+  EXPECT_POINT_EQ(spline.getPoint(-1.0), makePoint(-1.0, 0.0));
+  EXPECT_POINT_EQ(spline.getPoint(4.0), makePoint(4.0, 0.0));
+}
+
+TEST(CompositeSpline, PushAndPop)
+{
+  math::geometry::CompositeSpline spline;
+  spline.pushBack(makeLine(0.0, 1.0));
+  spline.pushBack(makeLine(1.0, 3.0));
+  spline.pushBack(makeLine(3.0, 6.0));
+  spline.popFront();
+  EXPECT_EQ(spline.size(), 2u);
+  EXPECT_DOUBLE_EQ(spline.getLength(), 5.0);
+  EXPECT_POINT_EQ(spline.getPoint(0.0), makePoint(1.0, 0.0));
+  EXPECT_POINT_EQ(spline.getPoint(4.0), makePoint(5.0, 0.0));
+  spline.popBack();
+  spline.pushBack(makeLine(3.0, 4.0));
+  EXPECT_DOUBLE_EQ(spline.getLength(), 3.0);
+  EXPECT_POINT_EQ(spline.getPoint(2.5), makePoint(3.5, 0.0));
+}
+
+TEST(CompositeSpline, GetTrajectory)
+{
+  math::geometry::CompositeSpline spline;
+  spline.pushBack(makeLine(0.0, 1.0));
+  spline.pushBack(makeLine(1.0, 3.0));
+  const auto trajectory = spline.getTrajectory(0.0, 3.0, 1.0);
+  ASSERT_EQ(trajectory.size(), 4u);
+  for (std::size_t i = 0; i < trajectory.size(); ++i) {
+    EXPECT_POINT_EQ(trajectory[i], makePoint(i, 0.0));
+  }
+}
+
+TEST(CompositeSpline, GetCollisionPointIn2D)
+{
+  math::geometry::CompositeSpline spline;
+  spline.pushBack(makeLine(0.0, 1.0));
+  spline.pushBack(makeLine(1.0, 2.0));
+  spline.pushBack(makeLine(2.0, 3.0));
+  spline.popFront();
+  const std::vector<geometry_msgs::msg::Point> polygon{
+    makePoint(1.5, -1.0), makePoint(2.5, -1.0), makePoint(2.5, 1.0), makePoint(1.5, 1.0)};
+  const auto forward = spline.getCollisionPointIn2D(polygon, false);
+  ASSERT_TRUE(forward);
+  EXPECT_DOUBLE_EQ(forward.value(), 0.5);
+  const auto backward = spline.getCollisionPointIn2D(polygon, true);
+  ASSERT_TRUE(backward);
+  EXPECT_DOUBLE_EQ(backward.value(), 1.5);
+  EXPECT_FALSE(spline.getCollisionPointIn2D(
+    {makePoint(0.2, -1.0), makePoint(0.8, -1.0), makePoint(0.8, 1.0), makePoint(0.2, 1.0)}));
+}
+
+TEST(CompositeSpline, Empty)
+{
+  math::geometry::CompositeSpline spline;
+  EXPECT_DOUBLE_EQ(spline.getLength(), 0.0);
+  EXPECT_THROW(spline.getPoint(0.0), common::SimulationError);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -162,6 +162,28 @@ TEST(HermiteCurveTest, CheckNormalVector)
   }
 }
 
+TEST(HermiteCurveTest, ArcLengthParameterization)
+{
+  /// @note x(t) = 0.5t^3 + 0.5t, so the curve parameter is not proportional to the arc length.
+  geometry_msgs::msg::Pose start_pose, goal_pose;
+  geometry_msgs::msg::Vector3 start_vec, goal_vec;
+  goal_pose.position.x = 1;
+  start_vec.x = 0.5;
+  goal_vec.x = 2;
+  math::geometry::HermiteCurve curve(start_pose, goal_pose, start_vec, goal_vec, true);
+  math::geometry::HermiteCurve normalized_curve(start_pose, goal_pose, start_vec, goal_vec);
+  EXPECT_DOUBLE_EQ(curve.getLength(), normalized_curve.getLength());
+  EXPECT_DOUBLE_EQ(curve.getPoint(0, true).x, 0);
+  EXPECT_DOUBLE_EQ(curve.getPoint(curve.getLength(), true).x, 1);
+  for (double s = 0.1; s < 1; s = s + 0.1) {
+    EXPECT_NEAR(curve.getPoint(s, true).x, s, 0.02);
+    geometry_msgs::msg::Pose p;
+    p.position.x = s;
+    EXPECT_NEAR(curve.getSValue(p, 1, true).value(), s, 0.02);
+  }
+  EXPECT_GT(std::abs(normalized_curve.getPoint(0.5, true).x - 0.5), 0.1);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
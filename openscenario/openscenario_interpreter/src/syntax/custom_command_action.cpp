@@ -125,8 +125,7 @@ struct ApplyV2ITrafficSignalStateAction : public CustomCommand,
       case 2:
         for (auto & traffic_light :
              getV2ITrafficLights(boost::lexical_cast<std::int64_t>(parameters[0]))) {
-          traffic_light.get().clear();
-          traffic_light.get().set(unquote(parameters.at(1)));
+          traffic_light.get().assign(unquote(parameters.at(1)));
         }
         break;
 
@@ -29,8 +29,7 @@ TrafficSignalState::TrafficSignalState(const pugi::xml_node & node, Scope & scop
 auto TrafficSignalState::evaluate() const -> Object
 {
   for (traffic_simulator::TrafficLight & traffic_light : getConventionalTrafficLights(id())) {
-    traffic_light.clear();
-    traffic_light.set(state);
+    traffic_light.assign(state);
   };
 
   return unspecified;
@@ -0,0 +1,55 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_TREE_PLUGIN__BEHAVIOR_TREE_TEMPLATE_HPP_
+#define BEHAVIOR_TREE_PLUGIN__BEHAVIOR_TREE_TEMPLATE_HPP_
+
+#include <behaviortree_cpp_v3/bt_factory.h>
+#include <behaviortree_cpp_v3/xml_parsing.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace behavior_tree_plugin
+{
+/**
+ * @brief Behavior tree description shared by every behavior tree of one kind of entity.
+ * @note The node types are registered, the XML file is loaded, the ports of every registered node
+ *       type are bound to blackboard entries of the same name, and the result is parsed, all once
+ *       on construction. createTree only instantiates a new tree from the parsed description.
+ */
+class BehaviorTreeTemplate
+{
+public:
+  explicit BehaviorTreeTemplate(
+    const std::string & format_path,
+    const std::function<void(BT::BehaviorTreeFactory &)> & register_node_types);
+
+  BehaviorTreeTemplate(const BehaviorTreeTemplate &) = delete;
+
+  auto operator=(const BehaviorTreeTemplate &) -> BehaviorTreeTemplate & = delete;
+
+  /// @brief Instantiate a new tree with its own root blackboard.
+  auto createTree() -> BT::Tree;
+
+private:
+  BT::BehaviorTreeFactory factory_;
+
+  /// @note Refers to factory_, so it is declared after it.
+  std::unique_ptr<BT::XMLParser> parser_;
+};
+}  // namespace behavior_tree_plugin
+
+#endif  // BEHAVIOR_TREE_PLUGIN__BEHAVIOR_TREE_TEMPLATE_HPP_
@@ -18,6 +18,7 @@
 #include <behaviortree_cpp_v3/bt_factory.h>
 #include <behaviortree_cpp_v3/loggers/bt_cout_logger.h>
 
+#include <behavior_tree_plugin/behavior_tree_template.hpp>
 #include <behavior_tree_plugin/pedestrian/follow_lane_action.hpp>
 #include <behavior_tree_plugin/pedestrian/walk_straight_action.hpp>
 #include <behavior_tree_plugin/transition_events/transition_events.hpp>
@@ -39,6 +40,7 @@ class PedestrianBehaviorTree : public BehaviorPluginBase
 {
 public:
   void configure(const rclcpp::Logger & logger) override;
+  void reset() override;
   void update(double current_time, double step_time) override;
   const std::string & getCurrentAction() const override;
 #define DEFINE_GETTER_SETTER(NAME, TYPE)                                                    \
@@ -61,7 +63,7 @@ public:
   DEFINE_GETTER_SETTER(Obstacle,             std::optional<traffic_simulator_msgs::msg::Obstacle>)
   DEFINE_GETTER_SETTER(OtherEntityStatus,    EntityStatusDict)
   DEFINE_GETTER_SETTER(PedestrianParameters, traffic_simulator_msgs::msg::PedestrianParameters)
-  DEFINE_GETTER_SETTER(ReferenceTrajectory,  std::shared_ptr<math::geometry::CatmullRomSpline>)
+  DEFINE_GETTER_SETTER(ReferenceTrajectory,  std::shared_ptr<math::geometry::CatmullRomSplineInterface>)
   DEFINE_GETTER_SETTER(Request,              traffic_simulator::behavior::Request)
   DEFINE_GETTER_SETTER(RouteLanelets,        lanelet::Ids)
   DEFINE_GETTER_SETTER(StepTime,             double)
@@ -76,8 +78,8 @@ public:
 
 private:
   BT::NodeStatus tickOnce(double current_time, double step_time);
-  auto createBehaviorTree(const std::string & format_path) -> BT::Tree;
-  BT::BehaviorTreeFactory factory_;
+  /// @brief Tree description shared by every instance of this plugin in the process.
+  static auto getTemplate() -> behavior_tree_plugin::BehaviorTreeTemplate &;
   BT::Tree tree_;
   std::unique_ptr<behavior_tree_plugin::LoggingEvent> logging_event_ptr_;
   std::unique_ptr<behavior_tree_plugin::ResetRequestEvent> reset_request_event_ptr_;
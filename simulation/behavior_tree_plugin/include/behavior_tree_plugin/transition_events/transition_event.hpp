@@ -27,6 +27,8 @@ class TransitionEvent
 {
 public:
   TransitionEvent(BT::TreeNode * root_node);
+  /// @note Forget the current action, as halting the tree does not notify IDLE transitions.
+  void clearCurrentAction();
 
 protected:
   virtual void callback(
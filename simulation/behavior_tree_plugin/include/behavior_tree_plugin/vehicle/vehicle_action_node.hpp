@@ -42,7 +42,7 @@ public:
   {
     BT::PortsList ports = {
       // clang-format off
-      BT::InputPort<std::shared_ptr<math::geometry::CatmullRomSpline>>("reference_trajectory"),
+      BT::InputPort<std::shared_ptr<math::geometry::CatmullRomSplineInterface>>("reference_trajectory"),
       BT::InputPort<traffic_simulator_msgs::msg::BehaviorParameter>("behavior_parameter"),
       BT::InputPort<traffic_simulator_msgs::msg::VehicleParameters>("vehicle_parameters"),
       // clang-format on
@@ -64,7 +64,7 @@ public:
 protected:
   traffic_simulator_msgs::msg::BehaviorParameter behavior_parameter;
   traffic_simulator_msgs::msg::VehicleParameters vehicle_parameters;
-  std::shared_ptr<math::geometry::CatmullRomSpline> reference_trajectory;
+  std::shared_ptr<math::geometry::CatmullRomSplineInterface> reference_trajectory;
   std::unique_ptr<math::geometry::CatmullRomSubspline> trajectory;
 };
 }  // namespace entity_behavior
@@ -93,12 +93,8 @@ auto ActionNode::getOtherEntityStatus(lanelet::Id lanelet_id) const
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
   std::vector<traffic_simulator::CanonicalizedEntityStatus> ret;
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      traffic_simulator::isSameLaneletId(status.second, lanelet_id)) {
-      ret.emplace_back(status.second);
-    }
+  for (const auto each : other_entity_status.getEntitiesOnLanelets({lanelet_id})) {
+    ret.emplace_back(each->second);
   }
   return ret;
 }
@@ -143,15 +139,11 @@ auto ActionNode::getRightOfWayEntities(const lanelet::Ids & following_lanelets)
     };
 
   std::vector<traffic_simulator::CanonicalizedEntityStatus> ret;
-  const auto lanelet_ids_list = hdmap_utils->getRightOfWayLaneletIds(following_lanelets);
-  for (const auto & status : other_entity_status) {
-    for (const auto & following_lanelet : following_lanelets) {
-      for (const lanelet::Id & lanelet_id : lanelet_ids_list.at(following_lanelet)) {
-        if (
-          status.second.laneMatchingSucceed() &&
-          traffic_simulator::isSameLaneletId(status.second, lanelet_id) &&
-          not is_the_same_right_of_way(lanelet_id, following_lanelet)) {
-          ret.emplace_back(status.second);
+  for (const auto & following_lanelet : following_lanelets) {
+    for (const lanelet::Id & lanelet_id : hdmap_utils->getRightOfWayLaneletIds(following_lanelet)) {
+      if (not is_the_same_right_of_way(lanelet_id, following_lanelet)) {
+        for (const auto each : other_entity_status.getEntitiesOnLanelets({lanelet_id})) {
+          ret.emplace_back(each->second);
         }
       }
     }
@@ -171,14 +163,8 @@ auto ActionNode::getRightOfWayEntities() const
   if (lanelet_ids.empty()) {
     return ret;
   }
-  for (const auto & status : other_entity_status) {
-    for (const lanelet::Id & lanelet_id : lanelet_ids) {
-      if (
-        status.second.laneMatchingSucceed() &&
-        traffic_simulator::isSameLaneletId(status.second, lanelet_id)) {
-        ret.emplace_back(status.second);
-      }
-    }
+  for (const auto each : other_entity_status.getEntitiesOnLanelets(lanelet_ids)) {
+    ret.emplace_back(each->second);
   }
   return ret;
 }
@@ -196,9 +182,11 @@ auto ActionNode::getDistanceToTrafficLightStopLine(
     using Color = traffic_simulator::TrafficLight::Color;
     using Status = traffic_simulator::TrafficLight::Status;
     using Shape = traffic_simulator::TrafficLight::Shape;
-    if (auto && traffic_light = traffic_light_manager->getTrafficLight(id);
-        traffic_light.contains(Color::red, Status::solid_on, Shape::circle) or
-        traffic_light.contains(Color::yellow, Status::solid_on, Shape::circle)) {
+    /// @note A traffic light not created yet has no bulbs, so it is neither red nor yellow.
+    if (const auto traffic_light = traffic_light_manager->findTrafficLight(id);
+        traffic_light and
+        (traffic_light->contains(Color::red, Status::solid_on, Shape::circle) or
+         traffic_light->contains(Color::yellow, Status::solid_on, Shape::circle))) {
       const auto collision_point = hdmap_utils->getDistanceToTrafficLightStopLine(spline, id);
       if (collision_point) {
         collision_points.insert(collision_point.value());
@@ -234,17 +222,17 @@ auto ActionNode::getFrontEntityName(const math::geometry::CatmullRomSplineInterf
   std::vector<double> distances;
   std::vector<std::string> entities;
   for (const auto & each : other_entity_status) {
-    const auto distance = getDistanceToTargetEntityPolygon(spline, each.first);
     const auto quat = quaternion_operation::getRotation(
-      entity_status->getMapPose().orientation,
-      other_entity_status.at(each.first).getMapPose().orientation);
+      entity_status->getMapPose().orientation, each.second.getMapPose().orientation);
     /**
      * @note hard-coded parameter, if the Yaw value of RPY is in ~1.5708 -> 1.5708, entity is a candidate of front entity.
+     * @note The cheap yaw test is done first, so the spline is only tested against candidates.
      */
     if (
       std::fabs(quaternion_operation::convertQuaternionToEulerAngle(quat).z) <=
       boost::math::constants::half_pi<double>()) {
-      if (distance && distance.value() < 40) {
+      if (const auto distance = getDistanceToTargetEntityPolygon(spline, each.second);
+          distance && distance.value() < 40) {
         entities.emplace_back(each.first);
         distances.emplace_back(distance.value());
       }
@@ -340,15 +328,9 @@ auto ActionNode::getConflictingEntityStatusOnCrossWalk(const lanelet::Ids & rout
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
   std::vector<traffic_simulator::CanonicalizedEntityStatus> conflicting_entity_status;
-  auto conflicting_crosswalks = hdmap_utils->getConflictingCrosswalkIds(route_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      std::count(
-        conflicting_crosswalks.begin(), conflicting_crosswalks.end(),
-        status.second.getLaneletPose().lanelet_id) >= 1) {
-      conflicting_entity_status.emplace_back(status.second);
-    }
+  const auto route_conflicts = hdmap_utils->getRouteConflicts(route_lanelets);
+  for (const auto each : other_entity_status.getEntitiesOnLanelets(route_conflicts.crosswalks)) {
+    conflicting_entity_status.emplace_back(each->second);
   }
   return conflicting_entity_status;
 }
@@ -357,38 +339,18 @@ auto ActionNode::getConflictingEntityStatusOnLane(const lanelet::Ids & route_lan
   -> std::vector<traffic_simulator::CanonicalizedEntityStatus>
 {
   std::vector<traffic_simulator::CanonicalizedEntityStatus> conflicting_entity_status;
-  auto conflicting_lanes = hdmap_utils->getConflictingLaneIds(route_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() && std::count(
-                                               conflicting_lanes.begin(), conflicting_lanes.end(),
-                                               status.second.getLaneletPose().lanelet_id) >= 1) {
-      conflicting_entity_status.emplace_back(status.second);
-    }
+  const auto route_conflicts = hdmap_utils->getRouteConflicts(route_lanelets);
+  for (const auto each : other_entity_status.getEntitiesOnLanelets(route_conflicts.lanes)) {
+    conflicting_entity_status.emplace_back(each->second);
   }
   return conflicting_entity_status;
 }
 
 auto ActionNode::foundConflictingEntity(const lanelet::Ids & following_lanelets) const -> bool
 {
-  auto conflicting_crosswalks = hdmap_utils->getConflictingCrosswalkIds(following_lanelets);
-  auto conflicting_lanes = hdmap_utils->getConflictingLaneIds(following_lanelets);
-  for (const auto & status : other_entity_status) {
-    if (
-      status.second.laneMatchingSucceed() &&
-      std::count(
-        conflicting_crosswalks.begin(), conflicting_crosswalks.end(),
-        status.second.getLaneletPose().lanelet_id) >= 1) {
-      return true;
-    }
-    if (
-      status.second.laneMatchingSucceed() && std::count(
-                                               conflicting_lanes.begin(), conflicting_lanes.end(),
-                                               status.second.getLaneletPose().lanelet_id) >= 1) {
-      return true;
-    }
-  }
-  return false;
+  const auto route_conflicts = hdmap_utils->getRouteConflicts(following_lanelets);
+  return not other_entity_status.getEntitiesOnLanelets(route_conflicts.crosswalks).empty() or
+         not other_entity_status.getEntitiesOnLanelets(route_conflicts.lanes).empty();
 }
 
 auto ActionNode::calculateUpdatedEntityStatus(
@@ -0,0 +1,70 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <behavior_tree_plugin/behavior_tree_template.hpp>
+#include <pugixml.hpp>
+#include <sstream>
+#include <string>
+
+namespace behavior_tree_plugin
+{
+BehaviorTreeTemplate::BehaviorTreeTemplate(
+  const std::string & format_path,
+  const std::function<void(BT::BehaviorTreeFactory &)> & register_node_types)
+{
+  register_node_types(factory_);
+
+  auto xml_doc = pugi::xml_document();
+  xml_doc.load_file(format_path.c_str());
+
+  class XMLTreeWalker : public pugi::xml_tree_walker
+  {
+  public:
+    explicit XMLTreeWalker(const BT::TreeNodeManifest & manifest) : manifest_(manifest) {}
+
+  private:
+    bool for_each(pugi::xml_node & node) final
+    {
+      if (node.name() == manifest_.registration_ID) {
+        for (const auto & [port, info] : manifest_.ports) {
+          node.append_attribute(port.c_str()) = std::string("{" + port + "}").c_str();
+        }
+      }
+      return true;
+    }
+
+    const BT::TreeNodeManifest & manifest_;
+  };
+
+  for (const auto & [id, manifest] : factory_.manifests()) {
+    if (factory_.builtinNodes().count(id) == 0) {
+      auto walker = XMLTreeWalker(manifest);
+      xml_doc.traverse(walker);
+    }
+  }
+
+  auto xml_str = std::stringstream();
+  xml_doc.save(xml_str);
+  parser_ = std::make_unique<BT::XMLParser>(factory_);
+  parser_->loadFromText(xml_str.str());
+}
+
+auto BehaviorTreeTemplate::createTree() -> BT::Tree
+{
+  /// @note Same as BT::BehaviorTreeFactory::createTreeFromText, without parsing the text again.
+  auto tree = parser_->instantiateTree(BT::Blackboard::create());
+  tree.manifests = factory_.manifests();
+  return tree;
+}
+}  // namespace behavior_tree_plugin
@@ -18,7 +18,6 @@
 #include <behavior_tree_plugin/pedestrian/follow_trajectory_sequence/follow_polyline_trajectory_action.hpp>
 #include <iostream>
 #include <memory>
-#include <pugixml.hpp>
 #include <string>
 #include <utility>
 
@@ -26,14 +25,7 @@ namespace entity_behavior
 {
 void PedestrianBehaviorTree::configure(const rclcpp::Logger & logger)
 {
-  namespace pedestrian = entity_behavior::pedestrian;
-  factory_.registerNodeType<pedestrian::FollowLaneAction>("FollowLane");
-  factory_.registerNodeType<pedestrian::WalkStraightAction>("WalkStraightAction");
-  factory_.registerNodeType<pedestrian::FollowPolylineTrajectoryAction>("FollowPolylineTrajectory");
-
-  auto base_path = ament_index_cpp::get_package_share_directory("behavior_tree_plugin");
-  auto format_path = base_path + "/config/pedestrian_entity_behavior.xml";
-  tree_ = createBehaviorTree(format_path);
+  tree_ = getTemplate().createTree();
   logging_event_ptr_ =
     std::make_unique<behavior_tree_plugin::LoggingEvent>(tree_.rootNode(), logger);
   reset_request_event_ptr_ = std::make_unique<behavior_tree_plugin::ResetRequestEvent>(
@@ -42,40 +34,19 @@ void PedestrianBehaviorTree::configure(const rclcpp::Logger & logger)
   setRequest(traffic_simulator::behavior::Request::NONE);
 }
 
-auto PedestrianBehaviorTree::createBehaviorTree(const std::string & format_path) -> BT::Tree
+auto PedestrianBehaviorTree::getTemplate() -> behavior_tree_plugin::BehaviorTreeTemplate &
 {
-  auto xml_doc = pugi::xml_document();
-  xml_doc.load_file(format_path.c_str());
-
-  class XMLTreeWalker : public pugi::xml_tree_walker
-  {
-  public:
-    explicit XMLTreeWalker(const BT::TreeNodeManifest & manifest) : manifest_(manifest) {}
-
-  private:
-    bool for_each(pugi::xml_node & node) final
-    {
-      if (node.name() == manifest_.registration_ID) {
-        for (const auto & [port, info] : manifest_.ports) {
-          node.append_attribute(port.c_str()) = std::string("{" + port + "}").c_str();
-        }
-      }
-      return true;
-    }
-
-    const BT::TreeNodeManifest & manifest_;
-  };
-
-  for (const auto & [id, manifest] : factory_.manifests()) {
-    if (factory_.builtinNodes().count(id) == 0) {
-      auto walker = XMLTreeWalker(manifest);
-      xml_doc.traverse(walker);
-    }
-  }
-
-  auto xml_str = std::stringstream();
-  xml_doc.save(xml_str);
-  return factory_.createTreeFromText(xml_str.str());
+  static behavior_tree_plugin::BehaviorTreeTemplate tree_template(
+    ament_index_cpp::get_package_share_directory("behavior_tree_plugin") +
+      "/config/pedestrian_entity_behavior.xml",
+    [](BT::BehaviorTreeFactory & factory) {
+      namespace pedestrian = entity_behavior::pedestrian;
+      factory.registerNodeType<pedestrian::FollowLaneAction>("FollowLane");
+      factory.registerNodeType<pedestrian::WalkStraightAction>("WalkStraightAction");
+      factory.registerNodeType<pedestrian::FollowPolylineTrajectoryAction>(
+        "FollowPolylineTrajectory");
+    });
+  return tree_template;
 }
 
 const std::string & PedestrianBehaviorTree::getCurrentAction() const
@@ -83,6 +54,14 @@ const std::string & PedestrianBehaviorTree::getCurrentAction() const
   return logging_event_ptr_->getCurrentAction();
 }
 
+void PedestrianBehaviorTree::reset()
+{
+  tree_.haltTree();
+  logging_event_ptr_->clearCurrentAction();
+  reset_request_event_ptr_->clearCurrentAction();
+  setRequest(traffic_simulator::behavior::Request::NONE);
+}
+
 void PedestrianBehaviorTree::update(double current_time, double step_time)
 {
   tickOnce(current_time, step_time);
@@ -38,6 +38,8 @@ TransitionEvent::TransitionEvent(BT::TreeNode * root_node)
   BT::applyRecursiveVisitor(root_node, visitor);
 }
 
+void TransitionEvent::clearCurrentAction() { current_action_.clear(); }
+
 void TransitionEvent::updateCurrentAction(const BT::NodeStatus & status, const BT::TreeNode & node)
 {
   if (status != BT::NodeStatus::SUCCESS) {
@@ -25,8 +25,6 @@
 #include <behavior_tree_plugin/vehicle/follow_trajectory_sequence/follow_polyline_trajectory_action.hpp>
 #include <behavior_tree_plugin/vehicle/lane_change_action.hpp>
 #include <iostream>
-#include <pugixml.hpp>
-#include <sstream>
 #include <string>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
 #include <utility>
@@ -35,22 +33,7 @@ namespace entity_behavior
 {
 void VehicleBehaviorTree::configure(const rclcpp::Logger & logger)
 {
-  factory_.registerNodeType<vehicle::follow_lane_sequence::FollowLaneAction>("FollowLane");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::FollowFrontEntityAction>(
-    "FollowFrontEntity");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtCrossingEntityAction>(
-    "StopAtCrossingEntity");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtStopLineAction>("StopAtStopLine");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::StopAtTrafficLightAction>(
-    "StopAtTrafficLight");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::YieldAction>("Yield");
-  factory_.registerNodeType<vehicle::follow_lane_sequence::MoveBackwardAction>("MoveBackward");
-  factory_.registerNodeType<vehicle::FollowPolylineTrajectoryAction>("FollowPolylineTrajectory");
-  factory_.registerNodeType<vehicle::LaneChangeAction>("LaneChange");
-
-  tree_ = createBehaviorTree(
-    ament_index_cpp::get_package_share_directory("behavior_tree_plugin") +
-    "/config/vehicle_entity_behavior.xml");
+  tree_ = getTemplate().createTree();
 
   logging_event_ptr_ =
     std::make_unique<behavior_tree_plugin::LoggingEvent>(tree_.rootNode(), logger);
@@ -62,40 +45,28 @@ void VehicleBehaviorTree::configure(const rclcpp::Logger & logger)
   setRequest(traffic_simulator::behavior::Request::NONE);
 }
 
-auto VehicleBehaviorTree::createBehaviorTree(const std::string & format_path) -> BT::Tree
+auto VehicleBehaviorTree::getTemplate() -> behavior_tree_plugin::BehaviorTreeTemplate &
 {
-  auto xml_doc = pugi::xml_document();
-  xml_doc.load_file(format_path.c_str());
-
-  class XMLTreeWalker : public pugi::xml_tree_walker
-  {
-  public:
-    explicit XMLTreeWalker(const BT::TreeNodeManifest & manifest) : manifest_(manifest) {}
-
-  private:
-    bool for_each(pugi::xml_node & node) final
-    {
-      if (node.name() == manifest_.registration_ID) {
-        for (const auto & [port, info] : manifest_.ports) {
-          node.append_attribute(port.c_str()) = std::string("{" + port + "}").c_str();
-        }
-      }
-      return true;
-    }
-
-    const BT::TreeNodeManifest & manifest_;
-  };
-
-  for (const auto & [id, manifest] : factory_.manifests()) {
-    if (factory_.builtinNodes().count(id) == 0) {
-      auto walker = XMLTreeWalker(manifest);
-      xml_doc.traverse(walker);
-    }
-  }
-
-  auto xml_str = std::stringstream();
-  xml_doc.save(xml_str);
-  return factory_.createTreeFromText(xml_str.str());
+  static behavior_tree_plugin::BehaviorTreeTemplate tree_template(
+    ament_index_cpp::get_package_share_directory("behavior_tree_plugin") +
+      "/config/vehicle_entity_behavior.xml",
+    [](BT::BehaviorTreeFactory & factory) {
+      namespace follow_lane_sequence = vehicle::follow_lane_sequence;
+      factory.registerNodeType<follow_lane_sequence::FollowLaneAction>("FollowLane");
+      factory.registerNodeType<follow_lane_sequence::FollowFrontEntityAction>(
+        "FollowFrontEntity");
+      factory.registerNodeType<follow_lane_sequence::StopAtCrossingEntityAction>(
+        "StopAtCrossingEntity");
+      factory.registerNodeType<follow_lane_sequence::StopAtStopLineAction>("StopAtStopLine");
+      factory.registerNodeType<follow_lane_sequence::StopAtTrafficLightAction>(
+        "StopAtTrafficLight");
+      factory.registerNodeType<follow_lane_sequence::YieldAction>("Yield");
+      factory.registerNodeType<follow_lane_sequence::MoveBackwardAction>("MoveBackward");
+      factory.registerNodeType<vehicle::FollowPolylineTrajectoryAction>(
+        "FollowPolylineTrajectory");
+      factory.registerNodeType<vehicle::LaneChangeAction>("LaneChange");
+    });
+  return tree_template;
 }
 
 auto VehicleBehaviorTree::getBehaviorParameter() -> traffic_simulator_msgs::msg::BehaviorParameter
@@ -142,6 +113,14 @@ const std::string & VehicleBehaviorTree::getCurrentAction() const
   return logging_event_ptr_->getCurrentAction();
 }
 
+void VehicleBehaviorTree::reset()
+{
+  tree_.haltTree();
+  logging_event_ptr_->clearCurrentAction();
+  reset_request_event_ptr_->clearCurrentAction();
+  setRequest(traffic_simulator::behavior::Request::NONE);
+}
+
 void VehicleBehaviorTree::update(double current_time, double step_time)
 {
   tickOnce(current_time, step_time);
@@ -37,7 +37,7 @@ void VehicleActionNode::getBlackBoardValues()
         "vehicle_parameters", vehicle_parameters)) {
     THROW_SIMULATION_ERROR("failed to get input vehicle_parameters in VehicleActionNode");
   }
-  if (!getInput<std::shared_ptr<math::geometry::CatmullRomSpline>>(
+  if (!getInput<std::shared_ptr<math::geometry::CatmullRomSplineInterface>>(
         "reference_trajectory", reference_trajectory)) {
     THROW_SIMULATION_ERROR("failed to get input reference_trajectory in VehicleActionNode");
   }
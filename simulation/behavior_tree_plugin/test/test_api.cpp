@@ -0,0 +1,369 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <rclcpp/rclcpp.hpp>
+#include <simulation_interface/constants.hpp>
+#include <simulation_interface/zmq_multi_server.hpp>
+#include <string>
+#include <traffic_simulator/api/api.hpp>
+#include <traffic_simulator/api/configuration.hpp>
+#include <traffic_simulator/helper/helper.hpp>
+#include <utility>
+#include <vector>
+
+#include "catalogs.hpp"
+
+template <typename Response>
+auto succeed() -> Response
+{
+  Response response;
+  response.mutable_result()->set_success(true);
+  return response;
+}
+
+/**
+ * @note Simulator which records the entity status, traffic lights and time it receives, in the
+ * order in which ScenarioSimulator handles them. Requests packed in a FrameRequest are unpacked.
+ */
+class RecordingSimulator
+{
+public:
+  explicit RecordingSimulator(const unsigned int port)
+  : server_(
+      simulation_interface::protocol, simulation_interface::HostName::ANY, port,
+      [](auto &&...) { return succeed<simulation_api_schema::InitializeResponse>(); },
+      [this](const auto & req) { return updateFrame(req); },
+      [](auto &&...) { return succeed<simulation_api_schema::SpawnVehicleEntityResponse>(); },
+      [](auto &&...) { return succeed<simulation_api_schema::SpawnPedestrianEntityResponse>(); },
+      [](auto &&...) { return succeed<simulation_api_schema::SpawnMiscObjectEntityResponse>(); },
+      [](auto &&...) { return succeed<simulation_api_schema::DespawnEntityResponse>(); },
+      [this](const auto & req) { return updateEntityStatus(req); },
+      [](auto &&...) { return succeed<simulation_api_schema::AttachLidarSensorResponse>(); },
+      [](auto &&...) { return succeed<simulation_api_schema::AttachDetectionSensorResponse>(); },
+      [](auto &&...) {
+        return succeed<simulation_api_schema::AttachOccupancyGridSensorResponse>();
+      },
+      [this](const auto & req) { return updateTrafficLights(req); },
+      [](auto &&...) {
+        return succeed<simulation_api_schema::FollowPolylineTrajectoryResponse>();
+      },
+      [](auto &&...) {
+        return succeed<simulation_api_schema::AttachPseudoTrafficLightDetectorResponse>();
+      },
+      [this](const auto & req) { return updateEntityStatusDelta(req); },
+      [this](const auto & req) { return frame(req); })
+  {
+  }
+
+  auto getRequests() const -> std::vector<std::string>
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_;
+  }
+
+  /// @brief Number of FrameRequests received without and with overlap_sensor_simulation.
+  auto getFrameRequestCounts() const -> std::pair<int, int>
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frame_request_counts_;
+  }
+
+private:
+  auto record(const google::protobuf::Message & request) -> void
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_.push_back(request.GetTypeName() + " " + request.ShortDebugString());
+  }
+
+  auto updateFrame(const simulation_api_schema::UpdateFrameRequest & req)
+    -> simulation_api_schema::UpdateFrameResponse
+  {
+    /// @note ROS time is taken from the wall clock, so it differs between two runs
+    auto recorded = req;
+    recorded.clear_current_ros_time();
+    record(recorded);
+    return succeed<simulation_api_schema::UpdateFrameResponse>();
+  }
+
+  auto updateEntityStatus(const simulation_api_schema::UpdateEntityStatusRequest & req)
+    -> simulation_api_schema::UpdateEntityStatusResponse
+  {
+    record(req);
+    auto res = succeed<simulation_api_schema::UpdateEntityStatusResponse>();
+    for (const auto & status : req.status()) {
+      auto updated_status = res.add_status();
+      updated_status->set_name(status.name());
+      updated_status->mutable_action_status()->CopyFrom(status.action_status());
+      updated_status->mutable_pose()->CopyFrom(status.pose());
+    }
+    return res;
+  }
+
+  auto updateEntityStatusDelta(const simulation_api_schema::UpdateEntityStatusDeltaRequest & req)
+    -> simulation_api_schema::UpdateEntityStatusDeltaResponse
+  {
+    record(req);
+    return succeed<simulation_api_schema::UpdateEntityStatusDeltaResponse>();
+  }
+
+  auto updateTrafficLights(const simulation_api_schema::UpdateTrafficLightsRequest & req)
+    -> simulation_api_schema::UpdateTrafficLightsResponse
+  {
+    record(req);
+    return succeed<simulation_api_schema::UpdateTrafficLightsResponse>();
+  }
+
+  auto frame(const simulation_api_schema::FrameRequest & req)
+    -> simulation_api_schema::FrameResponse
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++(req.overlap_sensor_simulation() ? frame_request_counts_.second
+                                         : frame_request_counts_.first);
+    }
+    simulation_api_schema::FrameResponse res;
+    if (req.has_update_traffic_lights()) {
+      *res.mutable_update_traffic_lights() = updateTrafficLights(req.update_traffic_lights());
+    }
+    if (req.has_update_frame()) {
+      *res.mutable_update_frame() = updateFrame(req.update_frame());
+    }
+    if (req.has_update_entity_status()) {
+      *res.mutable_update_entity_status() = updateEntityStatus(req.update_entity_status());
+    }
+    if (req.has_update_entity_status_delta()) {
+      *res.mutable_update_entity_status_delta() =
+        updateEntityStatusDelta(req.update_entity_status_delta());
+    }
+    return res;
+  }
+
+  mutable std::mutex mutex_;
+
+  std::vector<std::string> requests_;
+
+  std::pair<int, int> frame_request_counts_;
+
+  zeromq::MultiServer server_;
+};
+
+/// @note MultiServer polls until rclcpp is shut down, so the simulators are destroyed after that.
+std::list<RecordingSimulator> simulators;
+
+/**
+ * @brief Run a scenario of NPCs and a red traffic light against a RecordingSimulator.
+ * @param between_frames is called before each frame with the index of that frame. By default it
+ *        starts the NPC logic before the first frame.
+ * @return Requests received by the simulator when each frame has been updated.
+ */
+auto recordRequests(
+  const unsigned int port,
+  const std::function<void(traffic_simulator::Configuration &)> & configure, const int frames,
+  const std::function<void(traffic_simulator::API &, int)> & between_frames =
+    [](auto & api, auto frame) {
+      if (frame == 0) {
+        api.startNpcLogic();
+      }
+    }) -> std::vector<std::vector<std::string>>
+{
+  auto & simulator = simulators.emplace_back(port);
+  auto configuration = traffic_simulator::Configuration(
+    ament_index_cpp::get_package_share_directory("kashiwanoha_map") + "/map");
+  configuration.lanelet2_map_file = "lanelet2_map.osm";
+  configure(configuration);
+  const auto node = std::make_shared<rclcpp::Node>(
+    "api_" + std::to_string(port),
+    rclcpp::NodeOptions().parameter_overrides({rclcpp::Parameter("port", static_cast<int>(port))}));
+  traffic_simulator::API api(node, configuration, 1.0, 20.0);
+  api.getConventionalTrafficLight(34802).emplace(traffic_simulator::TrafficLight::Color::red);
+  for (const auto & [name, lanelet_id, s, speed] : {
+         std::make_tuple("npc1", 34579, 20.0, 5.0),
+         std::make_tuple("npc2", 34579, 5.0, 10.0),
+         std::make_tuple("npc3", 34606, 20.0, 0.0),
+       }) {
+    api.spawn(
+      name, api.canonicalize(traffic_simulator::helper::constructLaneletPose(lanelet_id, s)),
+      getVehicleParameters());
+    api.setLinearVelocity(name, speed);
+    api.requestSpeedChange(name, speed, true);
+  }
+  std::vector<std::vector<std::string>> requests;
+  for (int frame = 0; frame < frames; ++frame) {
+    between_frames(api, frame);
+    EXPECT_TRUE(api.updateFrame());
+    requests.push_back(simulator.getRequests());
+  }
+  api.closeZMQConnection();
+  if (configuration.batch_frame_update) {
+    EXPECT_EQ(
+      simulator.getFrameRequestCounts(),
+      configuration.overlap_sensor_simulation ? std::make_pair(0, frames)
+                                              : std::make_pair(frames, 0));
+  }
+  return requests;
+}
+
+/**
+ * @brief Compare the requests received with batch_frame_update to those received without it.
+ * @note The entity status of each frame is sent when the frame starts, together with the traffic
+ * lights and time of the previous frame. So the simulator is supposed to receive the same sequence
+ * of requests, only without the traffic lights and time of the frame which has just been updated.
+ */
+auto expectSameRequests(
+  const std::vector<std::vector<std::string>> & unbatched,
+  const std::vector<std::vector<std::string>> & batched) -> void
+{
+  const auto is_frame_end = [](const auto & request) {
+    return request.rfind("simulation_api_schema.UpdateTrafficLightsRequest", 0) == 0 or
+           request.rfind("simulation_api_schema.UpdateFrameRequest", 0) == 0;
+  };
+  ASSERT_EQ(unbatched.size(), batched.size());
+  for (std::size_t frame = 0; frame < unbatched.size(); ++frame) {
+    ASSERT_EQ(unbatched[frame].back().rfind("simulation_api_schema.UpdateFrameRequest", 0), 0);
+    ASSERT_LE(batched[frame].size(), unbatched[frame].size()) << "frame " << frame;
+    for (std::size_t i = 0; i < batched[frame].size(); ++i) {
+      EXPECT_EQ(batched[frame][i], unbatched[frame][i]) << "frame " << frame;
+    }
+    ASSERT_FALSE(is_frame_end(batched[frame].back())) << "frame " << frame;
+    for (auto i = batched[frame].size(); i < unbatched[frame].size(); ++i) {
+      EXPECT_TRUE(is_frame_end(unbatched[frame][i])) << "frame " << frame;
+    }
+  }
+}
+
+/**
+ * @note Testcase for Configuration::batch_frame_update.
+ * With batched updates, the simulator is supposed to receive the same sequence of requests as
+ * without them.
+ */
+TEST(API, BatchFrameUpdate)
+{
+  constexpr int frames = 40;
+  unsigned int port = 5565;
+  for (const auto delta_entity_status_update : {false, true}) {
+    const auto unbatched = recordRequests(
+      port++, [&](auto & configuration) {
+        configuration.delta_entity_status_update = delta_entity_status_update;
+      },
+      frames);
+    const auto batched = recordRequests(
+      port++,
+      [&](auto & configuration) {
+        configuration.delta_entity_status_update = delta_entity_status_update;
+        configuration.batch_frame_update = true;
+      },
+      frames);
+    expectSameRequests(unbatched, batched);
+  }
+}
+
+/**
+ * @note Testcase for Configuration::batch_frame_update.
+ * Teleporting Ego and NPCs, changing the speed of NPCs and spawning entities between two frames
+ * are supposed to reach the simulator with the next frame, just as without batched updates. The
+ * status of Ego which the simulator returns for that frame is supposed to include the teleport.
+ */
+TEST(API, BatchFrameUpdateWithChangesBetweenFrames)
+{
+  constexpr int frames = 20;
+  unsigned int port = 5575;
+  const auto ego_pose = traffic_simulator::helper::constructLaneletPose(34513, 10.0);
+  for (const auto delta_entity_status_update : {false, true}) {
+    const auto between_frames = [&](traffic_simulator::API & api, const int frame) {
+      switch (frame) {
+        case 0:
+          api.spawn(
+            "ego", api.canonicalize(traffic_simulator::helper::constructLaneletPose(34513, 0.0)),
+            getVehicleParameters(), traffic_simulator::VehicleBehavior::autoware());
+          break;
+        case 2:
+          api.setEntityStatus("ego", api.canonicalize(ego_pose));
+          api.setEntityStatus(
+            "npc1", api.canonicalize(traffic_simulator::helper::constructLaneletPose(34579, 30.0)));
+          api.setLinearVelocity("npc2", 1.0);
+          break;
+        case 3:
+          /// @note The simulator of this test returns the entity status it receives, unless delta.
+          if (not delta_entity_status_update) {
+            EXPECT_EQ(api.getMapPose("ego"), api.toMapPose(ego_pose));
+          }
+          api.spawn(
+            "npc4", api.canonicalize(traffic_simulator::helper::constructLaneletPose(34606, 0.0)),
+            getVehicleParameters());
+          break;
+        case 4:
+          api.startNpcLogic();
+          break;
+        case 8:
+          api.setLinearVelocity("npc3", 3.0);
+          api.despawn("npc4");
+          break;
+      }
+    };
+    const auto unbatched = recordRequests(
+      port++, [&](auto & configuration) {
+        configuration.delta_entity_status_update = delta_entity_status_update;
+      },
+      frames, between_frames);
+    const auto batched = recordRequests(
+      port++,
+      [&](auto & configuration) {
+        configuration.delta_entity_status_update = delta_entity_status_update;
+        configuration.batch_frame_update = true;
+      },
+      frames, between_frames);
+    expectSameRequests(unbatched, batched);
+  }
+}
+
+/**
+ * @note Testcase for Configuration::overlap_sensor_simulation.
+ * It is supposed to be passed to the simulator with every FrameRequest, without changing the
+ * requests themselves.
+ */
+TEST(API, OverlapSensorSimulation)
+{
+  constexpr int frames = 20;
+  const auto batched = recordRequests(
+    5585, [](auto & configuration) { configuration.batch_frame_update = true; }, frames);
+  const auto overlapped = recordRequests(
+    5586,
+    [](auto & configuration) {
+      configuration.batch_frame_update = true;
+      configuration.overlap_sensor_simulation = true;
+    },
+    frames);
+  EXPECT_EQ(batched, overlapped);
+}
+
+int main(int argc, char ** argv)
+{
+  /// @note Ego is not given an Autoware, as the simulator of this test only records requests.
+  std::vector<const char *> args(argv, argv + argc);
+  args.insert(args.end(), {"--ros-args", "-p", "launch_autoware:=false"});
+  rclcpp::init(static_cast<int>(args.size()), args.data());
+  testing::InitGoogleTest(&argc, argv);
+  const auto result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  simulators.clear();
+  return result;
+}
@@ -0,0 +1,63 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <behavior_tree_plugin/pedestrian/behavior_tree.hpp>
+#include <behavior_tree_plugin/vehicle/behavior_tree.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <string>
+
+/**
+ * @note Testcase for BehaviorTreeTemplate::createTree.
+ * Trees created from the same template are supposed to have their own root blackboard, so a port
+ * set on one of them is not seen by the other.
+ */
+template <typename BehaviorTree>
+auto expectIndependentBlackboards() -> void
+{
+  BehaviorTree tree0, tree1;
+  tree0.configure(rclcpp::get_logger("tree0"));
+  tree1.configure(rclcpp::get_logger("tree1"));
+
+  tree0.setRequest(traffic_simulator::behavior::Request::FOLLOW_LANE);
+  EXPECT_EQ(tree0.getRequest(), traffic_simulator::behavior::Request::FOLLOW_LANE);
+  EXPECT_EQ(tree1.getRequest(), traffic_simulator::behavior::Request::NONE);
+
+  tree1.setCurrentTime(2.0);
+  EXPECT_ANY_THROW(tree0.getCurrentTime());
+  tree0.setCurrentTime(1.0);
+  EXPECT_EQ(tree0.getCurrentTime(), 1.0);
+  EXPECT_EQ(tree1.getCurrentTime(), 2.0);
+
+  tree0.setRouteLanelets(lanelet::Ids{34579, 34675});
+  EXPECT_EQ(tree0.getRouteLanelets(), (lanelet::Ids{34579, 34675}));
+  EXPECT_ANY_THROW(tree1.getRouteLanelets());
+}
+
+TEST(BehaviorTreeTemplate, VehicleBlackboards)
+{
+  expectIndependentBlackboards<entity_behavior::VehicleBehaviorTree>();
+}
+
+TEST(BehaviorTreeTemplate, PedestrianBlackboards)
+{
+  expectIndependentBlackboards<entity_behavior::PedestrianBehaviorTree>();
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
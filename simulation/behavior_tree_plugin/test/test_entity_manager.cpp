@@ -0,0 +1,355 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <memory>
+#include <rclcpp/rclcpp.hpp>
+#include <set>
+#include <string>
+#include <traffic_simulator/api/configuration.hpp>
+#include <traffic_simulator/entity/entity_manager.hpp>
+#include <traffic_simulator/helper/helper.hpp>
+#include <utility>
+#include <vector>
+
+#include "catalogs.hpp"
+
+class Simulation
+{
+public:
+  explicit Simulation(const std::string & node_name, const bool parallel_npc_logic = false)
+  : node(std::make_shared<rclcpp::Node>(node_name)),
+    entity_manager(node, makeConfiguration(parallel_npc_logic))
+  {
+  }
+
+  auto canonicalize(lanelet::Id lanelet_id, double s) -> traffic_simulator::CanonicalizedLaneletPose
+  {
+    return traffic_simulator::CanonicalizedLaneletPose(
+      traffic_simulator::helper::constructLaneletPose(lanelet_id, s),
+      entity_manager.getHdmapUtils());
+  }
+
+  auto update() -> void
+  {
+    entity_manager.update(time, step_time);
+    time += step_time;
+  }
+
+  const rclcpp::Node::SharedPtr node;
+
+  traffic_simulator::entity::EntityManager entity_manager;
+
+  static constexpr double step_time = 0.05;
+
+private:
+  static auto makeConfiguration(const bool parallel_npc_logic) -> traffic_simulator::Configuration
+  {
+    auto configuration = traffic_simulator::Configuration(
+      ament_index_cpp::get_package_share_directory("kashiwanoha_map") + "/map");
+    configuration.lanelet2_map_file = "lanelet2_map.osm";
+    configuration.parallel_npc_logic = parallel_npc_logic;
+    return configuration;
+  }
+
+  double time = 0.0;
+};
+
+/**
+ * @note Testcase for EntityManager::updateNpcLogicInParallel.
+ * NPCs following each other and stopping at a red traffic light are supposed to move exactly as
+ * they do when updated one by one.
+ */
+TEST(EntityManager, ParallelNpcLogic)
+{
+  Simulation serial("serial_npc_logic");
+  Simulation parallel("parallel_npc_logic", true);
+  for (auto * simulation : {&serial, &parallel}) {
+    auto & entity_manager = simulation->entity_manager;
+    entity_manager.getConventionalTrafficLight(34802).emplace(
+      traffic_simulator::TrafficLight::Color::red);
+    for (const auto & [name, lanelet_id, s, speed] : {
+           std::make_tuple("npc1", 34579, 20.0, 5.0),
+           std::make_tuple("npc2", 34579, 5.0, 10.0),
+           std::make_tuple("npc3", 34606, 20.0, 5.0),
+           std::make_tuple("npc4", 34468, 0.0, 10.0),
+           std::make_tuple("npc5", 34513, 0.0, 8.0),
+         }) {
+      entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+        name, simulation->canonicalize(lanelet_id, s), getVehicleParameters());
+      entity_manager.setLinearVelocity(name, speed);
+      entity_manager.requestSpeedChange(name, speed, true);
+    }
+    entity_manager.requestAcquirePosition("npc1", simulation->canonicalize(34675, 0.0));
+    entity_manager.requestAcquirePosition("npc5", simulation->canonicalize(34630, 0.0));
+    entity_manager.startNpcLogic();
+  }
+  for (int step = 0; step < 200; ++step) {
+    serial.update();
+    parallel.update();
+    for (const auto & name : serial.entity_manager.getEntityNames()) {
+      ASSERT_EQ(
+        static_cast<traffic_simulator::EntityStatus>(serial.entity_manager.getEntityStatus(name)),
+        static_cast<traffic_simulator::EntityStatus>(
+          parallel.entity_manager.getEntityStatus(name)))
+        << name << " differs at step " << step;
+    }
+  }
+}
+
+/**
+ * @note Testcase for EntityManager::poolEntityOnDespawn.
+ * An entity spawned again after being despawned with a route, a speed request and a job is
+ * supposed to look and move exactly like an entity constructed from scratch.
+ */
+TEST(EntityManager, EntityPool)
+{
+  Simulation pooled("pooled_entity");
+  Simulation constructed("constructed_entity");
+  pooled.entity_manager.poolEntityOnDespawn("npc");
+  pooled.entity_manager.startNpcLogic();
+  pooled.entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+    "npc", pooled.canonicalize(34579, 20.0), getVehicleParameters());
+  pooled.entity_manager.setLinearVelocity("npc", 5.0);
+  pooled.entity_manager.requestSpeedChange("npc", 3.0, true);
+  pooled.entity_manager.requestAcquirePosition("npc", pooled.canonicalize(34675, 0.0));
+  pooled.entity_manager.activateOutOfRangeJob("npc", -100.0, 100.0, -100.0, 100.0, -100.0, 100.0);
+  auto behavior_parameter = traffic_simulator_msgs::msg::BehaviorParameter();
+  behavior_parameter.see_around = false;
+  behavior_parameter.dynamic_constraints.max_speed = 4.0;
+  pooled.entity_manager.setBehaviorParameter("npc", behavior_parameter);
+  for (int step = 0; step < 40; ++step) {
+    pooled.update();
+    constructed.update();
+  }
+  ASSERT_FALSE(pooled.entity_manager.getRouteLanelets("npc").empty());
+  ASSERT_FALSE(pooled.entity_manager.getCurrentAction("npc").empty());
+  ASSERT_TRUE(pooled.entity_manager.despawnEntity("npc"));
+  ASSERT_FALSE(pooled.entity_manager.entityExists("npc"));
+
+  pooled.entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+    "npc", pooled.canonicalize(34513, 0.0), getVehicleParameters());
+  constructed.entity_manager.startNpcLogic();
+  constructed.entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+    "npc", constructed.canonicalize(34513, 0.0), getVehicleParameters());
+  for (int step = 0; step < 100; ++step) {
+    ASSERT_EQ(
+      static_cast<traffic_simulator::EntityStatus>(pooled.entity_manager.getEntityStatus("npc")),
+      static_cast<traffic_simulator::EntityStatus>(
+        constructed.entity_manager.getEntityStatus("npc")))
+      << "differs at step " << step;
+    ASSERT_EQ(
+      pooled.entity_manager.getRouteLanelets("npc"),
+      constructed.entity_manager.getRouteLanelets("npc"))
+      << "differs at step " << step;
+    ASSERT_EQ(
+      pooled.entity_manager.getCurrentAction("npc"),
+      constructed.entity_manager.getCurrentAction("npc"))
+      << "differs at step " << step;
+    ASSERT_EQ(
+      pooled.entity_manager.getBehaviorParameter("npc"),
+      constructed.entity_manager.getBehaviorParameter("npc"))
+      << "differs at step " << step;
+    ASSERT_EQ(
+      pooled.entity_manager.getTraveledDistance("npc"),
+      constructed.entity_manager.getTraveledDistance("npc"))
+      << "differs at step " << step;
+    pooled.update();
+    constructed.update();
+  }
+}
+
+/**
+ * @note Testcase for EntityManager::poolEntityOnDespawn.
+ * An entity spawned again with another behavior plugin than the one it was despawned with is
+ * supposed to be constructed from scratch instead of reusing the kept entity.
+ */
+TEST(EntityManager, EntityPoolOtherPlugin)
+{
+  Simulation simulation("entity_pool_other_plugin");
+  auto & entity_manager = simulation.entity_manager;
+  entity_manager.poolEntityOnDespawn("npc");
+  entity_manager.startNpcLogic();
+  entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+    "npc", simulation.canonicalize(34579, 20.0), getVehicleParameters());
+  entity_manager.requestSpeedChange("npc", 3.0, true);
+  for (int step = 0; step < 20; ++step) {
+    simulation.update();
+  }
+  ASSERT_NE(entity_manager.getCurrentAction("npc"), "do_nothing");
+  ASSERT_TRUE(entity_manager.despawnEntity("npc"));
+
+  entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+    "npc", simulation.canonicalize(34579, 20.0), getVehicleParameters(),
+    traffic_simulator::entity::VehicleEntity::BuiltinBehavior::doNothing());
+  EXPECT_EQ(entity_manager.getCurrentAction("npc"), "do_nothing");
+  const auto status =
+    static_cast<traffic_simulator::EntityStatus>(entity_manager.getEntityStatus("npc"));
+  for (int step = 0; step < 20; ++step) {
+    simulation.update();
+  }
+  EXPECT_EQ(
+    static_cast<traffic_simulator::EntityStatus>(entity_manager.getEntityStatus("npc")).pose,
+    status.pose);
+}
+
+/**
+ * @note Testcase for EntityManager::fillLaneletPoses.
+ * Statuses of vehicles with and without a route and of pedestrians on a crosswalk, moved off their
+ * lanelet pose, are supposed to be matched exactly as fillLaneletPose of each entity does.
+ */
+TEST(EntityManager, FillLaneletPoses)
+{
+  Simulation simulation("fill_lanelet_poses");
+  auto & entity_manager = simulation.entity_manager;
+  for (const auto & [name, lanelet_id, s] : {
+         std::make_tuple("npc1", 34579, 20.0),
+         std::make_tuple("npc2", 34579, 5.0),
+         std::make_tuple("npc3", 34606, 20.0),
+         std::make_tuple("npc4", 34468, 0.0),
+         std::make_tuple("npc5", 34513, 0.0),
+       }) {
+    entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+      name, simulation.canonicalize(lanelet_id, s), getVehicleParameters());
+  }
+  for (const auto & [name, s] : {
+         std::make_tuple("pedestrian1", 0.0),
+         std::make_tuple("pedestrian2", 3.0),
+       }) {
+    entity_manager.spawnEntity<traffic_simulator::entity::PedestrianEntity>(
+      name, simulation.canonicalize(34378, s), getPedestrianParameters());
+  }
+  entity_manager.requestAcquirePosition("npc1", simulation.canonicalize(34675, 0.0));
+  entity_manager.requestAcquirePosition("npc5", simulation.canonicalize(34630, 0.0));
+  entity_manager.startNpcLogic();
+  simulation.update();
+
+  for (const auto offset : {0.0, 0.5, 2.0, 50.0}) {
+    std::vector<std::pair<std::string, traffic_simulator::CanonicalizedEntityStatus>> batched;
+    for (const auto & name : entity_manager.getEntityNames()) {
+      auto status =
+        static_cast<traffic_simulator::EntityStatus>(entity_manager.getEntityStatus(name));
+      status.pose.position.x += offset;
+      status.pose.position.y += offset;
+      status.lanelet_pose_valid = false;
+      status.lanelet_pose = traffic_simulator::LaneletPose();
+      batched.emplace_back(
+        name, traffic_simulator::CanonicalizedEntityStatus(status, entity_manager.getHdmapUtils()));
+    }
+    auto individual = batched;
+    entity_manager.fillLaneletPoses(batched);
+    for (auto & [name, status] : individual) {
+      entity_manager.fillLaneletPose(name, status);
+    }
+    for (std::size_t i = 0; i < batched.size(); ++i) {
+      EXPECT_EQ(
+        static_cast<traffic_simulator::EntityStatus>(batched[i].second),
+        static_cast<traffic_simulator::EntityStatus>(individual[i].second))
+        << batched[i].first << " differs at offset " << offset;
+    }
+  }
+}
+
+/**
+ * @note Testcase for EntityManager::getCollidingEntities.
+ * Every pair of entities for which checkCollision holds is supposed to be returned exactly once.
+ */
+TEST(EntityManager, GetCollidingEntities)
+{
+  Simulation simulation("get_colliding_entities");
+  auto & entity_manager = simulation.entity_manager;
+  for (const auto & [name, lanelet_id, s] : {
+         std::make_tuple("npc1", 34579, 5.0),
+         std::make_tuple("npc2", 34579, 8.0),
+         std::make_tuple("npc3", 34579, 20.0),
+         std::make_tuple("npc4", 34606, 20.0),
+         std::make_tuple("npc5", 34468, 0.0),
+       }) {
+    entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+      name, simulation.canonicalize(lanelet_id, s), getVehicleParameters());
+  }
+  for (const auto & [name, s] : {
+         std::make_tuple("pedestrian1", 0.0),
+         std::make_tuple("pedestrian2", 0.5),
+         std::make_tuple("pedestrian3", 5.0),
+       }) {
+    entity_manager.spawnEntity<traffic_simulator::entity::PedestrianEntity>(
+      name, simulation.canonicalize(34378, s), getPedestrianParameters());
+  }
+
+  const auto sorted = [](const auto & name0, const auto & name1) {
+    return std::make_pair(std::min(name0, name1), std::max(name0, name1));
+  };
+  std::set<std::pair<std::string, std::string>> expected;
+  const auto names = entity_manager.getEntityNames();
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    for (std::size_t j = i + 1; j < names.size(); ++j) {
+      if (entity_manager.checkCollision(names[i], names[j])) {
+        expected.insert(sorted(names[i], names[j]));
+      }
+    }
+  }
+  EXPECT_EQ(expected.count({"npc1", "npc2"}), 1u);
+  EXPECT_EQ(expected.count({"pedestrian1", "pedestrian2"}), 1u);
+  EXPECT_EQ(expected.count({"npc2", "npc3"}), 0u);
+
+  std::set<std::pair<std::string, std::string>> colliding;
+  for (const auto & [name0, name1] : entity_manager.getCollidingEntities()) {
+    EXPECT_TRUE(colliding.insert(sorted(name0, name1)).second)
+      << name0 << " and " << name1 << " are returned twice";
+  }
+  EXPECT_EQ(colliding, expected);
+}
+
+/**
+ * @note Testcase for VehicleBehaviorTree::getTemplate and PedestrianBehaviorTree::getTemplate.
+ * Entities whose behavior trees are created from the same template are supposed to tick to the
+ * same action as a tree parsed for each entity did.
+ */
+TEST(EntityManager, BehaviorTreesFromSameTemplate)
+{
+  Simulation simulation("behavior_trees_from_same_template");
+  auto & entity_manager = simulation.entity_manager;
+  for (const auto & [name, lanelet_id] : {
+         std::make_tuple("npc1", 34579),
+         std::make_tuple("npc2", 34606),
+       }) {
+    entity_manager.spawnEntity<traffic_simulator::entity::VehicleEntity>(
+      name, simulation.canonicalize(lanelet_id, 10.0), getVehicleParameters());
+  }
+  for (const auto & [name, s] : {
+         std::make_tuple("pedestrian1", 0.0),
+         std::make_tuple("pedestrian2", 5.0),
+       }) {
+    entity_manager.spawnEntity<traffic_simulator::entity::PedestrianEntity>(
+      name, simulation.canonicalize(34378, s), getPedestrianParameters());
+  }
+  entity_manager.startNpcLogic();
+  simulation.update();
+  for (const auto & name : {"npc1", "npc2", "pedestrian1", "pedestrian2"}) {
+    EXPECT_EQ(entity_manager.getCurrentAction(name), "follow_lane") << name;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  const auto result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}
@@ -33,6 +33,10 @@ public:
    * @param logger logger for debug output, this argument exists for other BehaviorPlugin classes but are not used by this plugin.
    */
   void configure(const rclcpp::Logger & logger) override;
+  /**
+   * @brief nothing to halt in this plugin.
+   */
+  void reset() override;
   /**
    * @brief Get the Current Action object
    * @return const std::string& always return "do_nothing"
@@ -54,7 +58,7 @@ public:                                         \
   DEFINE_GETTER_SETTER(Obstacle,             std::optional<traffic_simulator_msgs::msg::Obstacle>)
   DEFINE_GETTER_SETTER(OtherEntityStatus,    EntityStatusDict)
   DEFINE_GETTER_SETTER(PedestrianParameters, traffic_simulator_msgs::msg::PedestrianParameters)
-  DEFINE_GETTER_SETTER(ReferenceTrajectory,  std::shared_ptr<math::geometry::CatmullRomSpline>)
+  DEFINE_GETTER_SETTER(ReferenceTrajectory,  std::shared_ptr<math::geometry::CatmullRomSplineInterface>)
   DEFINE_GETTER_SETTER(Request,              traffic_simulator::behavior::Request)
   DEFINE_GETTER_SETTER(RouteLanelets,        lanelet::Ids)
   DEFINE_GETTER_SETTER(TargetSpeed,          std::optional<double>)
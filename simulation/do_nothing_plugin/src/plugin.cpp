@@ -18,6 +18,8 @@ namespace entity_behavior
 {
 void DoNothingBehavior::configure(const rclcpp::Logger &) {}
 
+void DoNothingBehavior::reset() {}
+
 void DoNothingBehavior::update(double current_time, double)
 {
   entity_status_->setTime(current_time);
@@ -16,13 +16,17 @@
 #define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__RAYCASTER_HPP_
 
 #include <embree3/rtcore.h>
-#include <pcl_conversions/pcl_conversions.h>
+#include <embree3/rtcore_ray.h>
 #include <quaternion_operation/quaternion_operation.h>
 
+#include <Eigen/Core>
+#include <cstddef>
+#include <cstdint>
 #include <geometry_msgs/msg/pose.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
 #include <memory>
 #include <random>
+#include <rclcpp/time.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
 #include <simple_sensor_simulator/sensor_simulation/primitives/primitive.hpp>
@@ -48,6 +52,15 @@ public:
     auto primitive_ptr = std::make_unique<T>(std::forward<Ts>(xs)...);
     primitive_ptrs_.emplace(name, std::move(primitive_ptr));
   }
+  /**
+   * @brief Place the bounding box of an entity, adding it to the scene if it is not there yet.
+   * @note All boxes are instances of one shared unit box geometry, so updating a box only changes
+   *       the transform of its instance. A box which was not updated since the previous raycast is
+   *       removed from the scene by the next raycast.
+   */
+  void updateBox(
+    const std::string & name, float depth, float width, float height,
+    const geometry_msgs::msg::Pose & pose);
   const sensor_msgs::msg::PointCloud2 raycast(
     const std::string & frame_id, const rclcpp::Time & stamp,
     const geometry_msgs::msg::Pose & origin, double max_distance = 300, double min_distance = 0);
@@ -57,65 +70,51 @@ public:
     double horizontal_angle_start = 0, double horizontal_angle_end = 2 * M_PI);
 
 private:
-  std::vector<geometry_msgs::msg::Quaternion> getDirections(
-    const std::vector<double> & vertical_angles, double horizontal_angle_start,
-    double horizontal_angle_end, double horizontal_resolution);
-  std::vector<geometry_msgs::msg::Quaternion> directions_;
   double previous_horizontal_angle_start_;
   double previous_horizontal_angle_end_;
   double previous_horizontal_resolution_;
   std::vector<double> previous_vertical_angles_;
+  void addUnitBoxScene();
   std::unordered_map<std::string, std::unique_ptr<primitives::Primitive>> primitive_ptrs_;
+  struct Instance
+  {
+    RTCGeometry geometry;
+    unsigned int geometry_id;
+    bool updated;
+  };
+  std::unordered_map<std::string, Instance> instances_;
   RTCDevice device_;
   RTCScene scene_;
+  RTCScene unit_box_scene_;
   std::random_device seed_gen_;
   std::default_random_engine engine_;
   std::vector<std::string> detected_objects_;
   std::unordered_map<unsigned int, std::string> geometry_ids_;
-  std::vector<Eigen::Matrix3d> rotation_matrices_;
-
-  static void intersect(
-    int thread_id, int thread_count, RTCScene scene,
-    pcl::PointCloud<pcl::PointXYZI>::Ptr thread_cloud, RTCIntersectContext context,
-    geometry_msgs::msg::Pose origin,
-    std::reference_wrapper<std::set<unsigned int>> ref_thread_detected_ids, double max_distance,
-    double min_distance,
-    std::reference_wrapper<const std::vector<Eigen::Matrix3d>> ref_rotation_matrices)
+  // unit direction of each ray in the sensor frame, stored as structure of arrays
+  struct DirectionTable
   {
-    auto & rotation_matrices = ref_rotation_matrices.get();
-    auto & thread_detected_ids = ref_thread_detected_ids.get();
-    const auto orientation_matrix = quaternion_operation::getRotationMatrix(origin.orientation);
-    for (unsigned int i = thread_id; i < rotation_matrices.size(); i += thread_count) {
-      RTCRayHit rayhit = {};
-      rayhit.ray.org_x = origin.position.x;
-      rayhit.ray.org_y = origin.position.y;
-      rayhit.ray.org_z = origin.position.z;
-      // make raycast interact with all objects
-      rayhit.ray.mask = 0b11111111'11111111'11111111'11111111;
-      rayhit.ray.tfar = max_distance;
-      rayhit.ray.tnear = min_distance;
-      rayhit.ray.flags = false;
-
-      const auto rotation_mat = orientation_matrix * rotation_matrices.at(i);
-      rayhit.ray.dir_x = rotation_mat(0);
-      rayhit.ray.dir_y = rotation_mat(1);
-      rayhit.ray.dir_z = rotation_mat(2);
-      rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
-      rtcIntersect1(scene, &context, &rayhit);
-
-      if (rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID) {
-        double distance = rayhit.ray.tfar;
-        pcl::PointXYZI p;
-        {
-          p.x = rotation_matrices.at(i)(0) * distance;
-          p.y = rotation_matrices.at(i)(1) * distance;
-          p.z = rotation_matrices.at(i)(2) * distance;
-        }
-        thread_cloud->emplace_back(p);
-        thread_detected_ids.insert(rayhit.hit.geomID);
-      }
-    }
-  }
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    auto size() const noexcept { return x.size(); }
+  };
+  DirectionTable ray_directions_;
+  // rays are traced in packets by rtcIntersect16, several packets make one task of the thread pool
+  static constexpr std::size_t packet_size = 16;
+  static constexpr std::size_t packets_per_task = 64;
+  // x, y, z and intensity of a point, each float32, laid out like pcl::PointXYZI is (padded to 32
+  // bytes, intensity at byte 16) so that the published PointCloud2 keeps its format
+  static constexpr std::size_t point_step = 8 * sizeof(float);
+  static constexpr std::uint32_t intensity_offset = 4 * sizeof(float);
+  /// @note Kept across scans, so it is neither allocated nor zero filled for every scan.
+  std::vector<std::uint8_t> task_points_;
+  std::vector<std::size_t> task_point_counts_;
+  std::vector<std::vector<unsigned int>> task_detected_ids_;
+  // writes hit points to task_data and returns the number of them
+  std::size_t intersect(
+    std::size_t task, const geometry_msgs::msg::Pose & origin, const Eigen::Matrix3f & orientation,
+    double max_distance, double min_distance, std::uint8_t * task_data,
+    std::vector<unsigned int> & task_detected_ids) const;
 };
 }  // namespace simple_sensor_simulator
 
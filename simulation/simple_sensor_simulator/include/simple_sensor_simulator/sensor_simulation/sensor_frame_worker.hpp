@@ -0,0 +1,65 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__SENSOR_FRAME_WORKER_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__SENSOR_FRAME_WORKER_HPP_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace simple_sensor_simulator
+{
+/**
+ * @brief Thread running the sensor frames posted to it one at a time, behind the caller.
+ * @note The thread is started once and reused by every frame.
+ */
+class SensorFrameWorker
+{
+public:
+  SensorFrameWorker();
+
+  /// @note Runs the frame posted last, if any, before the thread stops.
+  ~SensorFrameWorker();
+
+  SensorFrameWorker(const SensorFrameWorker &) = delete;
+
+  auto operator=(const SensorFrameWorker &) -> SensorFrameWorker & = delete;
+
+  /// @brief Wait for the frame posted previously, then run frame on the worker thread.
+  auto post(std::function<void()> frame) -> void;
+
+  /// @brief Wait for the frame posted last and rethrow the exception it threw, if any.
+  auto wait() -> void;
+
+private:
+  auto work() -> void;
+
+  std::mutex mutex_;
+
+  std::condition_variable condition_;
+
+  std::function<void()> frame_;
+
+  std::exception_ptr exception_;
+
+  bool stopped_ = false;
+
+  std::thread thread_;
+};
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__SENSOR_FRAME_WORKER_HPP_
@@ -0,0 +1,68 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__TRAFFIC_LIGHTS__TRAFFIC_SIGNALS_STATES_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__TRAFFIC_LIGHTS__TRAFFIC_SIGNALS_STATES_HPP_
+
+#include <simulation_api_schema.pb.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace simple_sensor_simulator
+{
+namespace traffic_lights
+{
+/** @brief States of every traffic signal, as sent by the last UpdateTrafficLightsRequests
+ * A full request (a keyframe) replaces all of the states, while a delta request only replaces or
+ * adds the traffic signals it contains and the others keep their state.
+ */
+class TrafficSignalsStates
+{
+  simulation_api_schema::UpdateTrafficLightsRequest states_;
+
+  /// @note Index of each traffic signal id in states_, so that a delta is merged in O(1) per signal
+  std::unordered_map<std::int32_t, int> indices_;
+
+public:
+  auto update(const simulation_api_schema::UpdateTrafficLightsRequest & request) -> void
+  {
+    if (request.delta()) {
+      for (const auto & state : request.states()) {
+        if (const auto iter = indices_.find(state.id()); iter != indices_.end()) {
+          *states_.mutable_states(iter->second) = state;
+        } else {
+          indices_.emplace(state.id(), states_.states_size());
+          *states_.add_states() = state;
+        }
+      }
+    } else {
+      states_ = request;
+      indices_.clear();
+      for (int i = 0; i < request.states_size(); ++i) {
+        indices_.emplace(request.states(i).id(), i);
+      }
+    }
+  }
+
+  /// @note Never a delta, states lists every traffic signal known so far.
+  auto get() const noexcept -> const simulation_api_schema::UpdateTrafficLightsRequest &
+  {
+    return states_;
+  }
+};
+}  // namespace traffic_lights
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__TRAFFIC_LIGHTS__TRAFFIC_SIGNALS_STATES_HPP_
@@ -18,6 +18,7 @@
 #include <tf2/LinearMath/Quaternion.h>
 #include <tf2_ros/transform_broadcaster.h>
 
+#include <cstdint>
 #include <geographic_msgs/msg/geo_point.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <geometry_msgs/msg/transform_stamped.hpp>
@@ -26,12 +27,15 @@
 #include <rclcpp/rclcpp.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <simple_sensor_simulator/sensor_simulation/sensor_frame_worker.hpp>
 #include <simple_sensor_simulator/sensor_simulation/sensor_simulation.hpp>
+#include <simple_sensor_simulator/sensor_simulation/traffic_lights/traffic_signals_states.hpp>
 #include <simple_sensor_simulator/vehicle_simulation/ego_entity_simulation.hpp>
 #include <simulation_interface/zmq_multi_server.hpp>
 #include <string>
 #include <thread>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <unordered_map>
 #include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
 
@@ -90,15 +94,30 @@ public:
 private:
   SensorSimulation sensor_sim_;
 
+  /// @note Runs the sensor simulation of updateFrame with overlap_sensor_simulation.
+  SensorFrameWorker sensor_frame_worker_;
+
   auto initialize(const simulation_api_schema::InitializeRequest &)
     -> simulation_api_schema::InitializeResponse;
 
   auto updateFrame(const simulation_api_schema::UpdateFrameRequest &)
     -> simulation_api_schema::UpdateFrameResponse;
 
+  auto updateFrame(
+    const simulation_api_schema::UpdateFrameRequest &, bool overlap_sensor_simulation)
+    -> simulation_api_schema::UpdateFrameResponse;
+
+  /// @brief Wait for the sensor simulation left running by updateFrame, if any.
+  auto waitForSensorFrame() -> void;
+
+  auto frame(const simulation_api_schema::FrameRequest &) -> simulation_api_schema::FrameResponse;
+
   auto updateEntityStatus(const simulation_api_schema::UpdateEntityStatusRequest &)
     -> simulation_api_schema::UpdateEntityStatusResponse;
 
+  auto updateEntityStatusDelta(const simulation_api_schema::UpdateEntityStatusDeltaRequest &)
+    -> simulation_api_schema::UpdateEntityStatusDeltaResponse;
+
   auto spawnVehicleEntity(const simulation_api_schema::SpawnVehicleEntityRequest &)
     -> simulation_api_schema::SpawnVehicleEntityResponse;
 
@@ -147,7 +166,8 @@ private:
   rclcpp::Time current_ros_time_;
   bool initialized_;
   std::map<std::string, simulation_api_schema::EntityStatus> entity_status_;
-  simulation_api_schema::UpdateTrafficLightsRequest traffic_signals_states_;
+  std::unordered_map<std::uint32_t, std::string> entity_handles_;
+  traffic_lights::TrafficSignalsStates traffic_signals_states_;
   traffic_simulator_msgs::BoundingBox getBoundingBox(const std::string & name);
   zeromq::MultiServer server_;
   geographic_msgs::msg::GeoPoint getOrigin();
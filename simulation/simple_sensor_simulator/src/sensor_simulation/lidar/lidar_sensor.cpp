@@ -47,7 +47,7 @@ auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
       pose.position.x = pose.position.x + center.x();
       pose.position.y = pose.position.y + center.y();
       pose.position.z = pose.position.z + center.z();
-      raycaster_.addPrimitive<simple_sensor_simulator::primitives::Box>(
+      raycaster_.updateBox(
         entity.name(),                           //
         entity.bounding_box().dimensions().x(),  //
         entity.bounding_box().dimensions().y(),  //
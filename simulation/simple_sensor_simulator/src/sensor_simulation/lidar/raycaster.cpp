@@ -15,10 +15,16 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <numeric>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <set>
 #include <string>
+#include <thread>
+#include <traffic_simulator/helper/thread_pool.hpp>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -31,6 +37,7 @@ Raycaster::Raycaster()
   scene_(rtcNewScene(device_)),
   engine_(seed_gen_())
 {
+  addUnitBoxScene();
 }
 
 Raycaster::Raycaster(std::string embree_config)
@@ -39,14 +46,61 @@ Raycaster::Raycaster(std::string embree_config)
   scene_(rtcNewScene(device_)),
   engine_(seed_gen_())
 {
+  addUnitBoxScene();
 }
 
 Raycaster::~Raycaster()
 {
+  for (const auto & instance : instances_) {
+    rtcReleaseGeometry(instance.second.geometry);
+  }
   rtcReleaseScene(scene_);
+  rtcReleaseScene(unit_box_scene_);
   rtcReleaseDevice(device_);
 }
 
+void Raycaster::addUnitBoxScene()
+{
+  /// @note the top level scene only holds instances which move every frame
+  rtcSetSceneFlags(scene_, RTC_SCENE_FLAG_DYNAMIC);
+  rtcSetSceneBuildQuality(scene_, RTC_BUILD_QUALITY_LOW);
+  unit_box_scene_ = rtcNewScene(device_);
+  primitives::Box(1, 1, 1, geometry_msgs::msg::Pose()).addToScene(device_, unit_box_scene_);
+  rtcCommitScene(unit_box_scene_);
+}
+
+void Raycaster::updateBox(
+  const std::string & name, float depth, float width, float height,
+  const geometry_msgs::msg::Pose & pose)
+{
+  auto instance = instances_.find(name);
+  if (instance == instances_.end()) {
+    if (primitive_ptrs_.count(name) != 0) {
+      throw std::runtime_error("primitive " + name + " already exist.");
+    }
+    const auto geometry = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_INSTANCE);
+    rtcSetGeometryInstancedScene(geometry, unit_box_scene_);
+    // enable raycasting
+    rtcSetGeometryMask(geometry, 0b11111111'11111111'11111111'11111111);
+    const auto geometry_id = rtcAttachGeometry(scene_, geometry);
+    geometry_ids_.insert({geometry_id, name});
+    instance = instances_.emplace(name, Instance{geometry, geometry_id, false}).first;
+  }
+  const auto rotation = quaternion_operation::getRotationMatrix(pose.orientation);
+  // column major 3x4 affine transform which scales the unit box and then places it at pose
+  const float transform[12] = {
+    static_cast<float>(rotation(0, 0) * depth),  static_cast<float>(rotation(1, 0) * depth),
+    static_cast<float>(rotation(2, 0) * depth),  static_cast<float>(rotation(0, 1) * width),
+    static_cast<float>(rotation(1, 1) * width),  static_cast<float>(rotation(2, 1) * width),
+    static_cast<float>(rotation(0, 2) * height), static_cast<float>(rotation(1, 2) * height),
+    static_cast<float>(rotation(2, 2) * height), static_cast<float>(pose.position.x),
+    static_cast<float>(pose.position.y),         static_cast<float>(pose.position.z)};
+  rtcSetGeometryTransform(
+    instance->second.geometry, 0, RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR, transform);
+  rtcCommitGeometry(instance->second.geometry);
+  instance->second.updated = true;
+}
+
 void Raycaster::setDirection(
   const simulation_api_schema::LidarConfiguration & configuration, double horizontal_angle_start,
   double horizontal_angle_end)
@@ -55,45 +109,87 @@ void Raycaster::setDirection(
   for (const auto v : configuration.vertical_angles()) {
     vertical_angles.emplace_back(v);
   }
-
-  auto quat_directions = getDirections(
-    vertical_angles, horizontal_angle_start, horizontal_angle_end,
-    configuration.horizontal_resolution());
-  rotation_matrices_.clear();
-  for (const auto & q : quat_directions) {
-    rotation_matrices_.push_back(quaternion_operation::getRotationMatrix(q));
-  }
-}
-
-std::vector<geometry_msgs::msg::Quaternion> Raycaster::getDirections(
-  const std::vector<double> & vertical_angles, double horizontal_angle_start,
-  double horizontal_angle_end, double horizontal_resolution)
-{
+  const auto horizontal_resolution = configuration.horizontal_resolution();
   if (
-    directions_.empty() || previous_horizontal_angle_start_ != horizontal_angle_start ||
+    ray_directions_.size() == 0 || previous_horizontal_angle_start_ != horizontal_angle_start ||
     previous_horizontal_angle_end_ != horizontal_angle_end ||
     previous_horizontal_resolution_ != horizontal_resolution ||
     previous_vertical_angles_ != vertical_angles) {
-    std::vector<geometry_msgs::msg::Quaternion> directions;
+    ray_directions_ = {};
     double horizontal_angle = horizontal_angle_start;
     while (horizontal_angle <= horizontal_angle_end) {
       horizontal_angle = horizontal_angle + horizontal_resolution;
       for (const auto vertical_angle : vertical_angles) {
-        geometry_msgs::msg::Vector3 rpy;
-        rpy.x = 0;
-        rpy.y = vertical_angle;
-        rpy.z = horizontal_angle;
-        auto quat = quaternion_operation::convertEulerAngleToQuaternion(rpy);
-        directions.emplace_back(quat);
+        // x axis of the frame rotated by roll 0, pitch vertical_angle and yaw horizontal_angle
+        ray_directions_.x.push_back(std::cos(vertical_angle) * std::cos(horizontal_angle));
+        ray_directions_.y.push_back(std::cos(vertical_angle) * std::sin(horizontal_angle));
+        ray_directions_.z.push_back(-std::sin(vertical_angle));
       }
     }
-    directions_ = directions;
     previous_horizontal_angle_end_ = horizontal_angle_end;
     previous_horizontal_angle_start_ = horizontal_angle_start;
     previous_horizontal_resolution_ = horizontal_resolution;
     previous_vertical_angles_ = vertical_angles;
   }
-  return directions_;
+}
+
+std::size_t Raycaster::intersect(
+  std::size_t task, const geometry_msgs::msg::Pose & origin, const Eigen::Matrix3f & orientation,
+  double max_distance, double min_distance, std::uint8_t * task_data,
+  std::vector<unsigned int> & task_detected_ids) const
+{
+  RTCIntersectContext context;
+  rtcInitIntersectContext(&context);
+  // rays of one scan fan out from the same origin, so rays next to each other are coherent
+  context.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
+  std::size_t point_count = 0;
+  const auto first = task * packets_per_task * packet_size;
+  const auto last = std::min(first + packets_per_task * packet_size, ray_directions_.size());
+  for (auto begin = first; begin < last; begin += packet_size) {
+    const auto count = std::min(packet_size, last - begin);
+    alignas(64) int valid[packet_size];
+    alignas(64) RTCRayHit16 rayhit;
+    for (std::size_t i = 0; i < packet_size; ++i) {
+      const auto j = begin + std::min(i, count - 1);
+      valid[i] = i < count ? -1 : 0;
+      rayhit.ray.org_x[i] = origin.position.x;
+      rayhit.ray.org_y[i] = origin.position.y;
+      rayhit.ray.org_z[i] = origin.position.z;
+      rayhit.ray.dir_x[i] = orientation(0, 0) * ray_directions_.x[j] +
+                            orientation(0, 1) * ray_directions_.y[j] +
+                            orientation(0, 2) * ray_directions_.z[j];
+      rayhit.ray.dir_y[i] = orientation(1, 0) * ray_directions_.x[j] +
+                            orientation(1, 1) * ray_directions_.y[j] +
+                            orientation(1, 2) * ray_directions_.z[j];
+      rayhit.ray.dir_z[i] = orientation(2, 0) * ray_directions_.x[j] +
+                            orientation(2, 1) * ray_directions_.y[j] +
+                            orientation(2, 2) * ray_directions_.z[j];
+      rayhit.ray.tnear[i] = min_distance;
+      rayhit.ray.tfar[i] = max_distance;
+      rayhit.ray.time[i] = 0;
+      // make raycast interact with all objects
+      rayhit.ray.mask[i] = 0b11111111'11111111'11111111'11111111;
+      rayhit.ray.id[i] = i;
+      rayhit.ray.flags[i] = 0;
+      rayhit.hit.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+      rayhit.hit.instID[0][i] = RTC_INVALID_GEOMETRY_ID;
+    }
+    rtcIntersect16(valid, scene_, &context, &rayhit);
+    for (std::size_t i = 0; i < count; ++i) {
+      if (rayhit.hit.geomID[i] != RTC_INVALID_GEOMETRY_ID) {
+        const auto distance = rayhit.ray.tfar[i];
+        const float point[point_step / sizeof(float)] = {
+          ray_directions_.x[begin + i] * distance, ray_directions_.y[begin + i] * distance,
+          ray_directions_.z[begin + i] * distance};
+        std::memcpy(task_data + point_count++ * point_step, point, point_step);
+        // boxes of entities are instances, their id in scene is instID, not geomID
+        task_detected_ids.push_back(
+          rayhit.hit.instID[0][i] != RTC_INVALID_GEOMETRY_ID ? rayhit.hit.instID[0][i]
+                                                             : rayhit.hit.geomID[i]);
+      }
+    }
+  }
+  return point_count;
 }
 
 const std::vector<std::string> & Raycaster::getDetectedObject() const { return detected_objects_; }
@@ -103,48 +199,86 @@ const sensor_msgs::msg::PointCloud2 Raycaster::raycast(
   double max_distance, double min_distance)
 {
   detected_objects_ = {};
-  pcl::PointCloud<pcl::PointXYZI>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZI>());
+  for (auto instance = instances_.begin(); instance != instances_.end();) {
+    if (instance->second.updated) {
+      instance->second.updated = false;
+      ++instance;
+    } else {
+      rtcDetachGeometry(scene_, instance->second.geometry_id);
+      rtcReleaseGeometry(instance->second.geometry);
+      geometry_ids_.erase(instance->second.geometry_id);
+      instance = instances_.erase(instance);
+    }
+  }
+  std::vector<unsigned int> primitive_ids;
   for (auto & pair : primitive_ptrs_) {
     auto id = pair.second->addToScene(device_, scene_);
     geometry_ids_.insert({id, pair.first});
+    primitive_ids.push_back(id);
   }
 
   // Run as many threads as physical cores (which is usually /2 virtual threads)
   // In heavy loads virtual threads (hyper-threading) add little to the overall performance
-  // This also minimizes cost of creating a thread (roughly 10us on Intel/Linux)
-  int thread_count = std::thread::hardware_concurrency() / 2;
-  // Per thread data structures:
-  std::vector<std::thread> threads(thread_count);
-  std::vector<std::set<unsigned int>> thread_detected_ids(thread_count);
-  std::vector<pcl::PointCloud<pcl::PointXYZI>::Ptr> thread_cloud(thread_count);
-
-  rtcCommitScene(scene_);
-  RTCIntersectContext context;
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    thread_cloud[i] = pcl::PointCloud<pcl::PointXYZI>::Ptr(new pcl::PointCloud<pcl::PointXYZI>());
-    threads[i] = std::thread(
-      intersect, i, thread_count, scene_, thread_cloud[i], context, origin,
-      std::ref(thread_detected_ids[i]), max_distance, min_distance, std::ref(rotation_matrices_));
+  // The pool is created once, so no thread is created per scan (roughly 10us on Intel/Linux)
+  static traffic_simulator::helper::ThreadPool thread_pool(
+    std::max(1u, std::thread::hardware_concurrency() / 2) - 1);
+  // Every task owns a slice of task_points_ large enough for all of its rays, hits are copied to
+  // the message in task order afterwards so the output is deterministic
+  const auto task_size = packets_per_task * packet_size;
+  const auto task_count = (ray_directions_.size() + task_size - 1) / task_size;
+  task_point_counts_.assign(task_count, 0);
+  task_detected_ids_.resize(task_count);
+  for (auto & detected_ids : task_detected_ids_) {
+    detected_ids.clear();
   }
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-    (*cloud) += *(thread_cloud[i]);
+  sensor_msgs::msg::PointCloud2 pointcloud_msg;
+  for (const auto & [name, offset] :
+       {std::make_pair("x", 0u), std::make_pair("y", 4u), std::make_pair("z", 8u),
+        std::make_pair("intensity", intensity_offset)}) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = offset;
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    pointcloud_msg.fields.push_back(field);
   }
-  for (auto && detected_ids_in_thread : thread_detected_ids) {
-    for (const auto & id : detected_ids_in_thread) {
-      detected_objects_.emplace_back(geometry_ids_[id]);
-    }
+  pointcloud_msg.point_step = point_step;
+  if (task_points_.size() < ray_directions_.size() * point_step) {
+    task_points_.resize(ray_directions_.size() * point_step);
   }
 
-  for (const auto & id : geometry_ids_) {
-    rtcDetachGeometry(scene_, id.first);
+  rtcCommitScene(scene_);
+  const Eigen::Matrix3f orientation =
+    quaternion_operation::getRotationMatrix(origin.orientation).cast<float>();
+  thread_pool.parallelFor(task_count, [&](std::size_t task) {
+    task_point_counts_[task] = intersect(
+      task, origin, orientation, max_distance, min_distance,
+      task_points_.data() + task * task_size * point_step, task_detected_ids_[task]);
+  });
+  const auto point_count =
+    std::accumulate(task_point_counts_.begin(), task_point_counts_.end(), std::size_t(0));
+  pointcloud_msg.data.reserve(point_count * point_step);
+  std::set<unsigned int> detected_ids;
+  for (std::size_t task = 0; task < task_count; ++task) {
+    const auto task_points = task_points_.begin() + task * task_size * point_step;
+    pointcloud_msg.data.insert(
+      pointcloud_msg.data.end(), task_points, task_points + task_point_counts_[task] * point_step);
+    detected_ids.insert(task_detected_ids_[task].begin(), task_detected_ids_[task].end());
+  }
+  pointcloud_msg.height = 1;
+  pointcloud_msg.width = point_count;
+  pointcloud_msg.row_step = point_count * point_step;
+  pointcloud_msg.is_dense = true;
+  for (const auto & id : detected_ids) {
+    detected_objects_.emplace_back(geometry_ids_[id]);
   }
 
-  geometry_ids_.clear();
+  for (const auto id : primitive_ids) {
+    rtcDetachGeometry(scene_, id);
+    geometry_ids_.erase(id);
+  }
   primitive_ptrs_.clear();
 
-  sensor_msgs::msg::PointCloud2 pointcloud_msg;
-  pcl::toROSMsg(*cloud, pointcloud_msg);
   pointcloud_msg.header.frame_id = frame_id;
   pointcloud_msg.header.stamp = stamp;
   return pointcloud_msg;
@@ -0,0 +1,72 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <simple_sensor_simulator/sensor_simulation/sensor_frame_worker.hpp>
+#include <utility>
+
+namespace simple_sensor_simulator
+{
+SensorFrameWorker::SensorFrameWorker() : thread_([this]() { work(); }) {}
+
+SensorFrameWorker::~SensorFrameWorker()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+}
+
+auto SensorFrameWorker::post(std::function<void()> frame) -> void
+{
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frame_ = std::move(frame);
+  }
+  condition_.notify_all();
+}
+
+auto SensorFrameWorker::wait() -> void
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait(lock, [this]() { return not frame_; });
+  if (exception_) {
+    std::rethrow_exception(std::exchange(exception_, nullptr));
+  }
+}
+
+auto SensorFrameWorker::work() -> void
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this]() { return stopped_ or frame_; });
+    if (not frame_) {
+      return;
+    }
+    lock.unlock();
+    std::exception_ptr exception = nullptr;
+    try {
+      frame_();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    lock.lock();
+    exception_ = exception;
+    frame_ = nullptr;
+    condition_.notify_all();
+  }
+}
+}  // namespace simple_sensor_simulator
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <frame_profiler/frame_profiler.hpp>
 #include <memory>
 #include <simple_sensor_simulator/sensor_simulation/sensor_simulation.hpp>
 #include <string>
@@ -24,6 +25,8 @@ auto SensorSimulation::updateSensorFrame(
   const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
   const simulation_api_schema::UpdateTrafficLightsRequest & update_traffic_lights_request) -> void
 {
+  FRAME_PROFILER_ZONE("SensorSimulation::updateSensorFrame");
+
   std::vector<std::string> lidar_detected_objects = {};
 
   for (auto & sensor : lidar_sensors_) {
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <geometry_msgs/msg/pose_stamped.hpp>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
@@ -23,6 +24,7 @@
 #include <simple_sensor_simulator/exception.hpp>
 #include <simple_sensor_simulator/simple_sensor_simulator.hpp>
 #include <simulation_interface/conversions.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
 #include <string>
 #include <utility>
 #include <vector>
@@ -47,7 +49,9 @@ ScenarioSimulator::ScenarioSimulator(const rclcpp::NodeOptions & options)
     [this](auto &&... xs) { return followPolylineTrajectory(std::forward<decltype(xs)>(xs)...); },
     [this](auto &&... xs) {
       return attachPseudoTrafficLightDetector(std::forward<decltype(xs)>(xs)...);
-    })
+    },
+    [this](auto &&... xs) { return updateEntityStatusDelta(std::forward<decltype(xs)>(xs)...); },
+    [this](auto &&... xs) { return frame(std::forward<decltype(xs)>(xs)...); })
 {
 }
 
@@ -68,7 +72,7 @@ geographic_msgs::msg::GeoPoint ScenarioSimulator::getOrigin()
   return origin;
 }
 
-ScenarioSimulator::~ScenarioSimulator() {}
+ScenarioSimulator::~ScenarioSimulator() { waitForSensorFrame(); }
 
 int ScenarioSimulator::getSocketPort()
 {
@@ -79,6 +83,7 @@ int ScenarioSimulator::getSocketPort()
 auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeRequest & req)
   -> simulation_api_schema::InitializeResponse
 {
+  waitForSensorFrame();
   initialized_ = true;
   realtime_factor_ = req.realtime_factor();
   step_time_ = req.step_time();
@@ -96,11 +101,19 @@ auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeReques
   pedestrians_.clear();
   misc_objects_.clear();
   entity_status_.clear();
+  entity_handles_.clear();
   return res;
 }
 
 auto ScenarioSimulator::updateFrame(const simulation_api_schema::UpdateFrameRequest & req)
   -> simulation_api_schema::UpdateFrameResponse
+{
+  return updateFrame(req, false);
+}
+
+auto ScenarioSimulator::updateFrame(
+  const simulation_api_schema::UpdateFrameRequest & req, bool overlap_sensor_simulation)
+  -> simulation_api_schema::UpdateFrameResponse
 {
   auto res = simulation_api_schema::UpdateFrameResponse();
   if (!initialized_) {
@@ -108,6 +121,7 @@ auto ScenarioSimulator::updateFrame(const simulation_api_schema::UpdateFrameRequ
     res.mutable_result()->set_success(false);
     return res;
   }
+  waitForSensorFrame();
   current_simulation_time_ = req.current_simulation_time();
   current_scenario_time_ = req.current_scenario_time();
   builtin_interfaces::msg::Time t;
@@ -126,13 +140,44 @@ auto ScenarioSimulator::updateFrame(const simulation_api_schema::UpdateFrameRequ
       *status.mutable_bounding_box() = getBoundingBox(status.name());
       return status;
     });
-  sensor_sim_.updateSensorFrame(
-    current_simulation_time_, current_ros_time_, entity_status, traffic_signals_states_);
+  if (overlap_sensor_simulation) {
+    /// @note the sensors only see copies, so requests handled in the meantime do not race with them
+    sensor_frame_worker_.post(
+      [this, entity_status = std::move(entity_status), time = current_simulation_time_,
+       ros_time = current_ros_time_, traffic_lights = traffic_signals_states_.get()]() {
+        sensor_sim_.updateSensorFrame(time, ros_time, entity_status, traffic_lights);
+      });
+  } else {
+    sensor_sim_.updateSensorFrame(
+      current_simulation_time_, current_ros_time_, entity_status, traffic_signals_states_.get());
+  }
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("succeed to update frame");
   return res;
 }
 
+auto ScenarioSimulator::waitForSensorFrame() -> void { sensor_frame_worker_.wait(); }
+
+auto ScenarioSimulator::frame(const simulation_api_schema::FrameRequest & req)
+  -> simulation_api_schema::FrameResponse
+{
+  auto res = simulation_api_schema::FrameResponse();
+  if (req.has_update_traffic_lights()) {
+    *res.mutable_update_traffic_lights() = updateTrafficLights(req.update_traffic_lights());
+  }
+  if (req.has_update_frame()) {
+    *res.mutable_update_frame() = updateFrame(req.update_frame(), req.overlap_sensor_simulation());
+  }
+  if (req.has_update_entity_status()) {
+    *res.mutable_update_entity_status() = updateEntityStatus(req.update_entity_status());
+  }
+  if (req.has_update_entity_status_delta()) {
+    *res.mutable_update_entity_status_delta() =
+      updateEntityStatusDelta(req.update_entity_status_delta());
+  }
+  return res;
+}
+
 auto ScenarioSimulator::updateEntityStatus(
   const simulation_api_schema::UpdateEntityStatusRequest & req)
   -> simulation_api_schema::UpdateEntityStatusResponse
@@ -169,6 +214,32 @@ auto ScenarioSimulator::updateEntityStatus(
   return res;
 }
 
+auto ScenarioSimulator::updateEntityStatusDelta(
+  const simulation_api_schema::UpdateEntityStatusDeltaRequest & req)
+  -> simulation_api_schema::UpdateEntityStatusDeltaResponse
+{
+  auto res = simulation_api_schema::UpdateEntityStatusDeltaResponse();
+  simulation_interface::applyEntityStatusDelta(
+    req, entity_handles_, entity_status_, [&](auto & status) {
+      if (not isEgo(status.name())) {
+        return false;
+      }
+      assert(ego_entity_simulation_ && "Ego is spawned but ego_entity_simulation_ is nullptr!");
+      ego_entity_simulation_->update(
+        current_scenario_time_ + step_time_, step_time_, req.npc_logic_started());
+      simulation_interface::toProto(ego_entity_simulation_->getStatus(), status);
+      /// @note only the entities simulated here are sent back, the others are already up to date
+      auto updated_status = res.add_status();
+      updated_status->set_name(status.name());
+      updated_status->mutable_action_status()->CopyFrom(status.action_status());
+      updated_status->mutable_pose()->CopyFrom(status.pose());
+      return true;
+    });
+  res.mutable_result()->set_success(true);
+  res.mutable_result()->set_description("");
+  return res;
+}
+
 template <typename SpawnRequestType>
 auto ScenarioSimulator::insertEntitySpawnedStatus(
   const SpawnRequestType & spawn_request, const traffic_simulator_msgs::EntityType::Enum & type,
@@ -182,6 +253,9 @@ auto ScenarioSimulator::insertEntitySpawnedStatus(
   init_status.mutable_action_status()->set_current_action("initializing");
   init_status.mutable_pose()->CopyFrom(spawn_request.pose());
   entity_status_.insert({spawn_request.parameters().name(), init_status});
+  if (spawn_request.handle() != 0) {
+    entity_handles_[spawn_request.handle()] = spawn_request.parameters().name();
+  }
 }
 
 auto ScenarioSimulator::spawnVehicleEntity(
@@ -265,6 +339,9 @@ auto ScenarioSimulator::despawnEntity(const simulation_api_schema::DespawnEntity
                                       remove_despawn_requested_entity_from(misc_objects_);
   if (any_entity_was_removed) {
     entity_status_.erase(req.name());
+    for (auto iter = entity_handles_.begin(); iter != entity_handles_.end();) {
+      iter = iter->second == req.name() ? entity_handles_.erase(iter) : std::next(iter);
+    }
   }
   auto res = simulation_api_schema::DespawnEntityResponse();
   res.mutable_result()->set_success(any_entity_was_removed);
@@ -275,6 +352,7 @@ auto ScenarioSimulator::attachDetectionSensor(
   const simulation_api_schema::AttachDetectionSensorRequest & req)
   -> simulation_api_schema::AttachDetectionSensorResponse
 {
+  waitForSensorFrame();
   sensor_sim_.attachDetectionSensor(current_simulation_time_, req.configuration(), *this);
   auto res = simulation_api_schema::AttachDetectionSensorResponse();
   res.mutable_result()->set_success(true);
@@ -285,6 +363,7 @@ auto ScenarioSimulator::attachLidarSensor(
   const simulation_api_schema::AttachLidarSensorRequest & req)
   -> simulation_api_schema::AttachLidarSensorResponse
 {
+  waitForSensorFrame();
   sensor_sim_.attachLidarSensor(current_simulation_time_, req.configuration(), *this);
   auto res = simulation_api_schema::AttachLidarSensorResponse();
   res.mutable_result()->set_success(true);
@@ -296,6 +375,7 @@ auto ScenarioSimulator::attachOccupancyGridSensor(
   -> simulation_api_schema::AttachOccupancyGridSensorResponse
 {
   auto res = simulation_api_schema::AttachOccupancyGridSensorResponse();
+  waitForSensorFrame();
   sensor_sim_.attachOccupancyGridSensor(current_simulation_time_, req.configuration(), *this);
   res.mutable_result()->set_success(true);
   return res;
@@ -305,7 +385,7 @@ auto ScenarioSimulator::updateTrafficLights(
   const simulation_api_schema::UpdateTrafficLightsRequest & req)
   -> simulation_api_schema::UpdateTrafficLightsResponse
 {
-  traffic_signals_states_ = req;
+  traffic_signals_states_.update(req);
   auto res = simulation_api_schema::UpdateTrafficLightsResponse();
   res.mutable_result()->set_success(true);
   return res;
@@ -331,6 +411,7 @@ auto ScenarioSimulator::attachPseudoTrafficLightDetector(
   -> simulation_api_schema::AttachPseudoTrafficLightDetectorResponse
 {
   auto response = simulation_api_schema::AttachPseudoTrafficLightDetectorResponse();
+  waitForSensorFrame();
   sensor_sim_.attachPseudoTrafficLightsDetector(
     current_simulation_time_, req.configuration(), *this, hdmap_utils_);
   response.mutable_result()->set_success(true);
@@ -0,0 +1,148 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <geometry_msgs/msg/pose.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/msg/point_field.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <simulation_api_schema.pb.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+using simple_sensor_simulator::Raycaster;
+
+namespace
+{
+auto makeConfiguration() -> simulation_api_schema::LidarConfiguration
+{
+  simulation_api_schema::LidarConfiguration configuration;
+  configuration.set_horizontal_resolution(M_PI / 180);
+  configuration.add_vertical_angles(0);
+  return configuration;
+}
+
+auto makePose(double x, double y, double z) -> geometry_msgs::msg::Pose
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.position.z = z;
+  return pose;
+}
+
+/// @note Count the horizontal rays of makeConfiguration() which hit the face x = distance, |y| < 1
+auto countRaysHittingFace(double distance) -> std::size_t
+{
+  std::size_t count = 0;
+  for (double angle = 0; angle <= 2 * M_PI;) {
+    angle += M_PI / 180;
+    if (std::cos(angle) > 0 && std::abs(distance * std::tan(angle)) < 1) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+auto readFloat(const sensor_msgs::msg::PointCloud2 & cloud, std::size_t point, std::size_t offset)
+  -> float
+{
+  float value;
+  std::memcpy(&value, cloud.data.data() + point * cloud.point_step + offset, sizeof(float));
+  return value;
+}
+
+auto expectPointsOnFace(const sensor_msgs::msg::PointCloud2 & cloud, float distance) -> void
+{
+  for (std::size_t point = 0; point < cloud.width; ++point) {
+    EXPECT_NEAR(readFloat(cloud, point, 0), distance, 1e-3);
+    EXPECT_LT(std::abs(readFloat(cloud, point, 4)), 1.0f);
+    EXPECT_NEAR(readFloat(cloud, point, 8), 0, 1e-3);
+    EXPECT_EQ(readFloat(cloud, point, 16), 0);
+  }
+}
+}  // namespace
+
+/**
+ * @note Test that the point cloud is laid out like pcl::PointXYZI: float32 x, y and z at bytes 0,
+ * 4 and 8, float32 intensity at byte 16, 32 bytes per point.
+ */
+TEST(Raycaster, pointFieldsLayout)
+{
+  Raycaster raycaster;
+  raycaster.setDirection(makeConfiguration());
+  raycaster.updateBox("box", 2, 2, 2, makePose(10, 0, 0));
+  const auto cloud = raycaster.raycast("base_link", rclcpp::Time(), makePose(0, 0, 0));
+  ASSERT_EQ(cloud.fields.size(), 4u);
+  const std::vector<std::pair<std::string, std::uint32_t>> fields = {
+    {"x", 0}, {"y", 4}, {"z", 8}, {"intensity", 16}};
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    EXPECT_EQ(cloud.fields[i].name, fields[i].first);
+    EXPECT_EQ(cloud.fields[i].offset, fields[i].second);
+    EXPECT_EQ(cloud.fields[i].datatype, sensor_msgs::msg::PointField::FLOAT32);
+    EXPECT_EQ(cloud.fields[i].count, 1u);
+  }
+  EXPECT_EQ(cloud.point_step, 32u);
+  EXPECT_EQ(cloud.height, 1u);
+  EXPECT_EQ(cloud.row_step, cloud.width * cloud.point_step);
+  EXPECT_EQ(cloud.data.size(), cloud.row_step);
+  EXPECT_EQ(cloud.header.frame_id, "base_link");
+}
+
+/**
+ * @note Test that every ray toward a box hits its near face and that only boxes in sight are
+ * detected.
+ */
+TEST(Raycaster, hitNearFaceOfBox)
+{
+  Raycaster raycaster;
+  raycaster.setDirection(makeConfiguration());
+  raycaster.updateBox("ahead", 2, 2, 2, makePose(10, 0, 0));
+  // above the only scan line, so it is never hit
+  raycaster.updateBox("above", 2, 2, 2, makePose(0, -10, 5));
+  const auto cloud = raycaster.raycast("base_link", rclcpp::Time(), makePose(0, 0, 0));
+  EXPECT_EQ(cloud.width, countRaysHittingFace(9));
+  expectPointsOnFace(cloud, 9);
+  EXPECT_EQ(raycaster.getDetectedObject(), std::vector<std::string>({"ahead"}));
+}
+
+/**
+ * @note Test that points of a previous scan do not leak into the next one, which reuses the buffer
+ * of the raycaster, and that boxes not updated since the previous scan are removed.
+ */
+TEST(Raycaster, reuseBufferAcrossScans)
+{
+  Raycaster raycaster;
+  raycaster.setDirection(makeConfiguration());
+  raycaster.updateBox("box", 2, 2, 2, makePose(10, 0, 0));
+  const auto near = raycaster.raycast("base_link", rclcpp::Time(), makePose(0, 0, 0));
+  EXPECT_EQ(near.width, countRaysHittingFace(9));
+
+  raycaster.updateBox("box", 2, 2, 2, makePose(15, 0, 0));
+  const auto far = raycaster.raycast("base_link", rclcpp::Time(), makePose(0, 0, 0));
+  EXPECT_EQ(far.width, countRaysHittingFace(14));
+  EXPECT_LT(far.width, near.width);
+  expectPointsOnFace(far, 14);
+  EXPECT_EQ(raycaster.getDetectedObject(), std::vector<std::string>({"box"}));
+
+  const auto empty = raycaster.raycast("base_link", rclcpp::Time(), makePose(0, 0, 0));
+  EXPECT_EQ(empty.width, 0u);
+  EXPECT_TRUE(empty.data.empty());
+  EXPECT_TRUE(raycaster.getDetectedObject().empty());
+}
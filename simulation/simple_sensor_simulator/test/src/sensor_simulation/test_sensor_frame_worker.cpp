@@ -0,0 +1,118 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <simple_sensor_simulator/sensor_simulation/sensor_frame_worker.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using simple_sensor_simulator::SensorFrameWorker;
+
+/**
+ * @note Test that frames run one at a time, in the order they were posted, on one thread which is
+ * not the caller.
+ */
+TEST(SensorFrameWorker, runFramesInOrderOnOneThread)
+{
+  std::vector<int> frames;
+  std::vector<std::thread::id> threads;
+  std::atomic<int> running = 0;
+  bool overlapped = false;
+  {
+    SensorFrameWorker worker;
+    for (int i = 0; i < 10; ++i) {
+      worker.post([&, i]() {
+        overlapped |= running++ != 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        frames.push_back(i);
+        threads.push_back(std::this_thread::get_id());
+        --running;
+      });
+    }
+    worker.wait();
+    EXPECT_EQ(frames.size(), 10u);
+  }
+  EXPECT_FALSE(overlapped);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(frames[i], i);
+    EXPECT_EQ(threads[i], threads.front());
+  }
+  EXPECT_NE(threads.front(), std::this_thread::get_id());
+}
+
+/**
+ * @note Test that post returns while the frame is still running, which is what lets the simulator
+ * respond before the sensor simulation has finished.
+ */
+TEST(SensorFrameWorker, postDoesNotWaitForFrame)
+{
+  SensorFrameWorker worker;
+  std::atomic<bool> release = false;
+  std::atomic<bool> finished = false;
+  worker.post([&]() {
+    while (not release) {
+      std::this_thread::yield();
+    }
+    finished = true;
+  });
+  EXPECT_FALSE(finished);
+  release = true;
+  worker.wait();
+  EXPECT_TRUE(finished);
+}
+
+/**
+ * @note Test that the exception thrown by a frame is rethrown once by the next wait or post, and
+ * that the worker keeps running frames afterwards.
+ */
+TEST(SensorFrameWorker, rethrowException)
+{
+  SensorFrameWorker worker;
+  worker.post([]() { throw std::runtime_error("sensor"); });
+  EXPECT_THROW(worker.wait(), std::runtime_error);
+  EXPECT_NO_THROW(worker.wait());
+  worker.post([]() { throw std::runtime_error("sensor"); });
+  bool ran = false;
+  EXPECT_THROW(worker.post([&]() { ran = true; }), std::runtime_error);
+  EXPECT_FALSE(ran);
+  worker.post([&]() { ran = true; });
+  worker.wait();
+  EXPECT_TRUE(ran);
+}
+
+/**
+ * @note Test that the frame posted last is run before the worker is destroyed.
+ */
+TEST(SensorFrameWorker, finishFrameOnDestruction)
+{
+  bool ran = false;
+  {
+    SensorFrameWorker worker;
+    worker.post([&]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      ran = true;
+    });
+  }
+  EXPECT_TRUE(ran);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <simple_sensor_simulator/sensor_simulation/traffic_lights/traffic_signals_states.hpp>
+#include <simulation_api_schema.pb.h>
+#include <utility>
+#include <vector>
+
+using simple_sensor_simulator::traffic_lights::TrafficSignalsStates;
+
+namespace
+{
+auto makeTrafficSignal(std::int32_t id, simulation_api_schema::TrafficLight_Color color)
+  -> simulation_api_schema::TrafficSignal
+{
+  simulation_api_schema::TrafficSignal traffic_signal;
+  traffic_signal.set_id(id);
+  auto traffic_light = traffic_signal.add_traffic_light_status();
+  traffic_light->set_color(color);
+  traffic_light->set_shape(simulation_api_schema::TrafficLight_Shape_CIRCLE);
+  traffic_light->set_status(simulation_api_schema::TrafficLight_Status_SOLID_ON);
+  traffic_light->set_confidence(1.0);
+  return traffic_signal;
+}
+
+auto makeRequest(
+  const std::vector<simulation_api_schema::TrafficSignal> & traffic_signals, bool delta)
+  -> simulation_api_schema::UpdateTrafficLightsRequest
+{
+  simulation_api_schema::UpdateTrafficLightsRequest request;
+  for (const auto & traffic_signal : traffic_signals) {
+    *request.add_states() = traffic_signal;
+  }
+  request.set_delta(delta);
+  return request;
+}
+
+auto getColors(const TrafficSignalsStates & states)
+  -> std::vector<std::pair<std::int32_t, simulation_api_schema::TrafficLight_Color>>
+{
+  std::vector<std::pair<std::int32_t, simulation_api_schema::TrafficLight_Color>> colors;
+  for (const auto & state : states.get().states()) {
+    EXPECT_EQ(state.traffic_light_status_size(), 1);
+    colors.emplace_back(state.id(), state.traffic_light_status(0).color());
+  }
+  return colors;
+}
+
+constexpr auto red = simulation_api_schema::TrafficLight_Color_RED;
+constexpr auto green = simulation_api_schema::TrafficLight_Color_GREEN;
+constexpr auto amber = simulation_api_schema::TrafficLight_Color_AMBER;
+}  // namespace
+
+/**
+ * @note Test that a delta replaces the state of a traffic signal it contains and the others keep
+ * theirs.
+ */
+TEST(TrafficSignalsStates, deltaUpdatesExistingSignal)
+{
+  TrafficSignalsStates states;
+  states.update(makeRequest({makeTrafficSignal(1, red), makeTrafficSignal(2, green)}, false));
+  states.update(makeRequest({makeTrafficSignal(2, amber)}, true));
+  EXPECT_EQ(getColors(states), decltype(getColors(states))({{1, red}, {2, amber}}));
+  EXPECT_FALSE(states.get().delta());
+}
+
+/**
+ * @note Test that a delta adds a traffic signal not known yet, and that a later delta updates it.
+ */
+TEST(TrafficSignalsStates, deltaAddsSignal)
+{
+  TrafficSignalsStates states;
+  states.update(makeRequest({makeTrafficSignal(1, red)}, false));
+  states.update(makeRequest({makeTrafficSignal(3, green)}, true));
+  EXPECT_EQ(getColors(states), decltype(getColors(states))({{1, red}, {3, green}}));
+  states.update(makeRequest({makeTrafficSignal(3, amber), makeTrafficSignal(1, green)}, true));
+  EXPECT_EQ(getColors(states), decltype(getColors(states))({{1, green}, {3, amber}}));
+}
+
+/**
+ * @note Test that a keyframe replaces every state and resets the indices, so that a following
+ * delta updates the signal at its new position instead of the one at its old position.
+ */
+TEST(TrafficSignalsStates, keyframeResetsIndices)
+{
+  TrafficSignalsStates states;
+  states.update(makeRequest({makeTrafficSignal(1, red), makeTrafficSignal(2, green)}, false));
+  states.update(makeRequest({makeTrafficSignal(2, red)}, false));
+  EXPECT_EQ(getColors(states), decltype(getColors(states))({{2, red}}));
+  states.update(makeRequest({makeTrafficSignal(2, green)}, true));
+  EXPECT_EQ(getColors(states), decltype(getColors(states))({{2, green}}));
+  states.update(makeRequest({makeTrafficSignal(1, amber)}, true));
+  EXPECT_EQ(getColors(states), decltype(getColors(states))({{2, green}, {1, amber}}));
+}
@@ -19,7 +19,8 @@
 
 namespace simulation_interface
 {
-enum class TransportProtocol { TCP /*, UDP*/ };
+/// @note SHM requires both processes to run on the same host, the host name is ignored.
+enum class TransportProtocol { TCP, SHM /*, UDP*/ };
 
 std::string enumToString(const TransportProtocol & protocol);
 
@@ -34,6 +35,8 @@ std::string getEndPoint(
 
 std::string getEndPoint(
   const TransportProtocol & protocol, const std::string & hostname, const unsigned int & port);
+
+std::string getSharedMemoryName(const unsigned int & port);
 }  // namespace simulation_interface
 
 #endif  // SIMULATION_INTERFACE__CONSTANTS_HPP_
@@ -0,0 +1,87 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMULATION_INTERFACE__ENTITY_STATUS_DELTA_HPP_
+#define SIMULATION_INTERFACE__ENTITY_STATUS_DELTA_HPP_
+
+#include <simulation_api_schema.pb.h>
+
+#include <cstdint>
+#include <functional>
+#include <geometry_msgs/msg/pose.hpp>
+#include <map>
+#include <string>
+#include <traffic_simulator_msgs/msg/action_status.hpp>
+#include <traffic_simulator_msgs/msg/entity_status.hpp>
+#include <unordered_map>
+
+namespace simulation_interface
+{
+/**
+ * @brief Client side of UpdateEntityStatusDeltaRequest.
+ * @note Gives each entity the handle sent in its spawn request and remembers the status last sent
+ *       with it, so that only the kinematic fields which changed since then are encoded.
+ */
+class EntityStatusDeltaEncoder
+{
+public:
+  /// @brief Handle of the entity, a new one is given to an entity not seen yet (or erased).
+  auto getHandle(const std::string & name) -> std::uint32_t;
+
+  /// @brief Forget the entity, so that the next entity spawned with its name is sent in full.
+  auto erase(const std::string & name) -> void;
+
+  /**
+   * @brief Append the delta of the entity to req.
+   * @note The status of an entity simulated by the simulator (Ego) is not sent, only its handle.
+   *       An entity whose status did not change since the last call is not appended at all.
+   */
+  auto encode(
+    const traffic_simulator_msgs::msg::EntityStatus & status, bool simulated_by_simulator,
+    simulation_api_schema::UpdateEntityStatusDeltaRequest & req) -> void;
+
+private:
+  struct Sent
+  {
+    std::uint32_t handle = 0;
+
+    bool sent = false;
+
+    geometry_msgs::msg::Pose pose;
+
+    traffic_simulator_msgs::msg::ActionStatus action_status;
+  };
+
+  std::unordered_map<std::string, Sent> sent_;
+
+  std::uint32_t next_handle_ = 1;
+};
+
+/**
+ * @brief Server side of UpdateEntityStatusDeltaRequest.
+ * @param handles Name of the entity registered by its spawn request, for each handle.
+ * @param statuses Status of each spawned entity, updated in place.
+ * @param simulate Called for each entity listed in req before its delta is applied. Returns true if
+ *        the entity is simulated by the caller (Ego), in which case its delta is not applied.
+ * @note The time of req is set on every status, including entities not listed in req because
+ *       their status did not change.
+ */
+auto applyEntityStatusDelta(
+  const simulation_api_schema::UpdateEntityStatusDeltaRequest & req,
+  const std::unordered_map<std::uint32_t, std::string> & handles,
+  std::map<std::string, simulation_api_schema::EntityStatus> & statuses,
+  const std::function<bool(simulation_api_schema::EntityStatus &)> & simulate) -> void;
+}  // namespace simulation_interface
+
+#endif  // SIMULATION_INTERFACE__ENTITY_STATUS_DELTA_HPP_
@@ -0,0 +1,108 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMULATION_INTERFACE__SHARED_MEMORY_CHANNEL_HPP_
+#define SIMULATION_INTERFACE__SHARED_MEMORY_CHANNEL_HPP_
+
+#include <google/protobuf/message_lite.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace simulation_interface
+{
+/**
+ * @brief Request/reply channel between two processes on the same host over POSIX shared memory.
+ * @note The region holds one request slot and one response slot, each followed by its payload
+ *       buffer. Protobuf messages are serialized directly into the payload buffer of the writer
+ *       and parsed directly from it by the reader, so no socket or intermediate buffer copy is
+ *       made. The writer publishes a payload by incrementing the 32 bit sequence number of the
+ *       slot, and the reader waits for that increment with futex(2).
+ */
+class SharedMemoryChannel
+{
+public:
+  enum class Role { CLIENT, SERVER };
+
+  /**
+   * @brief Server creates (and on destruction removes) the region, client opens it.
+   * @note Client opens the region on its first send and waits there until the server has created
+   *       it, just like a ZeroMQ socket which connects before the peer binds. When the server
+   *       leaves, or a new server replaces the region of one which crashed, the client opens the
+   *       new region and sends its pending request again.
+   */
+  explicit SharedMemoryChannel(
+    const std::string & name, const Role & role, std::size_t capacity = 16 * 1024 * 1024);
+
+  ~SharedMemoryChannel();
+
+  SharedMemoryChannel(const SharedMemoryChannel &) = delete;
+
+  auto operator=(const SharedMemoryChannel &) -> SharedMemoryChannel & = delete;
+
+  /// @brief Write message into the outgoing slot (request for client, response for server).
+  auto send(const google::protobuf::MessageLite & message) -> void;
+
+  /**
+   * @brief Wait for a new message in the incoming slot and parse it into message.
+   * @return false if no message arrived within timeout.
+   */
+  auto receive(google::protobuf::MessageLite & message, const std::chrono::nanoseconds & timeout)
+    -> bool;
+
+  /// @brief Wait for a new message in the incoming slot without timeout.
+  auto receive(google::protobuf::MessageLite & message) -> void;
+
+  const std::string name;
+
+  const Role role;
+
+private:
+  struct Slot;
+
+  struct Header;
+
+  static auto leave(Header &) -> void;
+
+  auto open() -> void;
+
+  auto hasServerLeft() const noexcept -> bool;
+
+  auto reopen() -> void;
+
+  auto incoming() const noexcept -> Slot &;
+
+  auto outgoing() const noexcept -> Slot &;
+
+  auto payload(const Slot &) const noexcept -> std::uint8_t *;
+
+  auto publish(Slot &, std::size_t size) -> void;
+
+  auto wait(const std::chrono::nanoseconds * timeout) -> bool;
+
+  auto parse(Slot &, google::protobuf::MessageLite &) -> void;
+
+  std::size_t capacity_;
+
+  std::size_t mapped_size_ = 0;
+
+  void * region_ = nullptr;
+
+  std::uint32_t received_sequence_ = 0;
+};
+}  // namespace simulation_interface
+
+#endif  // SIMULATION_INTERFACE__SHARED_MEMORY_CHANNEL_HPP_
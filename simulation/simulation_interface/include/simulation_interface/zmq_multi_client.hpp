@@ -23,6 +23,7 @@
 #include <rclcpp/rclcpp.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
+#include <simulation_interface/shared_memory_channel.hpp>
 #include <string>
 #include <thread>
 #include <zmqpp/zmqpp.hpp>
@@ -82,6 +83,11 @@ public:
   auto call(const simulation_api_schema::AttachPseudoTrafficLightDetectorRequest &)
     -> simulation_api_schema::AttachPseudoTrafficLightDetectorResponse;
 
+  auto call(const simulation_api_schema::UpdateEntityStatusDeltaRequest &)
+    -> simulation_api_schema::UpdateEntityStatusDeltaResponse;
+
+  auto call(const simulation_api_schema::FrameRequest &) -> simulation_api_schema::FrameResponse;
+
   const simulation_interface::TransportProtocol protocol;
   const std::string hostname;
 
@@ -89,6 +95,7 @@ private:
   zmqpp::context context_;
   const zmqpp::socket_type type_;
   zmqpp::socket socket_;
+  std::unique_ptr<simulation_interface::SharedMemoryChannel> shared_memory_;
 
   bool is_running = true;
 };
@@ -18,9 +18,11 @@
 #include <simulation_api_schema.pb.h>
 
 #include <functional>
+#include <memory>
 #include <rclcpp/rclcpp.hpp>
 #include <scenario_simulator_exception/exception.hpp>
 #include <simulation_interface/constants.hpp>
+#include <simulation_interface/shared_memory_channel.hpp>
 #include <string>
 #include <thread>
 #include <tuple>
@@ -40,8 +42,14 @@ public:
     socket_(context_, type_),
     functions_(std::forward<decltype(xs)>(xs)...)
   {
-    socket_.bind(simulation_interface::getEndPoint(protocol, hostname, socket_port));
-    poller_.add(socket_);
+    if (protocol == simulation_interface::TransportProtocol::SHM) {
+      shared_memory_ = std::make_unique<simulation_interface::SharedMemoryChannel>(
+        simulation_interface::getSharedMemoryName(socket_port),
+        simulation_interface::SharedMemoryChannel::Role::SERVER);
+    } else {
+      socket_.bind(simulation_interface::getEndPoint(protocol, hostname, socket_port));
+      poller_.add(socket_);
+    }
     thread_ = std::thread(&MultiServer::start_poll, this);
   }
 
@@ -50,11 +58,14 @@ public:
 private:
   void poll();
   void start_poll();
+  auto handle(const simulation_api_schema::SimulationRequest &)
+    -> simulation_api_schema::SimulationResponse;
   std::thread thread_;
   const zmqpp::context context_;
   const zmqpp::socket_type type_;
   zmqpp::poller poller_;
   zmqpp::socket socket_;
+  std::unique_ptr<simulation_interface::SharedMemoryChannel> shared_memory_;
 
 #define DEFINE_FUNCTION_TYPE(TYPENAME)                                      \
   using TYPENAME = std::function<simulation_api_schema::TYPENAME##Response( \
@@ -73,6 +84,8 @@ private:
   DEFINE_FUNCTION_TYPE(UpdateTrafficLights);
   DEFINE_FUNCTION_TYPE(FollowPolylineTrajectory);
   DEFINE_FUNCTION_TYPE(AttachPseudoTrafficLightDetector);
+  DEFINE_FUNCTION_TYPE(UpdateEntityStatusDelta);
+  DEFINE_FUNCTION_TYPE(Frame);
 
 #undef DEFINE_FUNCTION_TYPE
 
@@ -80,7 +93,7 @@ private:
     Initialize, UpdateFrame, SpawnVehicleEntity, SpawnPedestrianEntity, SpawnMiscObjectEntity,
     DespawnEntity, UpdateEntityStatus, AttachLidarSensor, AttachDetectionSensor,
     AttachOccupancyGridSensor, UpdateTrafficLights, FollowPolylineTrajectory,
-    AttachPseudoTrafficLightDetector>
+    AttachPseudoTrafficLightDetector, UpdateEntityStatusDelta, Frame>
     functions_;
 };
 }  // namespace zeromq
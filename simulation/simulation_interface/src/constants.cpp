@@ -32,17 +32,24 @@ std::string getEndPoint(
          std::to_string(port);
 }
 
+std::string getSharedMemoryName(const unsigned int & port)
+{
+  return "/simulation_interface." + std::to_string(port);
+}
+
 std::string enumToString(const TransportProtocol & protocol)
 {
   switch (protocol) {
     case TransportProtocol::TCP:
       return "tcp";
+    case TransportProtocol::SHM:
+      return "shm";
       /*
     case TransportProtocol::UDP:
       return "udp";              
       */
   }
-  THROW_SIMULATION_ERROR("Protocol should be TCP.");  // LCOV_EXCL_LINE
+  THROW_SIMULATION_ERROR("Protocol should be TCP or SHM.");  // LCOV_EXCL_LINE
 }
 
 std::string enumToString(const HostName & hostname)
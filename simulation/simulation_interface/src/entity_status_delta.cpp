@@ -0,0 +1,108 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iomanip>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/conversions.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
+#include <string>
+
+namespace simulation_interface
+{
+auto EntityStatusDeltaEncoder::getHandle(const std::string & name) -> std::uint32_t
+{
+  if (const auto iter = sent_.find(name); iter != sent_.end()) {
+    return iter->second.handle;
+  } else {
+    Sent sent;
+    sent.handle = next_handle_++;
+    return sent_.emplace(name, sent).first->second.handle;
+  }
+}
+
+auto EntityStatusDeltaEncoder::erase(const std::string & name) -> void { sent_.erase(name); }
+
+auto EntityStatusDeltaEncoder::encode(
+  const traffic_simulator_msgs::msg::EntityStatus & status, bool simulated_by_simulator,
+  simulation_api_schema::UpdateEntityStatusDeltaRequest & req) -> void
+{
+  const auto iter = sent_.find(status.name);
+  if (iter == sent_.end()) {
+    THROW_SIMULATION_ERROR("Entity ", std::quoted(status.name), " has no handle.");
+  }
+  auto & last = iter->second;
+  simulation_api_schema::EntityStatusDelta delta;
+  delta.set_handle(last.handle);
+  if (simulated_by_simulator) {
+    *req.add_status() = std::move(delta);
+    return;
+  }
+  if (not last.sent or last.pose != status.pose) {
+    toProto(status.pose, *delta.mutable_pose());
+  }
+  if (not last.sent or last.action_status.twist != status.action_status.twist) {
+    toProto(status.action_status.twist, *delta.mutable_twist());
+  }
+  if (not last.sent or last.action_status.accel != status.action_status.accel) {
+    toProto(status.action_status.accel, *delta.mutable_accel());
+  }
+  if (
+    not last.sent or last.action_status.current_action != status.action_status.current_action or
+    last.action_status.linear_jerk != status.action_status.linear_jerk) {
+    delta.mutable_action()->set_current_action(status.action_status.current_action);
+    delta.mutable_action()->set_linear_jerk(status.action_status.linear_jerk);
+  }
+  if (delta.has_pose() or delta.has_twist() or delta.has_accel() or delta.has_action()) {
+    *req.add_status() = std::move(delta);
+  }
+  last.sent = true;
+  last.pose = status.pose;
+  last.action_status = status.action_status;
+}
+
+auto applyEntityStatusDelta(
+  const simulation_api_schema::UpdateEntityStatusDeltaRequest & req,
+  const std::unordered_map<std::uint32_t, std::string> & handles,
+  std::map<std::string, simulation_api_schema::EntityStatus> & statuses,
+  const std::function<bool(simulation_api_schema::EntityStatus &)> & simulate) -> void
+{
+  /// @note entities whose status did not change are not listed in req, but their time advances
+  for (auto & each : statuses) {
+    each.second.set_time(req.time());
+  }
+  for (const auto & delta : req.status()) {
+    const auto handle = handles.find(delta.handle());
+    if (handle == handles.end()) {
+      THROW_SEMANTIC_ERROR("Entity handle ", delta.handle(), " does not exist");
+    }
+    auto & status = statuses.at(handle->second);
+    if (simulate(status)) {
+      continue;
+    }
+    if (delta.has_pose()) {
+      status.mutable_pose()->CopyFrom(delta.pose());
+    }
+    if (delta.has_twist()) {
+      status.mutable_action_status()->mutable_twist()->CopyFrom(delta.twist());
+    }
+    if (delta.has_accel()) {
+      status.mutable_action_status()->mutable_accel()->CopyFrom(delta.accel());
+    }
+    if (delta.has_action()) {
+      status.mutable_action_status()->set_current_action(delta.action().current_action());
+      status.mutable_action_status()->set_linear_jerk(delta.action().linear_jerk());
+    }
+  }
+}
+}  // namespace simulation_interface
@@ -0,0 +1,308 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/shared_memory_channel.hpp>
+#include <thread>
+#include <vector>
+
+namespace simulation_interface
+{
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+
+struct SharedMemoryChannel::Slot
+{
+  std::atomic<std::uint32_t> sequence;
+
+  std::uint32_t size;
+};
+
+struct alignas(64) SharedMemoryChannel::Header
+{
+  static constexpr std::uint32_t magic = 0x53534D43;  // "SSMC"
+
+  /// @note magic while the server which created the region serves it, anything else after that.
+  std::atomic<std::uint32_t> ready;
+
+  std::uint32_t capacity;
+
+  Slot request;
+
+  Slot response;
+};
+
+namespace
+{
+auto futex(
+  std::atomic<std::uint32_t> & word, int operation, std::uint32_t value,
+  const timespec * timeout = nullptr)
+{
+  /// @note Not FUTEX_PRIVATE_FLAG, the word is shared with another process.
+  return syscall(
+    SYS_futex, reinterpret_cast<std::uint32_t *>(&word), operation, value, timeout, nullptr, 0);
+}
+}  // namespace
+
+auto SharedMemoryChannel::leave(Header & header) -> void
+{
+  header.ready.store(0, std::memory_order_release);
+  for (auto slot : {&header.request, &header.response}) {
+    futex(slot->sequence, FUTEX_WAKE, INT_MAX);
+  }
+}
+
+SharedMemoryChannel::SharedMemoryChannel(
+  const std::string & name, const Role & role, std::size_t capacity)
+: name(name), role(role), capacity_(capacity)
+{
+  if (role == Role::SERVER) {
+    /**
+     * @note Remove the region left behind by a server which was not shut down cleanly, after
+     *       telling the clients attached to it to reopen.
+     */
+    if (const auto fd = shm_open(name.c_str(), O_RDWR, 0); 0 <= fd) {
+      struct stat status;
+      if (fstat(fd, &status) == 0 and sizeof(Header) <= static_cast<std::size_t>(status.st_size)) {
+        if (const auto region =
+              mmap(nullptr, sizeof(Header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            region != MAP_FAILED) {
+          leave(*static_cast<Header *>(region));
+          munmap(region, sizeof(Header));
+        }
+      }
+      close(fd);
+    }
+    shm_unlink(name.c_str());
+    const auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      THROW_SIMULATION_ERROR("Failed to create shared memory ", name, ": ", std::strerror(errno));
+    }
+    mapped_size_ = sizeof(Header) + 2 * capacity_;
+    if (ftruncate(fd, mapped_size_) != 0) {
+      close(fd);
+      THROW_SIMULATION_ERROR("Failed to resize shared memory ", name, ": ", std::strerror(errno));
+    }
+    region_ = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region_ == MAP_FAILED) {
+      region_ = nullptr;
+      THROW_SIMULATION_ERROR("Failed to map shared memory ", name, ": ", std::strerror(errno));
+    }
+    auto header = new (region_) Header();
+    header->capacity = capacity_;
+    header->request.sequence.store(0);
+    header->response.sequence.store(0);
+    header->ready.store(Header::magic, std::memory_order_release);
+  }
+}
+
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+  if (region_) {
+    if (role == Role::SERVER) {
+      leave(*static_cast<Header *>(region_));
+    }
+    munmap(region_, mapped_size_);
+  }
+  if (role == Role::SERVER) {
+    shm_unlink(name.c_str());
+  }
+}
+
+auto SharedMemoryChannel::open() -> void
+{
+  while (true) {
+    if (const auto fd = shm_open(name.c_str(), O_RDWR, 0); 0 <= fd) {
+      struct stat status;
+      if (fstat(fd, &status) == 0 and sizeof(Header) <= static_cast<std::size_t>(status.st_size)) {
+        mapped_size_ = status.st_size;
+        region_ = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (region_ == MAP_FAILED) {
+          region_ = nullptr;
+          THROW_SIMULATION_ERROR("Failed to map shared memory ", name, ": ", std::strerror(errno));
+        }
+        const auto header = static_cast<Header *>(region_);
+        if (header->ready.load(std::memory_order_acquire) == Header::magic) {
+          capacity_ = header->capacity;
+          received_sequence_ = incoming().sequence.load(std::memory_order_acquire);
+          return;
+        }
+        munmap(region_, mapped_size_);
+        region_ = nullptr;
+      } else {
+        close(fd);
+      }
+    }
+    /// @note The server has not created the region yet.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+auto SharedMemoryChannel::hasServerLeft() const noexcept -> bool
+{
+  return static_cast<Header *>(region_)->ready.load(std::memory_order_acquire) != Header::magic;
+}
+
+auto SharedMemoryChannel::reopen() -> void
+{
+  /// @note The request sent to the server which left is sent again to the new one.
+  const auto & request = outgoing();
+  const auto pending_request =
+    std::vector<std::uint8_t>(payload(request), payload(request) + request.size);
+  munmap(region_, mapped_size_);
+  region_ = nullptr;
+  open();
+  if (capacity_ < pending_request.size()) {
+    THROW_SIMULATION_ERROR(
+      "Message of ", pending_request.size(), " bytes exceeds capacity of shared memory ", name,
+      " (", capacity_, " bytes)");
+  }
+  std::memcpy(payload(outgoing()), pending_request.data(), pending_request.size());
+  publish(outgoing(), pending_request.size());
+}
+
+auto SharedMemoryChannel::incoming() const noexcept -> Slot &
+{
+  const auto header = static_cast<Header *>(region_);
+  return role == Role::SERVER ? header->request : header->response;
+}
+
+auto SharedMemoryChannel::outgoing() const noexcept -> Slot &
+{
+  const auto header = static_cast<Header *>(region_);
+  return role == Role::SERVER ? header->response : header->request;
+}
+
+auto SharedMemoryChannel::payload(const Slot & slot) const noexcept -> std::uint8_t *
+{
+  const auto header = static_cast<Header *>(region_);
+  const auto buffer = static_cast<std::uint8_t *>(region_) + sizeof(Header);
+  return &slot == &header->request ? buffer : buffer + capacity_;
+}
+
+auto SharedMemoryChannel::publish(Slot & slot, std::size_t size) -> void
+{
+  slot.size = size;
+  slot.sequence.fetch_add(1, std::memory_order_release);
+  futex(slot.sequence, FUTEX_WAKE, INT_MAX);
+}
+
+auto SharedMemoryChannel::send(const google::protobuf::MessageLite & message) -> void
+{
+  if (not region_) {
+    open();
+  } else if (role == Role::CLIENT and hasServerLeft()) {
+    munmap(region_, mapped_size_);
+    region_ = nullptr;
+    open();
+  }
+  auto & slot = outgoing();
+  const auto size = message.ByteSizeLong();
+  if (capacity_ < size) {
+    THROW_SIMULATION_ERROR(
+      "Message of ", size, " bytes exceeds capacity of shared memory ", name, " (", capacity_,
+      " bytes)");
+  }
+  message.SerializeWithCachedSizesToArray(payload(slot));
+  publish(slot, size);
+}
+
+auto SharedMemoryChannel::wait(const std::chrono::nanoseconds * timeout) -> bool
+{
+  /// @note Spin for a moment first, a round trip is often shorter than sleeping on the futex.
+  for (int i = 0; i < 1024; ++i) {
+    if (incoming().sequence.load(std::memory_order_acquire) != received_sequence_) {
+      break;
+    }
+  }
+  /**
+   * @note A client checks whether the server has left at least this often, in case it went to
+   *       sleep just after the server woke it up to tell so.
+   */
+  constexpr auto server_check_interval = std::chrono::milliseconds(100);
+  const auto deadline = std::chrono::steady_clock::now() +
+                        (timeout ? *timeout : std::chrono::nanoseconds::zero());
+  while (true) {
+    auto & sequence = incoming().sequence;
+    if (const auto current = sequence.load(std::memory_order_acquire);
+        current != received_sequence_) {
+      return true;
+    } else if (role == Role::CLIENT and hasServerLeft()) {
+      /// @note The server left, e.g. a new server replaced the region of one which crashed.
+      reopen();
+    } else if (timeout or role == Role::CLIENT) {
+      auto rest = timeout ? std::chrono::nanoseconds(deadline - std::chrono::steady_clock::now())
+                          : std::chrono::nanoseconds(server_check_interval);
+      if (rest <= std::chrono::nanoseconds::zero()) {
+        return false;
+      } else if (role == Role::CLIENT) {
+        rest = std::min<std::chrono::nanoseconds>(rest, server_check_interval);
+      }
+      const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(rest);
+      const timespec duration = {
+        static_cast<time_t>(seconds.count()), static_cast<long>((rest - seconds).count())};
+      futex(sequence, FUTEX_WAIT, current, &duration);
+    } else {
+      futex(sequence, FUTEX_WAIT, current);
+    }
+  }
+}
+
+auto SharedMemoryChannel::parse(Slot & slot, google::protobuf::MessageLite & message) -> void
+{
+  received_sequence_ = slot.sequence.load(std::memory_order_acquire);
+  if (not message.ParseFromArray(payload(slot), slot.size)) {
+    THROW_SIMULATION_ERROR("Failed to parse message received from shared memory ", name);
+  }
+}
+
+auto SharedMemoryChannel::receive(
+  google::protobuf::MessageLite & message, const std::chrono::nanoseconds & timeout) -> bool
+{
+  if (not region_) {
+    open();
+  }
+  if (wait(&timeout)) {
+    parse(incoming(), message);
+    return true;
+  } else {
+    return false;
+  }
+}
+
+auto SharedMemoryChannel::receive(google::protobuf::MessageLite & message) -> void
+{
+  if (not region_) {
+    open();
+  }
+  wait(nullptr);
+  parse(incoming(), message);
+}
+}  // namespace simulation_interface
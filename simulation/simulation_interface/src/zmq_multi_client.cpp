@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <frame_profiler/frame_profiler.hpp>
+#include <memory>
 #include <rclcpp/utilities.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <simulation_interface/zmq_multi_client.hpp>
@@ -27,7 +29,13 @@ MultiClient::MultiClient(
   type_(zmqpp::socket_type::request),
   socket_(context_, type_)
 {
-  socket_.connect(simulation_interface::getEndPoint(protocol, hostname, socket_port));
+  if (protocol == simulation_interface::TransportProtocol::SHM) {
+    shared_memory_ = std::make_unique<simulation_interface::SharedMemoryChannel>(
+      simulation_interface::getSharedMemoryName(socket_port),
+      simulation_interface::SharedMemoryChannel::Role::CLIENT);
+  } else {
+    socket_.connect(simulation_interface::getEndPoint(protocol, hostname, socket_port));
+  }
 }
 
 void MultiClient::closeConnection()
@@ -35,6 +43,7 @@ void MultiClient::closeConnection()
   if (is_running) {
     is_running = false;
     socket_.close();
+    shared_memory_.reset();
   }
 }
 
@@ -43,6 +52,13 @@ MultiClient::~MultiClient() { closeConnection(); }
 auto MultiClient::call(const simulation_api_schema::SimulationRequest & req)
   -> simulation_api_schema::SimulationResponse
 {
+  FRAME_PROFILER_ZONE("MultiClient::call");
+  if (shared_memory_) {
+    shared_memory_->send(req);
+    simulation_api_schema::SimulationResponse response;
+    shared_memory_->receive(response);
+    return response;
+  }
   zmqpp::message message = toZMQ(req);
   socket_.send(message);
   zmqpp::message buffer;
@@ -206,4 +222,28 @@ auto MultiClient::call(
     return {};
   }
 }
+
+auto MultiClient::call(const simulation_api_schema::UpdateEntityStatusDeltaRequest & request)
+  -> simulation_api_schema::UpdateEntityStatusDeltaResponse
+{
+  if (is_running) {
+    auto simulation_request = simulation_api_schema::SimulationRequest();
+    *simulation_request.mutable_update_entity_status_delta() = request;
+    return call(simulation_request).update_entity_status_delta();
+  } else {
+    return {};
+  }
+}
+
+auto MultiClient::call(const simulation_api_schema::FrameRequest & request)
+  -> simulation_api_schema::FrameResponse
+{
+  if (is_running) {
+    auto simulation_request = simulation_api_schema::SimulationRequest();
+    *simulation_request.mutable_frame() = request;
+    return call(simulation_request).frame();
+  } else {
+    return {};
+  }
+}
 }  // namespace zeromq
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
 #include <simulation_interface/conversions.hpp>
 #include <simulation_interface/zmq_multi_server.hpp>
 #include <status_monitor/status_monitor.hpp>
@@ -23,74 +24,93 @@ MultiServer::~MultiServer() { thread_.join(); }
 void MultiServer::poll()
 {
   constexpr long timeout_ms = 1L;
+  if (shared_memory_) {
+    simulation_api_schema::SimulationRequest sim_request;
+    if (shared_memory_->receive(sim_request, std::chrono::milliseconds(timeout_ms))) {
+      shared_memory_->send(handle(sim_request));
+    }
+    return;
+  }
   poller_.poll(timeout_ms);
   if (poller_.has_input(socket_)) {
-    simulation_api_schema::SimulationResponse sim_response;
     zmqpp::message sim_request;
     socket_.receive(sim_request);
-    auto proto = toProto<simulation_api_schema::SimulationRequest>(sim_request);
-    switch (proto.request_case()) {
-      case simulation_api_schema::SimulationRequest::RequestCase::kInitialize:
-        *sim_response.mutable_initialize() = std::get<Initialize>(functions_)(proto.initialize());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateFrame:
-        *sim_response.mutable_update_frame() =
-          std::get<UpdateFrame>(functions_)(proto.update_frame());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kSpawnVehicleEntity:
-        *sim_response.mutable_spawn_vehicle_entity() =
-          std::get<SpawnVehicleEntity>(functions_)(proto.spawn_vehicle_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kSpawnPedestrianEntity:
-        *sim_response.mutable_spawn_pedestrian_entity() =
-          std::get<SpawnPedestrianEntity>(functions_)(proto.spawn_pedestrian_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kSpawnMiscObjectEntity:
-        *sim_response.mutable_spawn_misc_object_entity() =
-          std::get<SpawnMiscObjectEntity>(functions_)(proto.spawn_misc_object_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kDespawnEntity:
-        *sim_response.mutable_despawn_entity() =
-          std::get<DespawnEntity>(functions_)(proto.despawn_entity());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateEntityStatus:
-        *sim_response.mutable_update_entity_status() =
-          std::get<UpdateEntityStatus>(functions_)(proto.update_entity_status());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachLidarSensor:
-        *sim_response.mutable_attach_lidar_sensor() =
-          std::get<AttachLidarSensor>(functions_)(proto.attach_lidar_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachDetectionSensor:
-        *sim_response.mutable_attach_detection_sensor() =
-          std::get<AttachDetectionSensor>(functions_)(proto.attach_detection_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachOccupancyGridSensor:
-        *sim_response.mutable_attach_occupancy_grid_sensor() =
-          std::get<AttachOccupancyGridSensor>(functions_)(proto.attach_occupancy_grid_sensor());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kUpdateTrafficLights:
-        *sim_response.mutable_update_traffic_lights() =
-          std::get<UpdateTrafficLights>(functions_)(proto.update_traffic_lights());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kFollowPolylineTrajectory:
-        *sim_response.mutable_follow_polyline_trajectory() =
-          std::get<FollowPolylineTrajectory>(functions_)(proto.follow_polyline_trajectory());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::kAttachPseudoTrafficLightDetector:
-        *sim_response.mutable_attach_pseudo_traffic_light_detector() =
-          std::get<AttachPseudoTrafficLightDetector>(functions_)(
-            proto.attach_pseudo_traffic_light_detector());
-        break;
-      case simulation_api_schema::SimulationRequest::RequestCase::REQUEST_NOT_SET: {
-        THROW_SIMULATION_ERROR("No case defined for oneof in SimulationRequest message");
-      }
-    }
-    auto msg = toZMQ(sim_response);
+    auto msg = toZMQ(handle(toProto<simulation_api_schema::SimulationRequest>(sim_request)));
     socket_.send(msg);
   }
 }
 
+auto MultiServer::handle(const simulation_api_schema::SimulationRequest & proto)
+  -> simulation_api_schema::SimulationResponse
+{
+  simulation_api_schema::SimulationResponse sim_response;
+  switch (proto.request_case()) {
+    case simulation_api_schema::SimulationRequest::RequestCase::kInitialize:
+      *sim_response.mutable_initialize() = std::get<Initialize>(functions_)(proto.initialize());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kUpdateFrame:
+      *sim_response.mutable_update_frame() =
+        std::get<UpdateFrame>(functions_)(proto.update_frame());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kSpawnVehicleEntity:
+      *sim_response.mutable_spawn_vehicle_entity() =
+        std::get<SpawnVehicleEntity>(functions_)(proto.spawn_vehicle_entity());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kSpawnPedestrianEntity:
+      *sim_response.mutable_spawn_pedestrian_entity() =
+        std::get<SpawnPedestrianEntity>(functions_)(proto.spawn_pedestrian_entity());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kSpawnMiscObjectEntity:
+      *sim_response.mutable_spawn_misc_object_entity() =
+        std::get<SpawnMiscObjectEntity>(functions_)(proto.spawn_misc_object_entity());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kDespawnEntity:
+      *sim_response.mutable_despawn_entity() =
+        std::get<DespawnEntity>(functions_)(proto.despawn_entity());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kUpdateEntityStatus:
+      *sim_response.mutable_update_entity_status() =
+        std::get<UpdateEntityStatus>(functions_)(proto.update_entity_status());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kAttachLidarSensor:
+      *sim_response.mutable_attach_lidar_sensor() =
+        std::get<AttachLidarSensor>(functions_)(proto.attach_lidar_sensor());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kAttachDetectionSensor:
+      *sim_response.mutable_attach_detection_sensor() =
+        std::get<AttachDetectionSensor>(functions_)(proto.attach_detection_sensor());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kAttachOccupancyGridSensor:
+      *sim_response.mutable_attach_occupancy_grid_sensor() =
+        std::get<AttachOccupancyGridSensor>(functions_)(proto.attach_occupancy_grid_sensor());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kUpdateTrafficLights:
+      *sim_response.mutable_update_traffic_lights() =
+        std::get<UpdateTrafficLights>(functions_)(proto.update_traffic_lights());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kFollowPolylineTrajectory:
+      *sim_response.mutable_follow_polyline_trajectory() =
+        std::get<FollowPolylineTrajectory>(functions_)(proto.follow_polyline_trajectory());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kAttachPseudoTrafficLightDetector:
+      *sim_response.mutable_attach_pseudo_traffic_light_detector() =
+        std::get<AttachPseudoTrafficLightDetector>(functions_)(
+          proto.attach_pseudo_traffic_light_detector());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kUpdateEntityStatusDelta:
+      *sim_response.mutable_update_entity_status_delta() =
+        std::get<UpdateEntityStatusDelta>(functions_)(proto.update_entity_status_delta());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::kFrame:
+      *sim_response.mutable_frame() = std::get<Frame>(functions_)(proto.frame());
+      break;
+    case simulation_api_schema::SimulationRequest::RequestCase::REQUEST_NOT_SET: {
+      THROW_SIMULATION_ERROR("No case defined for oneof in SimulationRequest message");
+    }
+  }
+  return sim_response;
+}
+
 void MultiServer::start_poll()
 {
   while (rclcpp::ok()) {
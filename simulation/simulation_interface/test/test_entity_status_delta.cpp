@@ -0,0 +1,190 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+
+#include <map>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/conversions.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
+#include <string>
+#include <unordered_map>
+
+/// @note Entity statuses kept by the simulator, updated the way ScenarioSimulator updates them.
+class Simulator
+{
+public:
+  auto spawn(const traffic_simulator_msgs::msg::EntityStatus & status, std::uint32_t handle)
+    -> void
+  {
+    simulation_api_schema::EntityStatus spawned;
+    simulation_interface::toProto(status, spawned);
+    statuses[status.name] = spawned;
+    handles[handle] = status.name;
+  }
+
+  auto despawn(const std::string & name) -> void
+  {
+    statuses.erase(name);
+    for (auto iter = handles.begin(); iter != handles.end();) {
+      iter = iter->second == name ? handles.erase(iter) : std::next(iter);
+    }
+  }
+
+  auto update(const simulation_api_schema::UpdateEntityStatusDeltaRequest & req) -> void
+  {
+    simulation_interface::applyEntityStatusDelta(
+      req, handles, statuses, [this](auto & status) {
+        if (status.name() == "ego") {
+          ++ego_simulated;
+          status.mutable_pose()->mutable_position()->set_x(status.pose().position().x() + 1.0);
+          return true;
+        } else {
+          return false;
+        }
+      });
+  }
+
+  std::map<std::string, simulation_api_schema::EntityStatus> statuses;
+
+  std::unordered_map<std::uint32_t, std::string> handles;
+
+  int ego_simulated = 0;
+};
+
+auto makeEntityStatus(const std::string & name, double x)
+  -> traffic_simulator_msgs::msg::EntityStatus
+{
+  traffic_simulator_msgs::msg::EntityStatus status;
+  status.name = name;
+  status.pose.position.x = x;
+  status.pose.orientation.w = 1.0;
+  status.action_status.current_action = "idle";
+  return status;
+}
+
+/// @note Kinematic fields of the status kept by the simulator equal the status of the client.
+auto expectEqual(
+  const simulation_api_schema::EntityStatus & proto,
+  const traffic_simulator_msgs::msg::EntityStatus & status, double time) -> void
+{
+  traffic_simulator_msgs::msg::EntityStatus received;
+  simulation_interface::toMsg(proto, received);
+  EXPECT_EQ(received.pose, status.pose) << status.name;
+  EXPECT_EQ(received.action_status.twist, status.action_status.twist) << status.name;
+  EXPECT_EQ(received.action_status.accel, status.action_status.accel) << status.name;
+  EXPECT_EQ(received.action_status.current_action, status.action_status.current_action)
+    << status.name;
+  EXPECT_DOUBLE_EQ(received.action_status.linear_jerk, status.action_status.linear_jerk)
+    << status.name;
+  EXPECT_DOUBLE_EQ(proto.time(), time) << status.name;
+}
+
+TEST(EntityStatusDelta, RoundTrip)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder;
+  Simulator simulator;
+
+  std::map<std::string, traffic_simulator_msgs::msg::EntityStatus> statuses = {
+    {"ego", makeEntityStatus("ego", 0.0)},
+    {"moving", makeEntityStatus("moving", 10.0)},
+    {"still", makeEntityStatus("still", 20.0)},
+  };
+  for (const auto & [name, status] : statuses) {
+    simulator.spawn(status, encoder.getHandle(name));
+  }
+
+  const auto encode = [&](double time) {
+    simulation_api_schema::UpdateEntityStatusDeltaRequest req;
+    req.set_time(time);
+    for (const auto & [name, status] : statuses) {
+      encoder.encode(status, name == "ego", req);
+    }
+    return req;
+  };
+
+  for (int frame = 0; frame < 10; ++frame) {
+    const double time = 0.1 * frame;
+    statuses["moving"].pose.position.x += 1.0;
+    statuses["moving"].action_status.twist.linear.x = frame < 3 ? 5.0 : 10.0;
+    statuses["moving"].action_status.current_action = frame < 5 ? "accelerate" : "cruise";
+    const auto req = encode(time);
+    /// @note the first frame sends everything, then only ego (handle only) and the moving entity
+    ASSERT_EQ(req.status_size(), frame == 0 ? 3 : 2);
+    for (const auto & delta : req.status()) {
+      if (simulator.handles.at(delta.handle()) == "ego") {
+        EXPECT_FALSE(delta.has_pose() or delta.has_twist() or delta.has_accel());
+        EXPECT_FALSE(delta.has_action());
+      } else if (frame != 0) {
+        EXPECT_EQ(simulator.handles.at(delta.handle()), "moving");
+        /// @note only the fields which changed are sent
+        EXPECT_TRUE(delta.has_pose());
+        EXPECT_EQ(delta.has_twist(), frame == 3);
+        EXPECT_FALSE(delta.has_accel());
+        EXPECT_EQ(delta.has_action(), frame == 5);
+      }
+    }
+    simulator.update(req);
+    EXPECT_EQ(simulator.ego_simulated, frame + 1);
+    expectEqual(simulator.statuses.at("moving"), statuses["moving"], time);
+    expectEqual(simulator.statuses.at("still"), statuses["still"], time);
+    EXPECT_DOUBLE_EQ(simulator.statuses.at("ego").pose().position().x(), frame + 1.0);
+    EXPECT_DOUBLE_EQ(simulator.statuses.at("ego").time(), time);
+  }
+
+  /// @note despawn and spawn again with the same name and the status last sent before despawn
+  const auto old_handle = encoder.getHandle("still");
+  encoder.erase("still");
+  simulator.despawn("still");
+  const auto new_handle = encoder.getHandle("still");
+  EXPECT_NE(new_handle, old_handle);
+  auto spawned = statuses["still"];
+  spawned.pose.position.x = 0.0;
+  simulator.spawn(spawned, new_handle);
+
+  /// @note the entity spawned again is sent in full, although its status did not change
+  const auto req = encode(1.0);
+  ASSERT_EQ(req.status_size(), 2);
+  for (const auto & delta : req.status()) {
+    EXPECT_NE(delta.handle(), old_handle);
+    if (delta.handle() != encoder.getHandle("ego")) {
+      EXPECT_EQ(delta.handle(), new_handle);
+      EXPECT_TRUE(delta.has_pose() and delta.has_twist() and delta.has_accel());
+      EXPECT_TRUE(delta.has_action());
+    }
+  }
+  simulator.update(req);
+  expectEqual(simulator.statuses.at("still"), statuses["still"], 1.0);
+  expectEqual(simulator.statuses.at("moving"), statuses["moving"], 1.0);
+}
+
+TEST(EntityStatusDelta, UnknownEntity)
+{
+  simulation_interface::EntityStatusDeltaEncoder encoder;
+  simulation_api_schema::UpdateEntityStatusDeltaRequest req;
+  EXPECT_THROW(
+    encoder.encode(makeEntityStatus("unknown", 0.0), false, req), common::SimulationError);
+  EXPECT_EQ(req.status_size(), 0);
+
+  Simulator simulator;
+  req.add_status()->set_handle(1);
+  EXPECT_THROW(simulator.update(req), common::SemanticError);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
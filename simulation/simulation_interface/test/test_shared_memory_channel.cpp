@@ -0,0 +1,145 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <geometry_msgs.pb.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <scenario_simulator_exception/exception.hpp>
+#include <simulation_interface/shared_memory_channel.hpp>
+#include <string>
+#include <thread>
+
+using simulation_interface::SharedMemoryChannel;
+
+auto channelName() -> std::string
+{
+  return "/simulation_interface_test." + std::to_string(getpid());
+}
+
+TEST(SharedMemoryChannel, RoundTrip)
+{
+  SharedMemoryChannel server(channelName(), SharedMemoryChannel::Role::SERVER, 1024);
+  SharedMemoryChannel client(channelName(), SharedMemoryChannel::Role::CLIENT);
+  std::thread echo([&]() {
+    for (int i = 0; i < 100; ++i) {
+      geometry_msgs::Point request;
+      server.receive(request);
+      request.set_x(request.x() + 1.0);
+      server.send(request);
+    }
+  });
+  for (int i = 0; i < 100; ++i) {
+    geometry_msgs::Point request;
+    request.set_x(i);
+    request.set_y(-i);
+    client.send(request);
+    geometry_msgs::Point response;
+    client.receive(response);
+    EXPECT_DOUBLE_EQ(response.x(), i + 1.0);
+    EXPECT_DOUBLE_EQ(response.y(), -i);
+  }
+  echo.join();
+}
+
+TEST(SharedMemoryChannel, ReceiveTimeout)
+{
+  SharedMemoryChannel server(channelName(), SharedMemoryChannel::Role::SERVER, 1024);
+  geometry_msgs::Point request;
+  EXPECT_FALSE(server.receive(request, std::chrono::milliseconds(1)));
+}
+
+TEST(SharedMemoryChannel, MessageExceedsCapacity)
+{
+  SharedMemoryChannel server(channelName(), SharedMemoryChannel::Role::SERVER, 8);
+  SharedMemoryChannel client(channelName(), SharedMemoryChannel::Role::CLIENT);
+  geometry_msgs::Point request;
+  request.set_x(1.0);
+  request.set_y(2.0);
+  request.set_z(3.0);
+  EXPECT_THROW(client.send(request), common::SimulationError);
+}
+
+auto echo(SharedMemoryChannel & server) -> void
+{
+  geometry_msgs::Point request;
+  server.receive(request);
+  request.set_x(request.x() + 1.0);
+  server.send(request);
+}
+
+/**
+ * @note A client attached to the region of a server which crashed is supposed to move to the region
+ * of the server started after it, and get the response to the request it is waiting for.
+ */
+TEST(SharedMemoryChannel, ServerReplacesCrashedServer)
+{
+  /// @note Never destroyed, so the region is left behind as by a server which crashed.
+  new SharedMemoryChannel(channelName(), SharedMemoryChannel::Role::SERVER, 1024);
+  SharedMemoryChannel client(channelName(), SharedMemoryChannel::Role::CLIENT);
+  geometry_msgs::Point request;
+  request.set_x(1.0);
+  client.send(request);
+  std::thread restart([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    SharedMemoryChannel server(channelName(), SharedMemoryChannel::Role::SERVER, 1024);
+    echo(server);
+    echo(server);
+  });
+  geometry_msgs::Point response;
+  client.receive(response);
+  EXPECT_DOUBLE_EQ(response.x(), 2.0);
+  request.set_x(5.0);
+  client.send(request);
+  client.receive(response);
+  EXPECT_DOUBLE_EQ(response.x(), 6.0);
+  restart.join();
+}
+
+/**
+ * @note A client whose server shut down is supposed to wait for the next server, and send the
+ * request it is waiting on to it.
+ */
+TEST(SharedMemoryChannel, ServerRestarts)
+{
+  SharedMemoryChannel client(channelName(), SharedMemoryChannel::Role::CLIENT);
+  std::thread restart([&]() {
+    {
+      SharedMemoryChannel server(channelName(), SharedMemoryChannel::Role::SERVER, 1024);
+      echo(server);
+      geometry_msgs::Point request;
+      server.receive(request);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    SharedMemoryChannel server(channelName(), SharedMemoryChannel::Role::SERVER, 1024);
+    echo(server);
+  });
+  geometry_msgs::Point request, response;
+  request.set_x(1.0);
+  client.send(request);
+  client.receive(response);
+  EXPECT_DOUBLE_EQ(response.x(), 2.0);
+  request.set_x(3.0);
+  client.send(request);
+  client.receive(response);
+  EXPECT_DOUBLE_EQ(response.x(), 4.0);
+  restart.join();
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
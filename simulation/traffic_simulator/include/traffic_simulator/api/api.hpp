@@ -21,11 +21,13 @@
 #include <autoware_auto_vehicle_msgs/msg/vehicle_state_command.hpp>
 #include <boost/variant.hpp>
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <rclcpp/rclcpp.hpp>
 #include <rosgraph_msgs/msg/clock.hpp>
 #include <simulation_interface/conversions.hpp>
+#include <simulation_interface/entity_status_delta.hpp>
 #include <simulation_interface/zmq_multi_client.hpp>
 #include <stdexcept>
 #include <string>
@@ -135,6 +137,7 @@ public:
         req.set_is_ego(behavior == VehicleBehavior::autoware());
         /// @todo Should be filled from function API
         req.set_initial_speed(0.0);
+        req.set_handle(getEntityHandle(name));
         return zeromq_client_.call(req).result().success();
       }
     };
@@ -170,6 +173,7 @@ public:
         req.mutable_parameters()->set_name(name);
         req.set_asset_key(model3d);
         simulation_interface::toProto(toMapPose(pose), *req.mutable_pose());
+        req.set_handle(getEntityHandle(name));
         return zeromq_client_.call(req).result().success();
       }
     };
@@ -196,6 +200,7 @@ public:
         req.mutable_parameters()->set_name(name);
         req.set_asset_key(model3d);
         simulation_interface::toProto(toMapPose(pose), *req.mutable_pose());
+        req.set_handle(getEntityHandle(name));
         return zeromq_client_.call(req).result().success();
       }
     };
@@ -206,6 +211,18 @@ public:
   bool despawn(const std::string & name);
   bool despawnEntities();
 
+  /**
+   * @brief Spawn a vehicle named name_<n> at the start of lanelet_id every 1 / rate seconds,
+   *        while the previous one is still within its length of the start.
+   * @note The entity objects of despawned vehicles, e.g. by auto_sink, are reused by the next
+   *       spawn instead of being constructed again.
+   */
+  auto addTrafficSource(
+    const std::string & name, const lanelet::Id lanelet_id, const double rate,
+    const traffic_simulator_msgs::msg::VehicleParameters & parameters,
+    const std::string & behavior = VehicleBehavior::defaultBehavior(),
+    const std::string & model3d = "") -> void;
+
   auto setEntityStatus(const std::string & name, const CanonicalizedEntityStatus &) -> void;
   auto setEntityStatus(
     const std::string & name, const geometry_msgs::msg::Pose & map_pose,
@@ -290,6 +307,7 @@ public:
   FORWARD_TO_ENTITY_MANAGER(getBoundingBoxLaneLateralDistance);
   FORWARD_TO_ENTITY_MANAGER(getBoundingBoxLaneLongitudinalDistance);
   FORWARD_TO_ENTITY_MANAGER(getBoundingBoxRelativePose);
+  FORWARD_TO_ENTITY_MANAGER(getCollidingEntities);
   FORWARD_TO_ENTITY_MANAGER(getCurrentAccel);
   FORWARD_TO_ENTITY_MANAGER(getCurrentAction);
   FORWARD_TO_ENTITY_MANAGER(getCurrentTwist);
@@ -348,6 +366,20 @@ private:
 
   bool updateEntitiesStatusInSim();
 
+  bool updateFrameInSim();
+
+  auto makeUpdateFrameRequest() -> simulation_api_schema::UpdateFrameRequest;
+
+  auto makeUpdateEntityStatusRequest() const -> simulation_api_schema::UpdateEntityStatusRequest;
+
+  auto makeUpdateEntityStatusDeltaRequest()
+    -> simulation_api_schema::UpdateEntityStatusDeltaRequest;
+
+  auto applyEntityStatusesFromSim(
+    const google::protobuf::RepeatedPtrField<simulation_api_schema::UpdatedEntityStatus> &) -> void;
+
+  auto getEntityHandle(const std::string & name) -> std::uint32_t;
+
   bool updateTrafficLightsInSim();
 
   const Configuration configuration;
@@ -363,6 +395,12 @@ private:
   SimulationClock clock_;
 
   zeromq::MultiClient zeromq_client_;
+
+  /// @note Handle given to each entity at spawn and the status last sent with it in delta mode.
+  simulation_interface::EntityStatusDeltaEncoder entity_status_delta_encoder_;
+
+  /// @note Traffic lights and time of the previous frame, sent by updateFrameInSim with this one.
+  simulation_api_schema::FrameRequest pending_frame_request_;
 };
 }  // namespace traffic_simulator
 
@@ -38,6 +38,31 @@ struct Configuration
 
   bool standalone_mode = false;
 
+  bool precompute_lanelet_geometry = false;
+
+  /**
+   * @note Run NPC logic of all entities other than ego on a thread pool of EntityManager.
+   *       EntityBase::onUpdate of those entities then runs concurrently, so it may write only to
+   *       its own entity, its behavior plugin and its route planner. Everything else it uses must
+   *       be read-only or guarded during the update: the other entities are seen through the
+   *       EntityStatusTable snapshot, traffic lights are looked up without inserting, HdMapUtils
+   *       keeps its caches under a lock and returns copies of them, and CatmullRomSpline builds
+   *       its lazy curve tree with std::call_once.
+   */
+  bool parallel_npc_logic = false;
+
+  /// @note Send only changed kinematic fields of entities, see UpdateEntityStatusDeltaRequest.
+  bool delta_entity_status_update = false;
+
+  /// @note Send only changed traffic lights and periodic keyframes, see UpdateTrafficLightsRequest.
+  bool delta_traffic_lights_update = false;
+
+  /// @note Send entity status, traffic lights and time to the simulator in one FrameRequest.
+  bool batch_frame_update = false;
+
+  /// @note With batch_frame_update, let the simulator run sensors while the next frame is computed.
+  bool overlap_sensor_simulation = false;
+
   std::string simulator_host = "localhost";
 
   double conventional_traffic_light_publish_rate = 30.0;
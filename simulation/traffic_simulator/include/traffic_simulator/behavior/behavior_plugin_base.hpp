@@ -20,6 +20,7 @@
 #include <traffic_simulator/behavior/follow_trajectory.hpp>
 #include <traffic_simulator/data_type/behavior.hpp>
 #include <traffic_simulator/data_type/entity_status.hpp>
+#include <traffic_simulator/data_type/entity_status_table.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_manager.hpp>
 #include <traffic_simulator_msgs/msg/behavior_parameter.hpp>
@@ -34,14 +35,15 @@
 namespace entity_behavior
 {
 using EntityTypeDict = std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType>;
-using EntityStatusDict =
-  std::unordered_map<std::string, traffic_simulator::CanonicalizedEntityStatus>;
+using EntityStatusDict = traffic_simulator::OtherEntityStatus;
 
 class BehaviorPluginBase
 {
 public:
   virtual ~BehaviorPluginBase() = default;
   virtual void configure(const rclcpp::Logger & logger) = 0;
+  /// @brief Halt the running behavior and clear the request, before the entity is reused.
+  virtual void reset() = 0;
   virtual void update(double current_time, double step_time) = 0;
   virtual const std::string & getCurrentAction() const = 0;
 
@@ -67,7 +69,7 @@ public:
   DEFINE_GETTER_SETTER(OtherEntityStatus,    "other_entity_status",    EntityStatusDict)
   DEFINE_GETTER_SETTER(PedestrianParameters, "pedestrian_parameters",  traffic_simulator_msgs::msg::PedestrianParameters)
   DEFINE_GETTER_SETTER(PolylineTrajectory,   "polyline_trajectory",    std::shared_ptr<traffic_simulator_msgs::msg::PolylineTrajectory>)
-  DEFINE_GETTER_SETTER(ReferenceTrajectory,  "reference_trajectory",   std::shared_ptr<math::geometry::CatmullRomSpline>)
+  DEFINE_GETTER_SETTER(ReferenceTrajectory,  "reference_trajectory",   std::shared_ptr<math::geometry::CatmullRomSplineInterface>)
   DEFINE_GETTER_SETTER(Request,              "request",                traffic_simulator::behavior::Request)
   DEFINE_GETTER_SETTER(RouteLanelets,        "route_lanelets",         lanelet::Ids)
   DEFINE_GETTER_SETTER(StepTime,             "step_time",              double)
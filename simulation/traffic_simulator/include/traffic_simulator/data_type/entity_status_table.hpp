@@ -0,0 +1,192 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_STATUS_TABLE_HPP_
+#define TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_STATUS_TABLE_HPP_
+
+#include <cstdint>
+#include <geometry_msgs/msg/point.hpp>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <traffic_simulator/data_type/entity_status.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace traffic_simulator
+{
+inline namespace entity_status
+{
+/**
+ * @brief Immutable snapshot of every entity status in one frame, shared by all entities.
+ * @note Besides plain lookup by name, entities are indexed by a uniform 2D grid over their map
+ *       position and by the lanelet id of their lanelet pose.
+ */
+class EntityStatusTable
+{
+public:
+  using Statuses = std::unordered_map<std::string, CanonicalizedEntityStatus>;
+
+  using value_type = Statuses::value_type;
+
+  explicit EntityStatusTable(Statuses &&, double grid_cell_size = 20.0);
+
+  /// @note Not copyable nor movable, because the indices point into statuses_ of this object.
+  EntityStatusTable(const EntityStatusTable &) = delete;
+
+  EntityStatusTable(EntityStatusTable &&) = delete;
+
+  auto operator=(const EntityStatusTable &) -> EntityStatusTable & = delete;
+
+  auto operator=(EntityStatusTable &&) -> EntityStatusTable & = delete;
+
+  auto getStatuses() const noexcept -> const Statuses & { return statuses_; }
+
+  /// @brief Entities whose map position lies within radius [m] of point, in unspecified order.
+  auto getEntitiesWithin(const geometry_msgs::msg::Point & point, double radius) const
+    -> std::vector<const value_type *>;
+
+  /// @brief Lane matched entities on any of lanelet_ids, in the order of lanelet_ids.
+  auto getEntitiesOnLanelets(const lanelet::Ids & lanelet_ids) const
+    -> std::vector<const value_type *>;
+
+private:
+  auto getCellKey(std::int64_t x, std::int64_t y) const noexcept -> std::uint64_t;
+
+  auto getCellIndex(double coordinate) const noexcept -> std::int64_t;
+
+  const Statuses statuses_;
+
+  const double grid_cell_size_;
+
+  std::unordered_map<std::uint64_t, std::vector<const value_type *>> grid_;
+
+  std::unordered_map<lanelet::Id, std::vector<const value_type *>> lanelet_index_;
+};
+
+/**
+ * @brief Read-only view of an EntityStatusTable that hides one entity, the owner of the view.
+ * @note Copying a view only copies a shared pointer and a name, never the statuses.
+ */
+class OtherEntityStatus
+{
+public:
+  using value_type = EntityStatusTable::value_type;
+
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = OtherEntityStatus::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    const_iterator() = default;
+
+    /// @note excluded points into the table, not into the view, so the iterator may outlive it.
+    explicit const_iterator(
+      EntityStatusTable::Statuses::const_iterator iter,
+      EntityStatusTable::Statuses::const_iterator end,
+      EntityStatusTable::Statuses::const_iterator excluded)
+    : iter_(iter), end_(end), excluded_(excluded)
+    {
+      skipExcluded();
+    }
+
+    auto operator*() const -> reference { return *iter_; }
+
+    auto operator->() const -> pointer { return &*iter_; }
+
+    auto operator++() -> const_iterator &
+    {
+      ++iter_;
+      skipExcluded();
+      return *this;
+    }
+
+    auto operator++(int) -> const_iterator
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    auto operator==(const const_iterator & other) const { return iter_ == other.iter_; }
+
+    auto operator!=(const const_iterator & other) const { return iter_ != other.iter_; }
+
+  private:
+    auto skipExcluded() -> void
+    {
+      if (iter_ != end_ and iter_ == excluded_) {
+        ++iter_;
+      }
+    }
+
+    EntityStatusTable::Statuses::const_iterator iter_;
+
+    EntityStatusTable::Statuses::const_iterator end_;
+
+    EntityStatusTable::Statuses::const_iterator excluded_;
+  };
+
+  OtherEntityStatus() = default;
+
+  explicit OtherEntityStatus(
+    const std::shared_ptr<const EntityStatusTable> & table, const std::string & excluded_name)
+  : table_(table),
+    excluded_name_(excluded_name),
+    excluded_(
+      table_ ? table_->getStatuses().find(excluded_name_)
+             : EntityStatusTable::Statuses::const_iterator())
+  {
+  }
+
+  auto begin() const -> const_iterator;
+
+  auto end() const -> const_iterator;
+
+  auto find(const std::string & name) const -> const_iterator;
+
+  auto at(const std::string & name) const -> const CanonicalizedEntityStatus &;
+
+  auto count(const std::string & name) const -> std::size_t { return find(name) != end(); }
+
+  auto empty() const -> bool { return begin() == end(); }
+
+  auto size() const -> std::size_t;
+
+  /// @brief Other entities whose map position lies within radius [m] of point.
+  auto getEntitiesWithin(const geometry_msgs::msg::Point & point, double radius) const
+    -> std::vector<const value_type *>;
+
+  /// @brief Other lane matched entities on any of lanelet_ids.
+  auto getEntitiesOnLanelets(const lanelet::Ids & lanelet_ids) const
+    -> std::vector<const value_type *>;
+
+private:
+  auto excluded(const std::vector<const value_type *> &) const -> std::vector<const value_type *>;
+
+  std::shared_ptr<const EntityStatusTable> table_;
+
+  std::string excluded_name_;
+
+  /// @note Entry of excluded_name_ in table_, or the end of table_ if there is none.
+  EntityStatusTable::Statuses::const_iterator excluded_;
+};
+}  // namespace entity_status
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__DATA_TYPE__ENTITY_STATUS_TABLE_HPP_
@@ -15,7 +15,10 @@
 #ifndef TRAFFIC_SIMULATOR__DATA_TYPE__LANELET_POSE_HPP_
 #define TRAFFIC_SIMULATOR__DATA_TYPE__LANELET_POSE_HPP_
 
+#include <memory>
+#include <mutex>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <vector>
 
 namespace traffic_simulator
 {
@@ -23,6 +26,11 @@ using LaneletPose = traffic_simulator_msgs::msg::LaneletPose;
 
 inline namespace lanelet_pose
 {
+/**
+ * @note Only the canonicalized pose is computed on construction. The map pose and the alternative
+ *       lanelet poses are computed on first access and shared by all copies, since most
+ *       CanonicalizedLaneletPose objects built by status updates never read them.
+ */
 class CanonicalizedLaneletPose
 {
 public:
@@ -34,8 +42,8 @@ public:
     const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils,
     const lanelet::Ids & route_lanelets);
   explicit operator LaneletPose() const noexcept { return lanelet_pose_; }
-  explicit operator geometry_msgs::msg::Pose() const noexcept { return map_pose_; }
-  bool hasAlternativeLaneletPose() const { return lanelet_poses_.size() > 1; }
+  explicit operator geometry_msgs::msg::Pose() const { return getMapPose(); }
+  bool hasAlternativeLaneletPose() const { return getLaneletPoses().size() > 1; }
   auto getAlternativeLaneletPoseBaseOnShortestRouteFrom(
     LaneletPose from, const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) const
     -> std::optional<LaneletPose>;
@@ -70,9 +78,23 @@ private:
     const LaneletPose & may_non_canonicalized_lanelet_pose,
     const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils,
     const lanelet::Ids & route_lanelets) -> LaneletPose;
+  static auto isOnItsLanelet(
+    const LaneletPose &, const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) -> bool;
+  auto getLaneletPoses() const -> const std::vector<LaneletPose> &;
+  auto getMapPose() const -> const geometry_msgs::msg::Pose &;
+
+  struct Memo
+  {
+    std::once_flag lanelet_poses_flag;
+    std::vector<LaneletPose> lanelet_poses;
+    std::once_flag map_pose_flag;
+    geometry_msgs::msg::Pose map_pose;
+  };
+
+  const LaneletPose maybe_non_canonicalized_lanelet_pose_;
+  const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_;
   const LaneletPose lanelet_pose_;
-  const std::vector<LaneletPose> lanelet_poses_;
-  const geometry_msgs::msg::Pose map_pose_;
+  const std::shared_ptr<Memo> memo_ = std::make_shared<Memo>();
 };
 }  // namespace lanelet_pose
 
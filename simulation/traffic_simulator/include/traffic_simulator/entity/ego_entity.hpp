@@ -116,7 +116,7 @@ public:
 
   auto setVelocityLimit(double) -> void override;
 
-  auto fillLaneletPose(CanonicalizedEntityStatus & status) -> void override;
+  auto getLaneMatchingParameters() -> LaneMatchingParameters override;
 };
 }  // namespace entity
 }  // namespace traffic_simulator
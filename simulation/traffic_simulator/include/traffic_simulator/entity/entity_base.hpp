@@ -18,6 +18,7 @@
 #include <autoware_auto_control_msgs/msg/ackermann_control_command.hpp>
 #include <autoware_auto_vehicle_msgs/msg/gear_command.hpp>
 #include <concealer/field_operator_application.hpp>
+#include <geometry/spline/composite_spline.hpp>
 #include <memory>
 #include <optional>
 #include <queue>
@@ -25,6 +26,7 @@
 #include <traffic_simulator/behavior/follow_trajectory.hpp>
 #include <traffic_simulator/behavior/longitudinal_speed_planning.hpp>
 #include <traffic_simulator/data_type/entity_status.hpp>
+#include <traffic_simulator/data_type/entity_status_table.hpp>
 #include <traffic_simulator/data_type/lane_change.hpp>
 #include <traffic_simulator/data_type/speed_change.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
@@ -46,6 +48,15 @@ namespace traffic_simulator
 {
 namespace entity
 {
+/// @brief How the lanelet pose of an entity is matched to its map pose, see fillLaneletPose.
+struct LaneMatchingParameters
+{
+  /// @note Unique lanelets of the route of the entity, tried before the lanelets around it.
+  lanelet::Ids route_lanelets;
+
+  bool include_crosswalk = false;
+};
+
 class EntityBase
 {
 public:
@@ -133,7 +144,9 @@ public:
 
   virtual auto getRouteLanelets(double horizon = 100) -> lanelet::Ids = 0;
 
-  virtual auto fillLaneletPose(CanonicalizedEntityStatus & status) -> void = 0;
+  virtual auto getLaneMatchingParameters() -> LaneMatchingParameters = 0;
+
+  /*   */ auto fillLaneletPose(CanonicalizedEntityStatus & status) -> void;
 
   virtual auto getWaypoints() -> const traffic_simulator_msgs::msg::WaypointsArray = 0;
 
@@ -141,6 +154,13 @@ public:
 
   virtual void onPostUpdate(double current_time, double step_time);
 
+  /**
+   * @brief Bring a despawned entity back to the state it had right after construction.
+   * @note Called by EntityManager to reuse the entity object instead of constructing a new one.
+   *       The name of entity_status must be the name of this entity.
+   */
+  virtual void reset(const CanonicalizedEntityStatus & entity_status);
+
   /*   */ void resetDynamicConstraints();
 
   virtual void requestAcquirePosition(const CanonicalizedLaneletPose &) = 0;
@@ -194,7 +214,7 @@ public:
   /*   */ void setEntityTypeList(
     const std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType> &);
 
-  /*   */ void setOtherStatus(const std::unordered_map<std::string, CanonicalizedEntityStatus> &);
+  /*   */ void setOtherStatus(const std::shared_ptr<const EntityStatusTable> &);
 
   virtual auto setStatus(const CanonicalizedEntityStatus &) -> void;
 
@@ -221,14 +241,23 @@ public:
 
   /*   */ auto updateTraveledDistance(const double step_time) -> double;
 
-  virtual auto fillLaneletPose(CanonicalizedEntityStatus & status, bool include_crosswalk)
-    -> void final;
+  /// @note Fill status with a lanelet pose already matched by the caller, e.g. in a batch.
+  /*   */ auto fillLaneletPose(
+    CanonicalizedEntityStatus & status,
+    const std::optional<traffic_simulator_msgs::msg::LaneletPose> & lanelet_pose) const -> void;
 
   const std::string name;
 
   bool verbose;
 
 protected:
+  /**
+   * @brief Update reference_path_ to follow route_lanelets.
+   * @note The center line splines of lanelets kept from the previous route are reused, only the
+   *       lanelets entering or leaving the route are appended or dropped at the ends.
+   */
+  /*   */ auto updateReferencePath(const lanelet::Ids & route_lanelets) -> void;
+
   CanonicalizedEntityStatus status_;
 
   CanonicalizedEntityStatus status_before_update_;
@@ -240,7 +269,7 @@ protected:
   double stand_still_duration_ = 0.0;
   double traveled_distance_ = 0.0;
 
-  std::unordered_map<std::string, CanonicalizedEntityStatus> other_status_;
+  OtherEntityStatus other_status_;
   std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType> entity_type_list_;
 
   std::optional<double> target_speed_;
@@ -249,6 +278,11 @@ protected:
   std::unique_ptr<traffic_simulator::longitudinal_speed_planning::LongitudinalSpeedPlanner>
     speed_planner_;
 
+  /// @note Shared with the behavior plugin, so it is replaced, never modified in place.
+  std::shared_ptr<math::geometry::CompositeSpline> reference_path_;
+
+  lanelet::Ids reference_path_lanelets_;
+
 private:
   virtual auto requestSpeedChangeWithConstantAcceleration(
     const double target_speed, const speed_change::Transition, double acceleration,
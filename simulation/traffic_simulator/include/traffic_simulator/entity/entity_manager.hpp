@@ -38,6 +38,7 @@
 #include <traffic_simulator/entity/pedestrian_entity.hpp>
 #include <traffic_simulator/entity/vehicle_entity.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/helper/thread_pool.hpp>
 #include <traffic_simulator/traffic/traffic_sink.hpp>
 #include <traffic_simulator/traffic_lights/configurable_rate_updater.hpp>
 #include <traffic_simulator/traffic_lights/traffic_light_marker_publisher.hpp>
@@ -48,6 +49,7 @@
 #include <traffic_simulator_msgs/msg/vehicle_parameters.hpp>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
@@ -93,6 +95,12 @@ class EntityManager
 
   std::unordered_map<std::string, std::unique_ptr<traffic_simulator::entity::EntityBase>> entities_;
 
+  /// @note Despawned entities of pooled_entity_names_, moved here from entities_ by node handle.
+  std::unordered_map<std::string, std::unique_ptr<traffic_simulator::entity::EntityBase>>
+    entity_pool_;
+
+  std::unordered_set<std::string> pooled_entity_names_;
+
   double step_time_;
 
   double current_time_;
@@ -119,6 +127,12 @@ class EntityManager
   const std::shared_ptr<TrafficLightPublisherBase> v2i_traffic_light_publisher_ptr_;
   ConfigurableRateUpdater v2i_traffic_light_updater_, conventional_traffic_light_updater_;
 
+  /**
+   * @note Runs the NPC logic with Configuration::parallel_npc_logic. It is not
+   *       helper::ThreadPool::shared(), so the NPC logic can still use that pool for its queries.
+   */
+  const std::unique_ptr<helper::ThreadPool> npc_logic_thread_pool_;
+
 public:
   template <typename Node>
   auto getOrigin(Node & node) const
@@ -170,7 +184,8 @@ public:
       node, "lanelet/marker", LaneletMarkerQoS(),
       rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
     hdmap_utils_ptr_(std::make_shared<hdmap_utils::HdMapUtils>(
-      configuration.lanelet2_map_path(), getOrigin(*node))),
+      configuration.lanelet2_map_path(), getOrigin(*node),
+      configuration.precompute_lanelet_geometry)),
     markers_raw_(hdmap_utils_ptr_->generateMarker()),
     conventional_traffic_light_manager_ptr_(
       std::make_shared<TrafficLightManager>(hdmap_utils_ptr_)),
@@ -189,7 +204,9 @@ public:
           clock_ptr_->now(), v2i_traffic_light_manager_ptr_->generateUpdateTrafficLightsRequest());
       }),
     conventional_traffic_light_updater_(
-      node, [this]() { conventional_traffic_light_marker_publisher_ptr_->publish(); })
+      node, [this]() { conventional_traffic_light_marker_publisher_ptr_->publish(); }),
+    npc_logic_thread_pool_(
+      configuration.parallel_npc_logic ? std::make_unique<helper::ThreadPool>() : nullptr)
   {
     updateHdmapMarker();
   }
@@ -216,9 +233,9 @@ public:
 
 #undef FORWARD_GETTER_TO_TRAFFIC_LIGHT_MANAGER
 
-  auto generateUpdateRequestForConventionalTrafficLights()
+  auto generateUpdateRequestForConventionalTrafficLights(const bool delta)
   {
-    return conventional_traffic_light_manager_ptr_->generateUpdateTrafficLightsRequest();
+    return conventional_traffic_light_manager_ptr_->generateUpdateTrafficLightsDelta(delta);
   }
 
   auto resetConventionalTrafficLightPublishRate(double rate) -> void
@@ -297,8 +314,6 @@ public:
 
   visualization_msgs::msg::MarkerArray makeDebugMarker() const;
 
-  bool trafficLightsChanged();
-
   void requestSpeedChange(const std::string & name, double target_speed, bool continuous);
 
   void requestSpeedChange(
@@ -319,6 +334,10 @@ public:
     const std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType> & type_list)
     -> const CanonicalizedEntityStatus &;
 
+  auto updateNpcLogicInParallel(
+    const std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType> & type_list)
+    -> std::unordered_map<std::string, CanonicalizedEntityStatus>;
+
   void broadcastEntityTransform();
 
   void broadcastTransform(
@@ -326,10 +345,20 @@ public:
 
   bool checkCollision(const std::string & name0, const std::string & name1);
 
+  /**
+   * @brief Every pair of colliding entities, each pair once, by the same test as checkCollision.
+   * @note Checks all entities at once, which is much cheaper than checkCollision for every pair.
+   */
+  auto getCollidingEntities() const -> std::vector<std::pair<std::string, std::string>>;
+
+  /// @note Entities of names passed to poolEntityOnDespawn are kept to be reused by spawnEntity.
   bool despawnEntity(const std::string & name);
 
   bool entityExists(const std::string & name);
 
+  auto fillLaneletPoses(std::vector<std::pair<std::string, CanonicalizedEntityStatus>> &) const
+    -> void;
+
   auto getBoundingBoxDistance(const std::string & from, const std::string & to)
     -> std::optional<double>;
 
@@ -432,6 +461,13 @@ public:
 
   bool isStopping(const std::string & name) const;
 
+  /**
+   * @brief Keep the entity object of name when it is despawned, so the next spawnEntity of name
+   *        resets and reuses it instead of constructing a new entity, behavior plugin and route
+   *        planner. Only VehicleEntity is reused, and only with the same behavior plugin.
+   */
+  auto poolEntityOnDespawn(const std::string & name) -> void;
+
   bool reachPosition(
     const std::string & name, const geometry_msgs::msg::Pose & target_pose,
     const double tolerance) const;
@@ -505,20 +541,33 @@ public:
       return CanonicalizedEntityStatus(entity_status, hdmap_utils_ptr_);
     };
 
-    if (const auto [iter, success] = entities_.emplace(
-          name, std::make_unique<Entity>(
-                  name, makeEntityStatus(), hdmap_utils_ptr_, parameters,
-                  std::forward<decltype(xs)>(xs)...));
-        success) {
+    auto activate = [&](auto & entity) {
       // FIXME: this ignores V2I traffic lights
-      iter->second->setTrafficLightManager(conventional_traffic_light_manager_ptr_);
+      entity.setTrafficLightManager(conventional_traffic_light_manager_ptr_);
       if (npc_logic_started_ && not isEgo(name)) {
-        iter->second->startNpcLogic();
+        entity.startNpcLogic();
       }
-      return success;
-    } else {
+      return true;
+    };
+
+    if (entities_.count(name)) {
       THROW_SEMANTIC_ERROR("Entity ", std::quoted(name), " is already exists.");
+    } else if (auto node = entity_pool_.extract(name)) {
+      /// @note Reuse the entity object kept by despawnEntity, unless it cannot be reset to Entity.
+      if constexpr (std::is_same_v<std::decay_t<Entity>, VehicleEntity>) {
+        if (auto entity = dynamic_cast<VehicleEntity *>(node.mapped().get());
+            entity and entity->reset(makeEntityStatus(), parameters, xs...)) {
+          return activate(*entities_.insert(std::move(node)).position->second);
+        }
+      }
     }
+    return activate(
+      *entities_
+         .emplace(
+           name, std::make_unique<Entity>(
+                   name, makeEntityStatus(), hdmap_utils_ptr_, parameters,
+                   std::forward<decltype(xs)>(xs)...))
+         .first->second);
   }
 
   auto toMapPose(const CanonicalizedLaneletPose &) const -> const geometry_msgs::msg::Pose;
@@ -115,7 +115,7 @@ public:
 
   auto getWaypoints() -> const traffic_simulator_msgs::msg::WaypointsArray override;
 
-  auto fillLaneletPose(CanonicalizedEntityStatus & status) -> void override;
+  auto getLaneMatchingParameters() -> LaneMatchingParameters override;
 
   const std::string plugin_name;
 
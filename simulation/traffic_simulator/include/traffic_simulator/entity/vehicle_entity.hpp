@@ -107,6 +107,17 @@ public:
 
   void requestLaneChange(const traffic_simulator::lane_change::Parameter &) override;
 
+  void reset(const CanonicalizedEntityStatus &) override;
+
+  /**
+   * @brief Reset this despawned entity to reuse it as if constructed with these arguments.
+   * @return false if the entity runs another behavior plugin than plugin_name, so it cannot be
+   *         reused and has not been reset.
+   */
+  auto reset(
+    const CanonicalizedEntityStatus &, const traffic_simulator_msgs::msg::VehicleParameters &,
+    const std::string & plugin_name = BuiltinBehavior::defaultBehavior()) -> bool;
+
   void setAccelerationLimit(double acceleration) override;
 
   void setAccelerationRateLimit(double acceleration_rate) override;
@@ -120,7 +131,9 @@ public:
   void setTrafficLightManager(
     const std::shared_ptr<traffic_simulator::TrafficLightManager> &) override;
 
-  auto fillLaneletPose(CanonicalizedEntityStatus & status) -> void override;
+  auto getLaneMatchingParameters() -> LaneMatchingParameters override;
+
+  const std::string plugin_name;
 
 private:
   pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase> loader_;
@@ -128,10 +141,6 @@ private:
   const std::shared_ptr<entity_behavior::BehaviorPluginBase> behavior_plugin_ptr_;
 
   traffic_simulator::RoutePlanner route_planner_;
-
-  std::shared_ptr<math::geometry::CatmullRomSpline> spline_;
-
-  lanelet::Ids previous_route_lanelets_;
 };
 }  // namespace entity
 }  // namespace traffic_simulator
@@ -15,8 +15,13 @@
 #ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__CACHE_HPP_
 #define TRAFFIC_SIMULATOR__HDMAP_UTILS__CACHE_HPP_
 
+#include <algorithm>
+#include <cstdint>
 #include <geometry/spline/catmull_rom_spline.hpp>
 #include <geometry_msgs/msg/point.hpp>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <scenario_simulator_exception/exception.hpp>
@@ -37,7 +42,8 @@ public:
     return data_.find(key) != data_.end();
   }
 
-  auto getRoute(lanelet::Id from, lanelet::Id to) -> decltype(auto)
+  /// @note Returns a copy made under the lock, as appendData may overwrite the route.
+  auto getRoute(lanelet::Id from, lanelet::Id to) -> lanelet::Ids
   {
     if (!exists(from, to)) {
       THROW_SIMULATION_ERROR(
@@ -69,7 +75,7 @@ public:
     return data_.find(lanelet_id) != data_.end();
   }
 
-  auto getCenterPoints(lanelet::Id lanelet_id) -> decltype(auto)
+  auto getCenterPoints(lanelet::Id lanelet_id) -> std::vector<geometry_msgs::msg::Point>
   {
     if (!exists(lanelet_id)) {
       THROW_SIMULATION_ERROR("center point of : ", lanelet_id, " does not exists on route cache.");
@@ -78,13 +84,14 @@ public:
     return data_.at(lanelet_id);
   }
 
-  auto getCenterPointsSpline(lanelet::Id lanelet_id) -> decltype(auto)
+  auto getCenterPointsSpline(lanelet::Id lanelet_id)
+    -> std::shared_ptr<math::geometry::CatmullRomSpline>
   {
     if (!exists(lanelet_id)) {
       THROW_SIMULATION_ERROR("center point of : ", lanelet_id, " does not exists on route cache.");
     }
     std::lock_guard<std::mutex> lock(mutex_);
-    return splines_[lanelet_id];
+    return splines_.at(lanelet_id);
   }
 
   auto appendData(lanelet::Id lanelet_id, const std::vector<geometry_msgs::msg::Point> & route)
@@ -111,13 +118,13 @@ public:
     return data_.find(lanelet_id) != data_.end();
   }
 
-  auto getLength(lanelet::Id lanelet_id)
+  auto getLength(lanelet::Id lanelet_id) -> double
   {
     if (!exists(lanelet_id)) {
       THROW_SIMULATION_ERROR("length of : ", lanelet_id, " does not exists on route cache.");
     }
     std::lock_guard<std::mutex> lock(mutex_);
-    return data_[lanelet_id];
+    return data_.at(lanelet_id);
   }
 
   auto appendData(lanelet::Id lanelet_id, double length)
@@ -131,6 +138,207 @@ private:
 
   std::mutex mutex_;
 };
+
+/**
+ * @brief Immutable map from lanelet id to its position in a sorted list of lanelet ids.
+ * @note Lookup is a direct array access when lanelet ids are dense enough and a binary search over
+ *       the sorted ids otherwise.
+ */
+class LaneletIndex
+{
+public:
+  static constexpr auto npos = std::numeric_limits<std::size_t>::max();
+
+  LaneletIndex() = default;
+
+  explicit LaneletIndex(std::vector<lanelet::Id> && sorted_ids) : ids_(std::move(sorted_ids))
+  {
+    if (not ids_.empty()) {
+      minimum_id_ = ids_.front();
+      if (const auto range = static_cast<std::size_t>(ids_.back() - minimum_id_) + 1;
+          range <= maximum_dense_index_ratio * ids_.size()) {
+        dense_index_.assign(range, -1);
+        for (std::size_t i = 0; i < ids_.size(); ++i) {
+          dense_index_[ids_[i] - minimum_id_] = static_cast<std::int32_t>(i);
+        }
+      }
+    }
+  }
+
+  auto find(lanelet::Id lanelet_id) const noexcept -> std::size_t
+  {
+    if (ids_.empty() or lanelet_id < minimum_id_) {
+      return npos;
+    } else if (not dense_index_.empty()) {
+      if (const auto offset = static_cast<std::size_t>(lanelet_id - minimum_id_);
+          offset < dense_index_.size() and dense_index_[offset] != -1) {
+        return dense_index_[offset];
+      } else {
+        return npos;
+      }
+    } else if (const auto iter = std::lower_bound(ids_.begin(), ids_.end(), lanelet_id);
+               iter != ids_.end() and *iter == lanelet_id) {
+      return std::distance(ids_.begin(), iter);
+    } else {
+      return npos;
+    }
+  }
+
+private:
+  /// @note Dense indexing is used while it costs at most this many slots per lanelet.
+  static constexpr std::size_t maximum_dense_index_ratio = 16;
+
+  std::vector<lanelet::Id> ids_;
+
+  lanelet::Id minimum_id_ = 0;
+
+  std::vector<std::int32_t> dense_index_;
+};
+
+/**
+ * @brief Immutable per-lanelet center points, spline and length computed once at map load.
+ * @note Unlike the caches above, this table is never modified after construction, so concurrent
+ *       readers need no lock.
+ */
+class LaneletGeometryTable
+{
+public:
+  struct Entry
+  {
+    lanelet::Id lanelet_id;
+    std::vector<geometry_msgs::msg::Point> center_points;
+    std::shared_ptr<math::geometry::CatmullRomSpline> spline;
+    double length;
+  };
+
+  LaneletGeometryTable() = default;
+
+  explicit LaneletGeometryTable(std::vector<Entry> && entries) : entries_(std::move(entries))
+  {
+    std::sort(entries_.begin(), entries_.end(), [](const auto & lhs, const auto & rhs) {
+      return lhs.lanelet_id < rhs.lanelet_id;
+    });
+    std::vector<lanelet::Id> ids;
+    ids.reserve(entries_.size());
+    for (const auto & entry : entries_) {
+      ids.push_back(entry.lanelet_id);
+    }
+    index_ = LaneletIndex(std::move(ids));
+  }
+
+  auto empty() const noexcept { return entries_.empty(); }
+
+  auto size() const noexcept { return entries_.size(); }
+
+  auto find(lanelet::Id lanelet_id) const noexcept -> const Entry *
+  {
+    if (const auto i = index_.find(lanelet_id); i != LaneletIndex::npos) {
+      return &entries_[i];
+    } else {
+      return nullptr;
+    }
+  }
+
+private:
+  std::vector<Entry> entries_;
+
+  LaneletIndex index_;
+};
+
+/// @brief Non-owning view of contiguous lanelet ids, valid as long as the HdMapUtils it came from.
+class LaneletIdsView
+{
+public:
+  using value_type = lanelet::Id;
+  using const_iterator = const lanelet::Id *;
+  using iterator = const_iterator;
+
+  LaneletIdsView() = default;
+
+  explicit LaneletIdsView(const lanelet::Id * begin, const lanelet::Id * end) noexcept
+  : begin_(begin), end_(end)
+  {
+  }
+
+  auto begin() const noexcept -> const_iterator { return begin_; }
+
+  auto end() const noexcept -> const_iterator { return end_; }
+
+  auto empty() const noexcept { return begin_ == end_; }
+
+  auto size() const noexcept { return static_cast<std::size_t>(end_ - begin_); }
+
+  auto operator[](std::size_t i) const noexcept -> lanelet::Id { return begin_[i]; }
+
+  operator lanelet::Ids() const { return lanelet::Ids(begin_, end_); }
+
+  friend auto operator==(const LaneletIdsView & lhs, const LaneletIdsView & rhs) -> bool
+  {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  friend auto operator+=(lanelet::Ids & ids, const LaneletIdsView & view) -> lanelet::Ids &
+  {
+    ids.insert(ids.end(), view.begin(), view.end());
+    return ids;
+  }
+
+private:
+  const lanelet::Id * begin_ = nullptr;
+
+  const lanelet::Id * end_ = nullptr;
+};
+
+/**
+ * @brief Immutable adjacency of lanelets in compressed sparse row form, built once at map load.
+ * @note Lanelets adjacent to every lanelet are stored back to back in one array, so a query is an
+ *       index lookup returning a view into that array, without allocation or routing graph access.
+ */
+class LaneletAdjacencyTable
+{
+public:
+  LaneletAdjacencyTable() = default;
+
+  explicit LaneletAdjacencyTable(std::vector<std::pair<lanelet::Id, lanelet::Ids>> && rows)
+  {
+    std::sort(rows.begin(), rows.end(), [](const auto & lhs, const auto & rhs) {
+      return lhs.first < rhs.first;
+    });
+    std::vector<lanelet::Id> ids;
+    ids.reserve(rows.size());
+    offsets_.reserve(rows.size() + 1);
+    offsets_.push_back(0);
+    for (const auto & [lanelet_id, adjacent_ids] : rows) {
+      ids.push_back(lanelet_id);
+      adjacent_ids_.insert(adjacent_ids_.end(), adjacent_ids.begin(), adjacent_ids.end());
+      offsets_.push_back(adjacent_ids_.size());
+    }
+    index_ = LaneletIndex(std::move(ids));
+  }
+
+  auto contains(lanelet::Id lanelet_id) const noexcept
+  {
+    return index_.find(lanelet_id) != LaneletIndex::npos;
+  }
+
+  /// @brief Lanelets adjacent to lanelet_id, empty if lanelet_id is not in the table.
+  auto find(lanelet::Id lanelet_id) const noexcept -> LaneletIdsView
+  {
+    if (const auto i = index_.find(lanelet_id); i != LaneletIndex::npos) {
+      return LaneletIdsView(
+        adjacent_ids_.data() + offsets_[i], adjacent_ids_.data() + offsets_[i + 1]);
+    } else {
+      return LaneletIdsView();
+    }
+  }
+
+private:
+  LaneletIndex index_;
+
+  std::vector<std::size_t> offsets_;
+
+  std::vector<lanelet::Id> adjacent_ids_;
+};
 }  // namespace hdmap_utils
 
 #endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__CACHE_HPP_
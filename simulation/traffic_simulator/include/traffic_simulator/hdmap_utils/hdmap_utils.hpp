@@ -28,6 +28,7 @@
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 #include <tf2/LinearMath/Matrix3x3.h>
 
+#include <algorithm>
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
 #include <boost/filesystem.hpp>
 #include <geographic_msgs/msg/geo_point.hpp>
@@ -46,6 +47,7 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #include <traffic_simulator/data_type/lane_change.hpp>
 #include <traffic_simulator/hdmap_utils/cache.hpp>
+#include <traffic_simulator/hdmap_utils/map_snapshot.hpp>
 #include <traffic_simulator_msgs/msg/bounding_box.hpp>
 #include <traffic_simulator_msgs/msg/entity_status.hpp>
 #include <tuple>
@@ -58,10 +60,30 @@ namespace hdmap_utils
 {
 enum class LaneletType { LANE, CROSSWALK };
 
+/// @brief Lanelets conflicting with any lanelet of a route, each sorted and unique.
+struct RouteConflicts
+{
+  lanelet::Ids lanes;
+
+  lanelet::Ids crosswalks;
+
+  auto containsLane(lanelet::Id lanelet_id) const -> bool
+  {
+    return std::binary_search(lanes.begin(), lanes.end(), lanelet_id);
+  }
+
+  auto containsCrosswalk(lanelet::Id lanelet_id) const -> bool
+  {
+    return std::binary_search(crosswalks.begin(), crosswalks.end(), lanelet_id);
+  }
+};
+
 class HdMapUtils
 {
 public:
-  explicit HdMapUtils(const boost::filesystem::path &, const geographic_msgs::msg::GeoPoint &);
+  explicit HdMapUtils(
+    const boost::filesystem::path &, const geographic_msgs::msg::GeoPoint &,
+    bool precompute_lanelet_geometry = false);
 
   auto canChangeLane(lanelet::Id from, lanelet::Id to) const -> bool;
 
@@ -162,6 +184,8 @@ public:
 
   auto getLaneletLength(lanelet::Id) const -> double;
 
+  auto getLaneletMap() const -> lanelet::LaneletMapConstPtr { return lanelet_map_ptr_; }
+
   auto getLaneletPolygon(lanelet::Id) const -> std::vector<geometry_msgs::msg::Point>;
 
   auto getLateralDistance(
@@ -172,7 +196,7 @@ public:
 
   auto getLeftLaneletIds(
     lanelet::Id, traffic_simulator_msgs::msg::EntityType,
-    bool include_opposite_direction = true) const -> lanelet::Ids;
+    bool include_opposite_direction = true) const -> LaneletIdsView;
 
   auto getLongitudinalDistance(
     const traffic_simulator_msgs::msg::LaneletPose & from,
@@ -191,18 +215,19 @@ public:
   auto getNextLaneletIds(const lanelet::Ids &, const std::string & turn_direction) const
     -> lanelet::Ids;
 
-  auto getNextLaneletIds(lanelet::Id) const -> lanelet::Ids;
+  auto getNextLaneletIds(lanelet::Id) const -> LaneletIdsView;
 
-  auto getNextLaneletIds(lanelet::Id, const std::string & turn_direction) const -> lanelet::Ids;
+  auto getNextLaneletIds(lanelet::Id, const std::string & turn_direction) const -> LaneletIdsView;
 
   auto getPreviousLaneletIds(const lanelet::Ids &) const -> lanelet::Ids;
 
   auto getPreviousLaneletIds(const lanelet::Ids &, const std::string & turn_direction) const
     -> lanelet::Ids;
 
-  auto getPreviousLaneletIds(lanelet::Id) const -> lanelet::Ids;
+  auto getPreviousLaneletIds(lanelet::Id) const -> LaneletIdsView;
 
-  auto getPreviousLaneletIds(lanelet::Id, const std::string & turn_direction) const -> lanelet::Ids;
+  auto getPreviousLaneletIds(lanelet::Id, const std::string & turn_direction) const
+    -> LaneletIdsView;
 
   auto getPreviousLanelets(lanelet::Id, double distance = 100) const -> lanelet::Ids;
 
@@ -210,15 +235,18 @@ public:
 
   auto getRightLaneletIds(
     lanelet::Id, traffic_simulator_msgs::msg::EntityType,
-    bool include_opposite_direction = true) const -> lanelet::Ids;
+    bool include_opposite_direction = true) const -> LaneletIdsView;
 
   auto getRightOfWayLaneletIds(const lanelet::Ids &) const
     -> std::unordered_map<lanelet::Id, lanelet::Ids>;
 
-  auto getRightOfWayLaneletIds(lanelet::Id) const -> lanelet::Ids;
+  auto getRightOfWayLaneletIds(lanelet::Id) const -> LaneletIdsView;
 
   auto getRoute(lanelet::Id from, lanelet::Id to) const -> lanelet::Ids;
 
+  /// @brief Conflicting lanes and crosswalks of a whole route, looked up in one pass.
+  auto getRouteConflicts(const lanelet::Ids & route_lanelets) const -> RouteConflicts;
+
   auto getSpeedLimit(const lanelet::Ids &) const -> double;
 
   auto getStopLineIdsOnPath(const lanelet::Ids & route_lanelets) const -> lanelet::Ids;
@@ -280,6 +308,18 @@ public:
     bool include_opposite_direction = true) const
     -> std::vector<traffic_simulator_msgs::msg::LaneletPose>;
 
+  /**
+   * @brief Match many entity poses to lanelets at once.
+   * @note Equivalent to calling toLaneletPose(pose, bounding_box, include_crosswalk) for each
+   *       element, but candidate lanelets are shared between queries matched to the same lanelet
+   *       and spline projections run in parallel on the shared thread pool.
+   */
+  auto toLaneletPoses(
+    const std::vector<
+      std::pair<geometry_msgs::msg::Pose, traffic_simulator_msgs::msg::BoundingBox>> &,
+    bool include_crosswalk, double matching_distance = 1.0) const
+    -> std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>>;
+
   auto toMapBin() const -> autoware_auto_mapping_msgs::msg::HADMapBin;
 
   auto toMapPoints(lanelet::Id, const std::vector<double> & s) const
@@ -288,6 +328,9 @@ public:
   auto toMapPose(const traffic_simulator_msgs::msg::LaneletPose &) const
     -> geometry_msgs::msg::PoseStamped;
 
+  /// @brief Compile the loaded map into a snapshot, see compile_lanelet2_map.
+  auto writeMapSnapshot(const boost::filesystem::path & snapshot_path) const -> void;
+
 private:
   /** @defgroup cache
    *  Declared mutable for caching
@@ -298,6 +341,38 @@ private:
   mutable LaneletLengthCache lanelet_length_cache_;
   // @}
 
+  /// @note Filled in the constructor only if precompute_lanelet_geometry is true, read-only after.
+  LaneletGeometryTable lanelet_geometry_table_;
+
+  const boost::filesystem::path lanelet2_map_path_;
+
+  /// @note Kept mapped while the map is in use, lanelet lengths are read from it in place.
+  std::unique_ptr<const MapSnapshot> map_snapshot_;
+
+  /** @defgroup adjacency
+   *  Built from the routing graphs and regulatory elements in the constructor, read-only after
+   */
+  // @{
+  LaneletAdjacencyTable next_lanelet_ids_;
+  LaneletAdjacencyTable previous_lanelet_ids_;
+  std::unordered_map<std::string, LaneletAdjacencyTable> next_lanelet_ids_by_turn_direction_;
+  std::unordered_map<std::string, LaneletAdjacencyTable> previous_lanelet_ids_by_turn_direction_;
+
+  struct SideLaneletIds
+  {
+    LaneletAdjacencyTable lefts;
+    LaneletAdjacencyTable adjacent_lefts;
+    LaneletAdjacencyTable rights;
+    LaneletAdjacencyTable adjacent_rights;
+  };
+  SideLaneletIds vehicle_side_lanelet_ids_;
+  SideLaneletIds pedestrian_side_lanelet_ids_;
+
+  LaneletAdjacencyTable conflicting_lane_ids_;
+  LaneletAdjacencyTable conflicting_crosswalk_ids_;
+  LaneletAdjacencyTable right_of_way_lanelet_ids_;
+  // @}
+
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::routing::RoutingGraphConstPtr vehicle_routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_vehicle_ptr_;
@@ -323,8 +398,14 @@ private:
     const std::vector<double> & x, const std::vector<double> & y,
     const std::vector<double> & z) const -> std::vector<double>;
 
+  auto buildLaneletAdjacencyTables() -> void;
+
+  auto buildLaneletConflictTables() -> void;
+
   auto calculateAccumulatedLengths(const lanelet::ConstLineString3d &) const -> std::vector<double>;
 
+  auto calculateCenterPoints(lanelet::Id) const -> std::vector<geometry_msgs::msg::Point>;
+
   auto calculateSegmentDistances(const lanelet::ConstLineString3d &) const -> std::vector<double>;
 
   auto excludeSubtypeLanelets(
@@ -333,6 +414,8 @@ private:
 
   auto filterLanelets(const lanelet::Lanelets &, const char subtype[]) const -> lanelet::Lanelets;
 
+  auto findAdjacentLaneletIds(const LaneletAdjacencyTable &, lanelet::Id) const -> LaneletIdsView;
+
   auto findNearestIndexPair(
     const std::vector<double> & accumulated_lengths, const double target_length) const
     -> std::pair<std::size_t, std::size_t>;
@@ -369,6 +452,8 @@ private:
 
   auto overwriteLaneletsCenterline() -> void;
 
+  auto precomputeLaneletGeometry() -> void;
+
   auto resamplePoints(const lanelet::ConstLineString3d &, const std::int32_t num_segments) const
     -> lanelet::BasicPoints3d;
 
@@ -0,0 +1,96 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HDMAP_UTILS__MAP_SNAPSHOT_HPP_
+#define TRAFFIC_SIMULATOR__HDMAP_UTILS__MAP_SNAPSHOT_HPP_
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <boost/filesystem.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace hdmap_utils
+{
+/**
+ * @brief Read-only, memory mapped binary snapshot of a lanelet2 map compiled for HdMapUtils.
+ * @note The snapshot holds the map already projected by MGRSProjector and with fine centerlines,
+ *       so loading it skips parsing the .osm file, projecting every point and resampling every
+ *       centerline. It also holds the 2D length of every lanelet as a table sorted by lanelet id,
+ *       which is read in place from the mapping. A snapshot is only used if it was written by the
+ *       same snapshot version from an .osm file with the same content hash, otherwise HdMapUtils
+ *       silently falls back to loading the .osm file.
+ */
+class MapSnapshot
+{
+public:
+  static constexpr std::uint32_t version = 1;
+
+  struct LaneletLength
+  {
+    lanelet::Id lanelet_id;
+    double length;
+  };
+
+  ~MapSnapshot();
+
+  MapSnapshot(const MapSnapshot &) = delete;
+
+  auto operator=(const MapSnapshot &) -> MapSnapshot & = delete;
+
+  /// @brief Default location of the snapshot of lanelet2_map_path, next to it as .snapshot
+  static auto getPath(const boost::filesystem::path & lanelet2_map_path) -> boost::filesystem::path;
+
+  /// @brief 64 bit FNV-1a hash of the content of lanelet2_map_path.
+  static auto hash(const boost::filesystem::path & lanelet2_map_path) -> std::uint64_t;
+
+  /**
+   * @brief Map snapshot_path if it is a snapshot of the current version of lanelet2_map_path.
+   * @return nullptr if the snapshot does not exist, is of another version or is out of date.
+   */
+  static auto open(
+    const boost::filesystem::path & snapshot_path,
+    const boost::filesystem::path & lanelet2_map_path) -> std::unique_ptr<const MapSnapshot>;
+
+  /**
+   * @brief Write the snapshot of lanelet_map, which was loaded from lanelet2_map_path.
+   * @note The snapshot is written to a temporary file first and renamed into place, so processes
+   *       opening snapshot_path at the same time never see a partially written snapshot.
+   */
+  static auto write(
+    const boost::filesystem::path & snapshot_path,
+    const boost::filesystem::path & lanelet2_map_path, const lanelet::LaneletMap & lanelet_map)
+    -> void;
+
+  auto getLaneletLength(lanelet::Id lanelet_id) const -> std::optional<double>;
+
+  /// @brief Deserialize the lanelet map directly from the mapping.
+  auto loadLaneletMap() const -> lanelet::LaneletMapPtr;
+
+private:
+  struct Header;
+
+  explicit MapSnapshot(void * region, std::size_t size);
+
+  auto header() const noexcept -> const Header &;
+
+  void * const region_;
+
+  const std::size_t size_;
+};
+}  // namespace hdmap_utils
+
+#endif  // TRAFFIC_SIMULATOR__HDMAP_UTILS__MAP_SNAPSHOT_HPP_
@@ -0,0 +1,205 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__HELPER__THREAD_POOL_HPP_
+#define TRAFFIC_SIMULATOR__HELPER__THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace traffic_simulator
+{
+namespace helper
+{
+/**
+ * @brief Fixed size pool of worker threads executing index ranges in parallel.
+ * @note Indices are handed out one by one from a shared counter, so a worker that finishes early
+ *       keeps taking the remaining indices instead of idling. The calling thread takes part in the
+ *       work, so a pool of size 0 simply runs everything on the caller. parallelFor called from
+ *       inside a parallelFor (of this or any other pool) never waits for the pool to become free:
+ *       if the pool is busy, the nested call runs on the calling thread. Nested calls therefore
+ *       cannot deadlock, whichever pools they go through.
+ */
+class ThreadPool
+{
+public:
+  explicit ThreadPool(std::size_t size = defaultSize())
+  {
+    workers_.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      workers_.emplace_back([this]() { work(); });
+    }
+  }
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    wake_up_.notify_all();
+    for (auto & worker : workers_) {
+      worker.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+
+  auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+  static auto defaultSize() -> std::size_t
+  {
+    return std::max(1u, std::thread::hardware_concurrency()) - 1;
+  }
+
+  /// @brief Process-wide pool shared by the parallel queries of traffic_simulator.
+  static auto shared() -> ThreadPool &
+  {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  auto size() const noexcept { return workers_.size(); }
+
+  /**
+   * @brief Call function(i) for every i in [0, count) and wait for all calls to finish.
+   * @note The order in which indices are processed is unspecified, so function must only write to
+   *       state owned by index i. The first exception thrown by function is rethrown to the caller
+   *       after all workers have left the loop.
+   */
+  template <typename Function>
+  auto parallelFor(std::size_t count, Function && function) -> void
+  {
+    if (count == 0) {
+      return;
+    }
+    std::unique_lock<std::mutex> exclusive(call_mutex_, std::defer_lock);
+    if (not workers_.empty() and count != 1) {
+      if (isRunningTask()) {
+        exclusive.try_lock();
+      } else {
+        exclusive.lock();
+      }
+    }
+    if (not exclusive.owns_lock()) {
+      for (std::size_t i = 0; i < count; ++i) {
+        function(i);
+      }
+      return;
+    }
+    std::exception_ptr exception = nullptr;
+    std::mutex exception_mutex;
+    std::atomic<std::size_t> next_index = 0;
+    const auto task = [&]() {
+      for (auto i = next_index++; i < count; i = next_index++) {
+        try {
+          function(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(exception_mutex);
+          if (not exception) {
+            exception = std::current_exception();
+          }
+          next_index = count;
+        }
+      }
+    };
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = task;
+      running_workers_ = workers_.size();
+      ++generation_;
+    }
+    wake_up_.notify_all();
+    runTask(task);
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      finished_.wait(lock, [this]() { return running_workers_ == 0; });
+      task_ = nullptr;
+    }
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+private:
+  /// @brief Number of parallelFor tasks (of any pool) the calling thread is running.
+  static auto runningTaskDepth() -> std::size_t &
+  {
+    thread_local std::size_t depth = 0;
+    return depth;
+  }
+
+  static auto isRunningTask() -> bool { return runningTaskDepth() != 0; }
+
+  /// @note task catches every exception thrown by function, so runningTaskDepth stays balanced.
+  template <typename Task>
+  static auto runTask(const Task & task) -> void
+  {
+    ++runningTaskDepth();
+    task();
+    --runningTaskDepth();
+  }
+
+  auto work() -> void
+  {
+    std::size_t generation = 0;
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_up_.wait(lock, [&]() { return stopped_ or generation_ != generation; });
+        if (stopped_) {
+          return;
+        }
+        generation = generation_;
+        task = task_;
+      }
+      runTask(task);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --running_workers_;
+      }
+      finished_.notify_one();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+
+  std::mutex call_mutex_;
+
+  std::condition_variable wake_up_;
+
+  std::condition_variable finished_;
+
+  std::function<void()> task_;
+
+  std::size_t generation_ = 0;
+
+  std::size_t running_workers_ = 0;
+
+  bool stopped_ = false;
+};
+}  // namespace helper
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__HELPER__THREAD_POOL_HPP_
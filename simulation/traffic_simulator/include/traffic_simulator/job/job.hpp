@@ -15,8 +15,11 @@
 #ifndef TRAFFIC_SIMULATOR__JOB__JOB_HPP_
 #define TRAFFIC_SIMULATOR__JOB__JOB_HPP_
 
-#include <functional>
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace traffic_simulator
 {
@@ -51,17 +54,71 @@ public:
    * @param func_on_cleanup If func_on_update function returns true, runs func_on_update function.
    * @param type Type of the Job
    * @param exclusive If true, the Job works exclusively by type.
+   * @note Both functions are stored inside the Job, without std::function, if they fit in
+   *       inline_capacity bytes. Otherwise they are stored in one heap allocation.
    */
+  template <typename FuncOnUpdate, typename FuncOnCleanup>
   Job(
-    const std::function<bool(double)> & func_on_update,
-    const std::function<void()> & func_on_cleanup, job::Type type, bool exclusive, Event event);
+    FuncOnUpdate && func_on_update, FuncOnCleanup && func_on_cleanup, job::Type type,
+    bool exclusive, Event event)
+  : status_(Status::ACTIVE), job_duration_(0.0), type(type), exclusive(exclusive), event(event)
+  {
+    using Stored = Functions<std::decay_t<FuncOnUpdate>, std::decay_t<FuncOnCleanup>>;
+    if constexpr (sizeof(Stored) <= inline_capacity and alignof(Stored) <= alignof(Storage)) {
+      functions_ = new (&storage_) Stored(
+        std::forward<FuncOnUpdate>(func_on_update), std::forward<FuncOnCleanup>(func_on_cleanup));
+    } else {
+      functions_ = new (&storage_) IndirectFunctions(std::make_unique<Stored>(
+        std::forward<FuncOnUpdate>(func_on_update), std::forward<FuncOnCleanup>(func_on_cleanup)));
+    }
+  }
+  ~Job();
+  Job(const Job &) = delete;
+  Job & operator=(const Job &) = delete;
   void onUpdate(const double step_time);
   void inactivate();
   Status getStatus() const;
 
+  static constexpr std::size_t inline_capacity = 96;
+
 private:
-  std::function<bool(double)> func_on_update_;
-  std::function<void()> func_on_cleanup_;
+  struct FunctionsBase
+  {
+    virtual ~FunctionsBase() = default;
+    virtual bool onUpdate(double job_duration) = 0;
+    virtual void onCleanup() = 0;
+  };
+
+  template <typename FuncOnUpdate, typename FuncOnCleanup>
+  struct Functions : public FunctionsBase
+  {
+    template <typename OnUpdate, typename OnCleanup>
+    Functions(OnUpdate && on_update, OnCleanup && on_cleanup)
+    : func_on_update(std::forward<OnUpdate>(on_update)),
+      func_on_cleanup(std::forward<OnCleanup>(on_cleanup))
+    {
+    }
+    bool onUpdate(double job_duration) override { return func_on_update(job_duration); }
+    void onCleanup() override { func_on_cleanup(); }
+    FuncOnUpdate func_on_update;
+    FuncOnCleanup func_on_cleanup;
+  };
+
+  struct IndirectFunctions : public FunctionsBase
+  {
+    explicit IndirectFunctions(std::unique_ptr<FunctionsBase> functions)
+    : functions(std::move(functions))
+    {
+    }
+    bool onUpdate(double job_duration) override { return functions->onUpdate(job_duration); }
+    void onCleanup() override { functions->onCleanup(); }
+    std::unique_ptr<FunctionsBase> functions;
+  };
+
+  using Storage = std::aligned_storage_t<inline_capacity, alignof(std::max_align_t)>;
+
+  Storage storage_;
+  FunctionsBase * functions_;
   Status status_;
   double job_duration_;
 
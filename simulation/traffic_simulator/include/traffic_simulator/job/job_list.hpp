@@ -15,24 +15,65 @@
 #ifndef TRAFFIC_SIMULATOR__JOB__JOB_LIST_HPP_
 #define TRAFFIC_SIMULATOR__JOB__JOB_LIST_HPP_
 
+#include <array>
+#include <cstddef>
+#include <optional>
 #include <traffic_simulator/job/job.hpp>
+#include <utility>
 #include <vector>
 
 namespace traffic_simulator
 {
 namespace job
 {
+/**
+ * @brief Jobs of an entity, at most one active job for each pair of type and exclusive.
+ * @note Each job is constructed in place in the slot of its type and exclusive, and is destroyed as
+ *       soon as it finishes or is replaced, so update only visits the active jobs of one event, in
+ *       the order they were appended.
+ */
 class JobList
 {
 public:
+  template <typename FuncOnUpdate, typename FuncOnCleanup>
   void append(
-    const std::function<bool(const double)> & func_on_update,
-    const std::function<void()> & func_on_cleanup, job::Type type, bool exclusive,
-    const job::Event event);
+    FuncOnUpdate && func_on_update, FuncOnCleanup && func_on_cleanup, job::Type type,
+    bool exclusive, const job::Event event)
+  {
+    const auto key = getKey(type, exclusive);
+    remove(key);
+    jobs_[key].emplace(
+      std::forward<FuncOnUpdate>(func_on_update), std::forward<FuncOnCleanup>(func_on_cleanup),
+      type, exclusive, event);
+    getKeys(event).push_back(key);
+  }
   void update(const double step_time, const job::Event event);
+  /// @brief Destroy all jobs without cleaning them up, as destroying the JobList does.
+  void clear();
 
 private:
-  std::vector<Job> list_;
+  /// @note Update this if a job::Type is added after OUT_OF_RANGE.
+  static constexpr std::size_t type_size = static_cast<std::size_t>(job::Type::OUT_OF_RANGE) + 1;
+
+  static constexpr std::size_t event_size = static_cast<std::size_t>(job::Event::POST_UPDATE) + 1;
+
+  static constexpr auto getKey(job::Type type, bool exclusive) -> std::size_t
+  {
+    return static_cast<std::size_t>(type) * 2 + (exclusive ? 1 : 0);
+  }
+
+  auto getKeys(const job::Event event) -> std::vector<std::size_t> &
+  {
+    return keys_[static_cast<std::size_t>(event)];
+  }
+
+  /// @brief Inactivate (and clean up) the active job of key, if any, and destroy it.
+  void remove(std::size_t key);
+
+  std::array<std::optional<Job>, type_size * 2> jobs_;
+
+  /// @brief Keys of the active jobs of each event in the order they were appended.
+  std::array<std::vector<std::size_t>, event_size> keys_;
 };
 }  // namespace job
 }  // namespace traffic_simulator
@@ -30,6 +30,7 @@
 #include <string>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/traffic/traffic_module_base.hpp>
+#include <traffic_simulator/traffic/traffic_sink_grid.hpp>
 #include <utility>
 #include <vector>
 
@@ -55,11 +56,15 @@ public:
 
 private:
   void autoSink();
+  /// @brief Despawn every entity inside any of sinks_, with one lookup per entity.
+  void executeSinks();
   const std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_;
   std::vector<std::shared_ptr<traffic_simulator::traffic::TrafficModuleBase>> modules_;
   const std::function<std::vector<std::string>(void)> get_entity_names_function;
   const std::function<geometry_msgs::msg::Pose(const std::string &)> get_entity_pose_function;
   const std::function<void(const std::string &)> despawn_function;
+  /// @note Sinks of auto_sink are indexed here instead of running as one module per dead end.
+  TrafficSinkGrid sinks_;
 
 public:
   const bool auto_sink;
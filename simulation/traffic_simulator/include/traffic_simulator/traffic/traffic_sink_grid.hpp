@@ -0,0 +1,69 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__TRAFFIC__TRAFFIC_SINK_GRID_HPP_
+#define TRAFFIC_SIMULATOR__TRAFFIC__TRAFFIC_SINK_GRID_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <geometry_msgs/msg/point.hpp>
+#include <vector>
+
+namespace traffic_simulator
+{
+namespace traffic
+{
+/**
+ * @brief Spatial index of the sink areas of TrafficController.
+ * @note Sinks are bucketed into a uniform 2D grid whose cell size is the largest sink radius, and
+ *       kept sorted by cell. A point can only be inside sinks of its own cell and the 8 cells
+ *       around it, so contains checks a few sinks instead of all of them. The grid is rebuilt
+ *       lazily on the first query after add.
+ */
+class TrafficSinkGrid
+{
+public:
+  void add(const geometry_msgs::msg::Point & position, double radius);
+
+  /// @brief Whether point is within the radius of any sink.
+  auto contains(const geometry_msgs::msg::Point & point) const -> bool;
+
+  auto empty() const noexcept -> bool { return sinks_.empty(); }
+
+  auto size() const noexcept -> std::size_t { return sinks_.size(); }
+
+private:
+  struct Sink
+  {
+    std::int64_t cell_x;
+    std::int64_t cell_y;
+    geometry_msgs::msg::Point position;
+    double radius;
+  };
+
+  auto getCell(double value) const -> std::int64_t;
+
+  auto build() const -> void;
+
+  /// @note mutable to rebuild the grid lazily in contains.
+  mutable std::vector<Sink> sinks_;
+
+  mutable bool built_ = true;
+
+  double cell_size_ = 0.0;
+};
+}  // namespace traffic
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__TRAFFIC__TRAFFIC_SINK_GRID_HPP_
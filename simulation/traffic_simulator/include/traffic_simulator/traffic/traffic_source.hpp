@@ -0,0 +1,63 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_SIMULATOR__TRAFFIC__TRAFFIC_SOURCE_HPP_
+#define TRAFFIC_SIMULATOR__TRAFFIC__TRAFFIC_SOURCE_HPP_
+
+#include <functional>
+#include <geometry_msgs/msg/pose.hpp>
+#include <optional>
+#include <string>
+#include <traffic_simulator/traffic/traffic_module_base.hpp>
+#include <vector>
+
+namespace traffic_simulator
+{
+namespace traffic
+{
+/**
+ * @brief Spawn an entity at pose every 1 / rate seconds, while no entity is within clearance.
+ * @note Entities are named name_0, name_1, ... and the name of a despawned entity is used again
+ *       before a new one is made, so that EntityManager can reuse the despawned entity object.
+ *       Names of entities not spawned by this source are skipped.
+ */
+class TrafficSource : public TrafficModuleBase
+{
+public:
+  explicit TrafficSource(
+    const std::string & name, double rate, const geometry_msgs::msg::Pose & pose, double clearance,
+    const std::function<double(void)> & get_current_time_function,
+    const std::function<std::vector<std::string>(void)> & get_entity_names_function,
+    const std::function<geometry_msgs::msg::Pose(const std::string &)> & get_entity_pose_function,
+    const std::function<bool(const std::string &, const geometry_msgs::msg::Pose &)> &
+      spawn_function);
+  const std::string name;
+  const double rate;
+  const geometry_msgs::msg::Pose pose;
+  const double clearance;
+  void execute() override;
+
+private:
+  const std::function<double(void)> get_current_time_function;
+  const std::function<std::vector<std::string>(void)> get_entity_names_function;
+  const std::function<geometry_msgs::msg::Pose(const std::string &)> get_entity_pose_function;
+  const std::function<bool(const std::string &, const geometry_msgs::msg::Pose &)> spawn_function;
+  std::optional<double> last_spawn_time_;
+  /// @brief Every name this source has spawned an entity with.
+  std::vector<std::string> entity_names_;
+};
+}  // namespace traffic
+}  // namespace traffic_simulator
+
+#endif  // TRAFFIC_SIMULATOR__TRAFFIC__TRAFFIC_SOURCE_HPP_
@@ -248,6 +248,11 @@ struct TrafficLight
       return lhs.hash() < rhs.hash();
     }
 
+    friend constexpr auto operator==(const Bulb & lhs, const Bulb & rhs) -> bool
+    {
+      return lhs.hash() == rhs.hash();
+    }
+
     friend auto operator<<(std::ostream & os, const Bulb & bulb) -> std::ostream &;
 
     explicit operator simulation_api_schema::TrafficLight() const
@@ -327,7 +332,13 @@ struct TrafficLight
 
   explicit TrafficLight(const lanelet::Id, hdmap_utils::HdMapUtils &);
 
-  auto clear() { bulbs.clear(); }
+  auto clear()
+  {
+    if (not bulbs.empty()) {
+      bulbs.clear();
+      ++version_;
+    }
+  }
 
   auto contains(const Bulb & bulb) const { return bulbs.find(bulb) != std::end(bulbs); }
 
@@ -373,13 +384,28 @@ struct TrafficLight
   template <typename... Ts>
   auto emplace(Ts &&... xs)
   {
-    bulbs.emplace(std::forward<decltype(xs)>(xs)...);
+    if (bulbs.emplace(std::forward<decltype(xs)>(xs)...).second) {
+      ++version_;
+    }
   }
 
   auto empty() const { return bulbs.empty(); }
 
+  /**
+   * @brief Number of times the bulbs have changed, for consumers to tell whether to resend them.
+   * @note Only clear, emplace, set and assign count changes, so bulbs must not be modified directly.
+   */
+  auto getVersion() const noexcept { return version_; }
+
   auto set(const std::string & states) -> void;
 
+  /**
+   * @brief Replace the bulbs with the given states.
+   * @note Unlike clear followed by set, assigning the current state again (as every evaluation
+   *       of a TrafficSignalState does) is not a change.
+   */
+  auto assign(const std::string & states) -> void;
+
   friend auto operator<<(std::ostream & os, const TrafficLight & traffic_light) -> std::ostream &;
 
   explicit operator simulation_api_schema::TrafficSignal() const
@@ -393,6 +419,9 @@ struct TrafficLight
     }
     return traffic_signal_proto;
   }
+
+private:
+  std::size_t version_ = 0;
 };
 }  // namespace traffic_simulator
 
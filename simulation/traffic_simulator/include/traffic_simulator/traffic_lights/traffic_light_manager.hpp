@@ -17,6 +17,7 @@
 
 #include <iomanip>
 #include <memory>
+#include <optional>
 #include <rclcpp/rclcpp.hpp>
 #include <simulation_interface/conversions.hpp>
 #include <stdexcept>  // std::out_of_range
@@ -44,6 +45,13 @@ public:
 
   auto getTrafficLight(const lanelet::Id traffic_light_id) -> TrafficLight &;
 
+  /**
+   * @brief Traffic light of traffic_light_id, or nullptr if it has not been created yet.
+   * @note Unlike getTrafficLight, this never inserts, so behavior plugins may call it from the
+   *       threads of EntityManager::updateNpcLogicInParallel.
+   */
+  auto findTrafficLight(const lanelet::Id traffic_light_id) const -> const TrafficLight *;
+
   auto getTrafficLights() const -> const TrafficLightMap &;
 
   auto getTrafficLights() -> TrafficLightMap &;
@@ -51,9 +59,36 @@ public:
   auto getTrafficLights(const lanelet::Id lanelet_id)
     -> std::vector<std::reference_wrapper<TrafficLight>>;
 
-  auto hasAnyLightChanged() -> bool;
+  /// @brief Sum of the versions of all traffic lights, which increases whenever any light changes.
+  auto getVersion() const -> std::size_t;
+
+  /// @brief Whether any traffic light changed since the previous generateUpdateTrafficLightsDelta.
+  auto hasAnyLightChanged() const -> bool;
+
+  /// @brief Request listing every traffic light, rebuilt only when a traffic light has changed.
+  auto generateUpdateTrafficLightsRequest()
+    -> const simulation_api_schema::UpdateTrafficLightsRequest &;
+
+  /**
+   * @brief Request for the traffic lights changed since the previous call.
+   * @param delta List only the changed traffic lights. Otherwise, every traffic light is listed.
+   * @note With delta, the first request and every keyframe_interval-th request after it list every
+   *       traffic light with delta unset instead, so a simulator which missed a request recovers.
+   * @return std::nullopt if no traffic light changed and no keyframe is due.
+   */
+  auto generateUpdateTrafficLightsDelta(const bool delta = true)
+    -> std::optional<simulation_api_schema::UpdateTrafficLightsRequest>;
+
+  static constexpr std::size_t keyframe_interval = 100;
+
+private:
+  std::optional<std::size_t> request_version_;
+
+  simulation_api_schema::UpdateTrafficLightsRequest request_;
+
+  std::unordered_map<lanelet::Id, std::size_t> delta_versions_;
 
-  auto generateUpdateTrafficLightsRequest() -> simulation_api_schema::UpdateTrafficLightsRequest;
+  std::size_t deltas_since_keyframe_ = keyframe_interval;
 };
 }  // namespace traffic_simulator
 #endif  // TRAFFIC_SIMULATOR__TRAFFIC_LIGHTS__TRAFFIC_LIGHT_MANAGER_BASE_HPP_
@@ -14,6 +14,8 @@
 
 #include <tf2/LinearMath/Quaternion.h>
 
+#include <frame_profiler/frame_profiler.hpp>
+#include <iomanip>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -22,6 +24,9 @@
 #include <stdexcept>
 #include <string>
 #include <traffic_simulator/api/api.hpp>
+#include <traffic_simulator/traffic/traffic_source.hpp>
+#include <utility>
+#include <vector>
 
 namespace traffic_simulator
 {
@@ -34,6 +39,7 @@ bool API::despawn(const std::string & name)
     return false;
   }
   if (not configuration.standalone_mode) {
+    entity_status_delta_encoder_.erase(name);
     simulation_api_schema::DespawnEntityRequest req;
     req.set_name(name);
     return zeromq_client_.call(req).result().success();
@@ -48,6 +54,25 @@ bool API::despawnEntities()
     entities.begin(), entities.end(), [&](const auto & entity) { return despawn(entity); });
 }
 
+auto API::addTrafficSource(
+  const std::string & name, const lanelet::Id lanelet_id, const double rate,
+  const traffic_simulator_msgs::msg::VehicleParameters & parameters, const std::string & behavior,
+  const std::string & model3d) -> void
+{
+  LaneletPose lanelet_pose;
+  lanelet_pose.lanelet_id = lanelet_id;
+  lanelet_pose.s = 0.0;
+  traffic_controller_ptr_->addModule<traffic::TrafficSource>(
+    name, rate, entity_manager_ptr_->getHdmapUtils()->toMapPose(lanelet_pose).pose,
+    parameters.bounding_box.dimensions.x, [this]() { return getCurrentTime(); },
+    [this]() { return getEntityNames(); },
+    [this](const auto & entity_name) { return getMapPose(entity_name); },
+    [this, parameters, behavior, model3d](const auto & entity_name, const auto & pose) {
+      entity_manager_ptr_->poolEntityOnDespawn(entity_name);
+      return spawn(entity_name, pose, parameters, behavior, model3d);
+    });
+}
+
 auto API::setEntityStatus(const std::string & name, const CanonicalizedEntityStatus & status)
   -> void
 {
@@ -199,27 +224,74 @@ bool API::attachLidarSensor(
     lidar_sensor_delay));
 }
 
-bool API::updateTimeInSim()
+auto API::makeUpdateFrameRequest() -> simulation_api_schema::UpdateFrameRequest
 {
   simulation_api_schema::UpdateFrameRequest request;
   request.set_current_simulation_time(clock_.getCurrentSimulationTime());
   request.set_current_scenario_time(getCurrentTime());
   simulation_interface::toProto(
     clock_.getCurrentRosTimeAsMsg().clock, *request.mutable_current_ros_time());
-  return zeromq_client_.call(request).result().success();
+  return request;
+}
+
+bool API::updateTimeInSim()
+{
+  return zeromq_client_.call(makeUpdateFrameRequest()).result().success();
 }
 
 bool API::updateTrafficLightsInSim()
 {
-  if (entity_manager_ptr_->trafficLightsChanged()) {
-    auto req = entity_manager_ptr_->generateUpdateRequestForConventionalTrafficLights();
-    return zeromq_client_.call(req).result().success();
+  if (const auto req = entity_manager_ptr_->generateUpdateRequestForConventionalTrafficLights(
+        configuration.delta_traffic_lights_update)) {
+    return zeromq_client_.call(req.value()).result().success();
   }
-  // TODO handle response
-  return simulation_api_schema::UpdateTrafficLightsResponse().result().success();
+  /// @note Nothing to send, the simulator keeps the traffic lights of the previous request.
+  return true;
 }
 
 bool API::updateEntitiesStatusInSim()
+{
+  if (configuration.delta_entity_status_update and not configuration.standalone_mode) {
+    if (auto res = zeromq_client_.call(makeUpdateEntityStatusDeltaRequest());
+        res.result().success()) {
+      applyEntityStatusesFromSim(res.status());
+      return true;
+    }
+  } else {
+    if (auto res = zeromq_client_.call(makeUpdateEntityStatusRequest()); res.result().success()) {
+      applyEntityStatusesFromSim(res.status());
+      return true;
+    }
+  }
+  return false;
+}
+
+bool API::updateFrameInSim()
+{
+  auto & req = pending_frame_request_;
+  if (configuration.delta_entity_status_update) {
+    *req.mutable_update_entity_status_delta() = makeUpdateEntityStatusDeltaRequest();
+  } else {
+    *req.mutable_update_entity_status() = makeUpdateEntityStatusRequest();
+  }
+  req.set_overlap_sensor_simulation(configuration.overlap_sensor_simulation);
+  const auto res = zeromq_client_.call(req);
+  const auto succeeded = [](const auto & response) { return response.result().success(); };
+  const auto success =
+    (not req.has_update_traffic_lights() or succeeded(res.update_traffic_lights())) and
+    (not req.has_update_frame() or succeeded(res.update_frame())) and
+    (req.has_update_entity_status_delta() ? succeeded(res.update_entity_status_delta())
+                                          : succeeded(res.update_entity_status()));
+  req.Clear();
+  if (success) {
+    applyEntityStatusesFromSim(
+      res.has_update_entity_status_delta() ? res.update_entity_status_delta().status()
+                                           : res.update_entity_status().status());
+  }
+  return success;
+}
+
+auto API::makeUpdateEntityStatusRequest() const -> simulation_api_schema::UpdateEntityStatusRequest
 {
   simulation_api_schema::UpdateEntityStatusRequest req;
   req.set_npc_logic_started(entity_manager_ptr_->isNpcLogicStarted());
@@ -227,46 +299,97 @@ bool API::updateEntitiesStatusInSim()
     auto entity_status = entity_manager_ptr_->getEntityStatus(entity_name);
     simulation_interface::toProto(static_cast<EntityStatus>(entity_status), *req.add_status());
   }
+  return req;
+}
 
-  simulation_api_schema::UpdateEntityStatusResponse res;
-  if (auto res = zeromq_client_.call(req); res.result().success()) {
-    for (const auto & res_status : res.status()) {
-      auto name = res_status.name();
-      auto entity_status = static_cast<EntityStatus>(entity_manager_ptr_->getEntityStatus(name));
-      simulation_interface::toMsg(res_status.pose(), entity_status.pose);
-      simulation_interface::toMsg(res_status.action_status(), entity_status.action_status);
+auto API::makeUpdateEntityStatusDeltaRequest()
+  -> simulation_api_schema::UpdateEntityStatusDeltaRequest
+{
+  simulation_api_schema::UpdateEntityStatusDeltaRequest req;
+  req.set_time(getCurrentTime());
+  req.set_npc_logic_started(entity_manager_ptr_->isNpcLogicStarted());
+  for (const auto & entity_name : entity_manager_ptr_->getEntityNames()) {
+    /// @note the status of Ego is simulated by the simulator, so only its handle is sent
+    entity_status_delta_encoder_.encode(
+      static_cast<EntityStatus>(entity_manager_ptr_->getEntityStatus(entity_name)),
+      entity_manager_ptr_->isEgo(entity_name), req);
+  }
+  return req;
+}
 
+auto API::applyEntityStatusesFromSim(
+  const google::protobuf::RepeatedPtrField<simulation_api_schema::UpdatedEntityStatus> &
+    updated_statuses) -> void
+{
+  /**
+   * @note Only statuses whose pose was changed by the simulator need lane matching, the others keep
+   * their lanelet pose. All of them are matched in one pass before any status is set.
+   */
+  std::vector<std::pair<std::string, CanonicalizedEntityStatus>> moved_statuses, other_statuses;
+  for (const auto & res_status : updated_statuses) {
+    auto name = res_status.name();
+    auto entity_status = static_cast<EntityStatus>(entity_manager_ptr_->getEntityStatus(name));
+    const auto previous_pose = entity_status.pose;
+    simulation_interface::toMsg(res_status.pose(), entity_status.pose);
+    simulation_interface::toMsg(res_status.action_status(), entity_status.action_status);
+
+    if (entity_status.pose != previous_pose) {
+      // temporarily deinitialize lanelet pose as it should be correctly filled from here
+      entity_status.lanelet_pose_valid = false;
+      entity_status.lanelet_pose = traffic_simulator_msgs::msg::LaneletPose();
+      moved_statuses.emplace_back(name, canonicalize(entity_status));
+    } else {
+      other_statuses.emplace_back(name, canonicalize(entity_status));
+    }
+  }
+  entity_manager_ptr_->fillLaneletPoses(moved_statuses);
+  for (const auto & statuses : {&moved_statuses, &other_statuses}) {
+    for (const auto & [name, canonicalized] : *statuses) {
       if (entity_manager_ptr_->isEgo(name)) {
-        // temporarily deinitialize lanelet pose as it should be correctly filled from here
-        entity_status.lanelet_pose_valid = false;
-        entity_status.lanelet_pose = traffic_simulator_msgs::msg::LaneletPose();
-        auto canonicalized = canonicalize(entity_status);
-        /// @note apply additional status data (from ll2) and then set status
-        entity_manager_ptr_->fillLaneletPose(name, canonicalized);
         entity_manager_ptr_->setEntityStatusExternally(name, canonicalized);
       } else {
-        setEntityStatus(name, canonicalize(entity_status));
+        setEntityStatus(name, canonicalized);
       }
     }
-    return true;
   }
-  return false;
+}
+
+auto API::getEntityHandle(const std::string & name) -> std::uint32_t
+{
+  return entity_status_delta_encoder_.getHandle(name);
 }
 
 bool API::updateFrame()
 {
+  FRAME_PROFILER_ZONE("API::updateFrame");
+
   if (configuration.standalone_mode && entity_manager_ptr_->isEgoSpawned()) {
     THROW_SEMANTIC_ERROR("Ego simulation is no longer supported in standalone mode");
   }
 
-  if (!updateEntitiesStatusInSim()) {
+  const auto batch_frame_update =
+    configuration.batch_frame_update and not configuration.standalone_mode;
+
+  /**
+   * @note The entity status of this frame is made here, so that it includes everything done to the
+   *       entities since the previous frame. With batch_frame_update, it is sent together with the
+   *       traffic lights and time left pending by the previous frame, so the simulator sees the
+   *       same sequence of requests as without batch_frame_update.
+   */
+  if (batch_frame_update ? !updateFrameInSim() : !updateEntitiesStatusInSim()) {
     return false;
   }
 
   entity_manager_ptr_->update(getCurrentTime(), clock_.getStepTime());
   traffic_controller_ptr_->execute();
 
-  if (not configuration.standalone_mode) {
+  if (batch_frame_update) {
+    if (const auto req = entity_manager_ptr_->generateUpdateRequestForConventionalTrafficLights(
+          configuration.delta_traffic_lights_update)) {
+      *pending_frame_request_.mutable_update_traffic_lights() = req.value();
+    }
+    *pending_frame_request_.mutable_update_frame() = makeUpdateFrameRequest();
+  } else if (not configuration.standalone_mode) {
     if (!updateTrafficLightsInSim() || !updateTimeInSim()) {
       return false;
     }
@@ -274,6 +397,7 @@ bool API::updateFrame()
 
   entity_manager_ptr_->broadcastEntityTransform();
   clock_.update();
+
   clock_pub_->publish(clock_.getCurrentRosTimeAsMsg());
   debug_marker_pub_->publish(entity_manager_ptr_->makeDebugMarker());
   return true;
@@ -0,0 +1,173 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <scenario_simulator_exception/exception.hpp>
+#include <stdexcept>
+#include <traffic_simulator/data_type/entity_status_table.hpp>
+#include <unordered_set>
+
+namespace traffic_simulator
+{
+inline namespace entity_status
+{
+EntityStatusTable::EntityStatusTable(Statuses && statuses, double grid_cell_size)
+: statuses_(std::move(statuses)), grid_cell_size_(grid_cell_size)
+{
+  if (not(grid_cell_size_ > 0.0)) {
+    THROW_SIMULATION_ERROR("grid cell size of EntityStatusTable must be positive.");
+  }
+  for (const auto & each : statuses_) {
+    const auto position = each.second.getMapPose().position;
+    grid_[getCellKey(getCellIndex(position.x), getCellIndex(position.y))].push_back(&each);
+    if (each.second.laneMatchingSucceed()) {
+      lanelet_index_[each.second.getLaneletPose().lanelet_id].push_back(&each);
+    }
+  }
+}
+
+auto EntityStatusTable::getCellIndex(double coordinate) const noexcept -> std::int64_t
+{
+  return static_cast<std::int64_t>(std::floor(coordinate / grid_cell_size_));
+}
+
+auto EntityStatusTable::getCellKey(std::int64_t x, std::int64_t y) const noexcept -> std::uint64_t
+{
+  return (static_cast<std::uint64_t>(x) << 32) ^ (static_cast<std::uint64_t>(y) & 0xFFFFFFFF);
+}
+
+auto EntityStatusTable::getEntitiesWithin(
+  const geometry_msgs::msg::Point & point, double radius) const -> std::vector<const value_type *>
+{
+  std::vector<const value_type *> entities;
+  if (radius < 0.0) {
+    return entities;
+  }
+  const auto x_min = getCellIndex(point.x - radius), x_max = getCellIndex(point.x + radius);
+  const auto y_min = getCellIndex(point.y - radius), y_max = getCellIndex(point.y + radius);
+  /// @note Fall back to a linear scan if the query covers more cells than there are entities.
+  if (static_cast<double>(x_max - x_min + 1) * (y_max - y_min + 1) > statuses_.size()) {
+    for (const auto & each : statuses_) {
+      const auto position = each.second.getMapPose().position;
+      if (std::hypot(position.x - point.x, position.y - point.y) <= radius) {
+        entities.push_back(&each);
+      }
+    }
+    return entities;
+  }
+  for (auto x = x_min; x <= x_max; ++x) {
+    for (auto y = y_min; y <= y_max; ++y) {
+      if (const auto cell = grid_.find(getCellKey(x, y)); cell != grid_.end()) {
+        for (const auto each : cell->second) {
+          const auto position = each->second.getMapPose().position;
+          if (std::hypot(position.x - point.x, position.y - point.y) <= radius) {
+            entities.push_back(each);
+          }
+        }
+      }
+    }
+  }
+  return entities;
+}
+
+auto EntityStatusTable::getEntitiesOnLanelets(const lanelet::Ids & lanelet_ids) const
+  -> std::vector<const value_type *>
+{
+  std::vector<const value_type *> entities;
+  /// @note lanelet_ids may repeat, but every entity is indexed by its only lanelet id.
+  std::unordered_set<lanelet::Id> visited_lanelet_ids;
+  for (const auto lanelet_id : lanelet_ids) {
+    if (const auto iter = lanelet_index_.find(lanelet_id);
+        iter != lanelet_index_.end() and visited_lanelet_ids.insert(lanelet_id).second) {
+      entities.insert(entities.end(), iter->second.begin(), iter->second.end());
+    }
+  }
+  return entities;
+}
+
+auto OtherEntityStatus::begin() const -> const_iterator
+{
+  if (table_) {
+    return const_iterator(
+      table_->getStatuses().begin(), table_->getStatuses().end(), excluded_);
+  } else {
+    return const_iterator();
+  }
+}
+
+auto OtherEntityStatus::end() const -> const_iterator
+{
+  if (table_) {
+    return const_iterator(
+      table_->getStatuses().end(), table_->getStatuses().end(), excluded_);
+  } else {
+    return const_iterator();
+  }
+}
+
+auto OtherEntityStatus::find(const std::string & name) const -> const_iterator
+{
+  if (table_ and name != excluded_name_) {
+    return const_iterator(
+      table_->getStatuses().find(name), table_->getStatuses().end(), excluded_);
+  } else {
+    return end();
+  }
+}
+
+auto OtherEntityStatus::at(const std::string & name) const -> const CanonicalizedEntityStatus &
+{
+  if (const auto iter = find(name); iter != end()) {
+    return iter->second;
+  } else {
+    throw std::out_of_range("OtherEntityStatus::at");
+  }
+}
+
+auto OtherEntityStatus::size() const -> std::size_t
+{
+  if (table_) {
+    return table_->getStatuses().size() - (excluded_ != table_->getStatuses().end());
+  } else {
+    return 0;
+  }
+}
+
+auto OtherEntityStatus::excluded(const std::vector<const value_type *> & entities) const
+  -> std::vector<const value_type *>
+{
+  std::vector<const value_type *> others;
+  std::copy_if(
+    entities.begin(), entities.end(), std::back_inserter(others),
+    [this](const auto each) { return each->first != excluded_name_; });
+  return others;
+}
+
+auto OtherEntityStatus::getEntitiesWithin(
+  const geometry_msgs::msg::Point & point, double radius) const -> std::vector<const value_type *>
+{
+  return table_ ? excluded(table_->getEntitiesWithin(point, radius))
+                : std::vector<const value_type *>();
+}
+
+auto OtherEntityStatus::getEntitiesOnLanelets(const lanelet::Ids & lanelet_ids) const
+  -> std::vector<const value_type *>
+{
+  return table_ ? excluded(table_->getEntitiesOnLanelets(lanelet_ids))
+                : std::vector<const value_type *>();
+}
+}  // namespace entity_status
+}  // namespace traffic_simulator
@@ -22,28 +22,59 @@ namespace lanelet_pose
 CanonicalizedLaneletPose::CanonicalizedLaneletPose(
   const LaneletPose & maybe_non_canonicalized_lanelet_pose,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils)
-: lanelet_pose_(canonicalize(maybe_non_canonicalized_lanelet_pose, hdmap_utils)),
-  lanelet_poses_(
-    hdmap_utils->getAllCanonicalizedLaneletPoses(maybe_non_canonicalized_lanelet_pose)),
-  map_pose_(hdmap_utils->toMapPose(lanelet_pose_).pose)
+: maybe_non_canonicalized_lanelet_pose_(maybe_non_canonicalized_lanelet_pose),
+  hdmap_utils_(hdmap_utils),
+  lanelet_pose_(canonicalize(maybe_non_canonicalized_lanelet_pose, hdmap_utils))
 {
 }
 
 CanonicalizedLaneletPose::CanonicalizedLaneletPose(
   const LaneletPose & maybe_non_canonicalized_lanelet_pose,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils, const lanelet::Ids & route_lanelets)
-: lanelet_pose_(canonicalize(maybe_non_canonicalized_lanelet_pose, hdmap_utils, route_lanelets)),
-  lanelet_poses_(
-    hdmap_utils->getAllCanonicalizedLaneletPoses(maybe_non_canonicalized_lanelet_pose)),
-  map_pose_(hdmap_utils->toMapPose(lanelet_pose_).pose)
+: maybe_non_canonicalized_lanelet_pose_(maybe_non_canonicalized_lanelet_pose),
+  hdmap_utils_(hdmap_utils),
+  lanelet_pose_(canonicalize(maybe_non_canonicalized_lanelet_pose, hdmap_utils, route_lanelets))
 {
 }
 
+auto CanonicalizedLaneletPose::getLaneletPoses() const -> const std::vector<LaneletPose> &
+{
+  std::call_once(memo_->lanelet_poses_flag, [this]() {
+    /// @note A pose on its own lanelet is its only canonicalized pose, see
+    ///       HdMapUtils::getAllCanonicalizedLaneletPoses.
+    if (isOnItsLanelet(maybe_non_canonicalized_lanelet_pose_, hdmap_utils_)) {
+      memo_->lanelet_poses = {maybe_non_canonicalized_lanelet_pose_};
+    } else {
+      memo_->lanelet_poses =
+        hdmap_utils_->getAllCanonicalizedLaneletPoses(maybe_non_canonicalized_lanelet_pose_);
+    }
+  });
+  return memo_->lanelet_poses;
+}
+
+auto CanonicalizedLaneletPose::getMapPose() const -> const geometry_msgs::msg::Pose &
+{
+  std::call_once(memo_->map_pose_flag, [this]() {
+    memo_->map_pose = hdmap_utils_->toMapPose(lanelet_pose_).pose;
+  });
+  return memo_->map_pose;
+}
+
+auto CanonicalizedLaneletPose::isOnItsLanelet(
+  const LaneletPose & lanelet_pose, const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils)
+  -> bool
+{
+  return 0 <= lanelet_pose.s and
+         lanelet_pose.s <= hdmap_utils->getLaneletLength(lanelet_pose.lanelet_id);
+}
+
 auto CanonicalizedLaneletPose::canonicalize(
   const LaneletPose & may_non_canonicalized_lanelet_pose,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) -> LaneletPose
 {
-  if (
+  if (isOnItsLanelet(may_non_canonicalized_lanelet_pose, hdmap_utils)) {
+    return may_non_canonicalized_lanelet_pose;
+  } else if (
     const auto canonicalized = std::get<std::optional<traffic_simulator::LaneletPose>>(
       hdmap_utils->canonicalizeLaneletPose(may_non_canonicalized_lanelet_pose))) {
     return canonicalized.value();
@@ -64,7 +95,9 @@ auto CanonicalizedLaneletPose::canonicalize(
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils, const lanelet::Ids & route_lanelets)
   -> LaneletPose
 {
-  if (
+  if (isOnItsLanelet(may_non_canonicalized_lanelet_pose, hdmap_utils)) {
+    return may_non_canonicalized_lanelet_pose;
+  } else if (
     const auto canonicalized = std::get<std::optional<traffic_simulator::LaneletPose>>(
       hdmap_utils->canonicalizeLaneletPose(may_non_canonicalized_lanelet_pose, route_lanelets))) {
     return canonicalized.value();
@@ -84,13 +117,14 @@ auto CanonicalizedLaneletPose::getAlternativeLaneletPoseBaseOnShortestRouteFrom(
   LaneletPose from, const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils) const
   -> std::optional<LaneletPose>
 {
-  if (lanelet_poses_.empty()) {
+  const auto & lanelet_poses = getLaneletPoses();
+  if (lanelet_poses.empty()) {
     return std::nullopt;
   }
   lanelet::Ids shortest_route =
-    hdmap_utils->getRoute(from.lanelet_id, lanelet_poses_[0].lanelet_id);
-  LaneletPose alternative_lanelet_pose = lanelet_poses_[0];
-  for (const auto & laneletPose : lanelet_poses_) {
+    hdmap_utils->getRoute(from.lanelet_id, lanelet_poses[0].lanelet_id);
+  LaneletPose alternative_lanelet_pose = lanelet_poses[0];
+  for (const auto & laneletPose : lanelet_poses) {
     const auto route = hdmap_utils->getRoute(from.lanelet_id, laneletPose.lanelet_id);
     if (shortest_route.size() > route.size()) {
       shortest_route = route;
@@ -273,9 +273,9 @@ auto EgoEntity::setVelocityLimit(double value) -> void  //
   field_operator_application->setVelocityLimit(value);
 }
 
-auto EgoEntity::fillLaneletPose(CanonicalizedEntityStatus & status) -> void
+auto EgoEntity::getLaneMatchingParameters() -> LaneMatchingParameters
 {
-  EntityBase::fillLaneletPose(status, false);
+  return {helper::getUniqueValues(getRouteLanelets()), false};
 }
 
 }  // namespace entity
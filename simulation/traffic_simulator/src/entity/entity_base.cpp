@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <geometry/distance.hpp>
 #include <geometry/polygon/polygon.hpp>
 #include <geometry/transform.hpp>
@@ -21,6 +22,7 @@
 #include <string>
 #include <traffic_simulator/entity/entity_base.hpp>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace traffic_simulator
@@ -210,12 +212,12 @@ auto EntityBase::getLaneletPose(double matching_distance) const
   return std::nullopt;
 }
 
-auto EntityBase::fillLaneletPose(CanonicalizedEntityStatus & status, bool include_crosswalk) -> void
+auto EntityBase::fillLaneletPose(CanonicalizedEntityStatus & status) -> void
 {
-  const auto unique_route_lanelets = traffic_simulator::helper::getUniqueValues(getRouteLanelets());
+  const auto [unique_route_lanelets, include_crosswalk] = getLaneMatchingParameters();
 
   std::optional<traffic_simulator_msgs::msg::LaneletPose> lanelet_pose;
-  auto status_non_canonicalized = static_cast<EntityStatus>(status);
+  const auto status_non_canonicalized = static_cast<EntityStatus>(status);
 
   if (unique_route_lanelets.empty()) {
     lanelet_pose = hdmap_utils_ptr_->toLaneletPose(
@@ -228,11 +230,18 @@ auto EntityBase::fillLaneletPose(CanonicalizedEntityStatus & status, bool includ
         status_non_canonicalized.pose, getBoundingBox(), include_crosswalk, 1.0);
     }
   }
+  fillLaneletPose(status, lanelet_pose);
+}
+
+auto EntityBase::fillLaneletPose(
+  CanonicalizedEntityStatus & status,
+  const std::optional<traffic_simulator_msgs::msg::LaneletPose> & lanelet_pose) const -> void
+{
+  auto status_non_canonicalized = static_cast<EntityStatus>(status);
   if (lanelet_pose) {
-    math::geometry::CatmullRomSpline spline(
-      hdmap_utils_ptr_->getCenterPoints(lanelet_pose->lanelet_id));
-    if (const auto s_value = spline.getSValue(status_non_canonicalized.pose)) {
-      status_non_canonicalized.pose.position.z = spline.getPoint(s_value.value()).z;
+    const auto spline = hdmap_utils_ptr_->getCenterPointsSpline(lanelet_pose->lanelet_id);
+    if (const auto s_value = spline->getSValue(status_non_canonicalized.pose)) {
+      status_non_canonicalized.pose.position.z = spline->getPoint(s_value.value()).z;
     }
   }
 
@@ -284,6 +293,28 @@ void EntityBase::resetDynamicConstraints()
   setDynamicConstraints(getDefaultDynamicConstraints());
 }
 
+void EntityBase::reset(const CanonicalizedEntityStatus & entity_status)
+{
+  if (name != static_cast<EntityStatus>(entity_status).name) {
+    THROW_SIMULATION_ERROR(
+      "The name of the entity does not match the name of the entity listed in entity_status.",
+      " The name of the entity is ", name,
+      " and the name of the entity listed in entity_status is ",
+      static_cast<EntityStatus>(entity_status).name);
+  }
+  status_ = entity_status;
+  status_before_update_ = status_;
+  npc_logic_started_ = false;
+  stand_still_duration_ = 0.0;
+  traveled_distance_ = 0.0;
+  other_status_ = OtherEntityStatus();
+  entity_type_list_.clear();
+  target_speed_ = std::nullopt;
+  job_list_.clear();
+  reference_path_ = nullptr;
+  reference_path_lanelets_.clear();
+}
+
 void EntityBase::requestLaneChange(
   const traffic_simulator::lane_change::AbsoluteTarget & target,
   const traffic_simulator::lane_change::TrajectoryShape trajectory_shape,
@@ -675,28 +706,15 @@ void EntityBase::setEntityTypeList(
   entity_type_list_ = entity_type_list;
 }
 
-void EntityBase::setOtherStatus(
-  const std::unordered_map<std::string, CanonicalizedEntityStatus> & status)
-{
-  other_status_.clear();
-  for (const auto & [other_name, other_status] : status) {
-    if (other_name != name) {
-      /*
-         The following filtering is the code written for the purpose of
-         reducing the calculation load, but it is commented out experimentally
-         because it adversely affects "processing that needs to identify other
-         entities regardless of distance" such as RelativeTargetSpeed of
-         requestSpeedChange.
-      */
-      // const auto p0 = other_status.pose.position;
-      // const auto p1 = status_.pose.position;
-      // if (const auto distance = std::hypot(p0.x - p1.x, p0.y - p1.y, p0.z - p1.z); distance <
-      // 30)
-      // {
-      other_status_.emplace(other_name, other_status);
-      // }
-    }
-  }
+void EntityBase::setOtherStatus(const std::shared_ptr<const EntityStatusTable> & status)
+{
+  /*
+     The whole table is kept instead of filtering other entities by distance,
+     because "processing that needs to identify other entities regardless of
+     distance" such as RelativeTargetSpeed of requestSpeedChange needs it.
+     Distance based queries should use other_status_.getEntitiesWithin.
+  */
+  other_status_ = OtherEntityStatus(status, name);
 }
 
 auto EntityBase::setStatus(const CanonicalizedEntityStatus & status) -> void
@@ -818,5 +836,43 @@ auto EntityBase::updateTraveledDistance(const double step_time) -> double
   return traveled_distance_;
 }
 
+auto EntityBase::updateReferencePath(const lanelet::Ids & route_lanelets) -> void
+{
+  if (reference_path_lanelets_ == route_lanelets) {
+    return;
+  }
+  const auto previous_lanelets = std::exchange(reference_path_lanelets_, route_lanelets);
+  if (route_lanelets.empty()) {
+    reference_path_.reset();
+    return;
+  }
+  try {
+    auto reference_path = std::make_shared<math::geometry::CompositeSpline>();
+    auto appended = route_lanelets.begin();
+    /// @note Pieces of reference_path_ are the center lines of previous_lanelets, one to one.
+    if (const auto kept_begin =
+          std::find(previous_lanelets.begin(), previous_lanelets.end(), route_lanelets.front());
+        reference_path_ and kept_begin != previous_lanelets.end()) {
+      const auto [kept_end, kept_route_end] = std::mismatch(
+        kept_begin, previous_lanelets.end(), route_lanelets.begin(), route_lanelets.end());
+      *reference_path = *reference_path_;
+      for (auto iter = previous_lanelets.begin(); iter != kept_begin; ++iter) {
+        reference_path->popFront();
+      }
+      for (auto iter = kept_end; iter != previous_lanelets.end(); ++iter) {
+        reference_path->popBack();
+      }
+      appended = kept_route_end;
+    }
+    for (; appended != route_lanelets.end(); ++appended) {
+      reference_path->pushBack(hdmap_utils_ptr_->getCenterPointsSpline(*appended));
+    }
+    reference_path_ = reference_path;
+  } catch (const common::scenario_simulator_exception::SemanticError &) {
+    // reset the ptr when spline cannot be calculated
+    reference_path_.reset();
+  }
+}
+
 }  // namespace entity
 }  // namespace traffic_simulator
@@ -13,9 +13,12 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <exception>
+#include <frame_profiler/frame_profiler.hpp>
 #include <geometry/bounding_box.hpp>
 #include <geometry/distance.hpp>
 #include <geometry/intersection/collision.hpp>
+#include <geometry/intersection/oriented_boxes.hpp>
 #include <geometry/transform.hpp>
 #include <limits>
 #include <memory>
@@ -28,6 +31,7 @@
 #include <traffic_simulator/entity/entity_manager.hpp>
 #include <traffic_simulator/helper/helper.hpp>
 #include <traffic_simulator/helper/stop_watch.hpp>
+#include <traffic_simulator/helper/thread_pool.hpp>
 #include <unordered_map>
 #include <vector>
 
@@ -75,6 +79,24 @@ bool EntityManager::checkCollision(const std::string & name0, const std::string
            getMapPose(name0), getBoundingBox(name0), getMapPose(name1), getBoundingBox(name1));
 }
 
+auto EntityManager::getCollidingEntities() const
+  -> std::vector<std::pair<std::string, std::string>>
+{
+  std::vector<const std::string *> names;
+  names.reserve(entities_.size());
+  math::geometry::OrientedBoxes boxes;
+  boxes.reserve(entities_.size());
+  for (const auto & [name, entity] : entities_) {
+    names.push_back(&name);
+    boxes.add(entity->getStatus().getMapPose(), entity->getStatus().getBoundingBox());
+  }
+  std::vector<std::pair<std::string, std::string>> colliding_entities;
+  for (const auto & [index0, index1] : boxes.getCollidingPairs()) {
+    colliding_entities.emplace_back(*names[index0], *names[index1]);
+  }
+  return colliding_entities;
+}
+
 visualization_msgs::msg::MarkerArray EntityManager::makeDebugMarker() const
 {
   visualization_msgs::msg::MarkerArray marker;
@@ -86,7 +108,14 @@ visualization_msgs::msg::MarkerArray EntityManager::makeDebugMarker() const
 
 bool EntityManager::despawnEntity(const std::string & name)
 {
-  return entityExists(name) && entities_.erase(name);
+  if (auto node = entities_.extract(name)) {
+    if (pooled_entity_names_.count(name)) {
+      entity_pool_.insert(std::move(node));
+    }
+    return true;
+  } else {
+    return false;
+  }
 }
 
 bool EntityManager::entityExists(const std::string & name)
@@ -94,6 +123,50 @@ bool EntityManager::entityExists(const std::string & name)
   return entities_.find(name) != std::end(entities_);
 }
 
+auto EntityManager::fillLaneletPoses(
+  std::vector<std::pair<std::string, CanonicalizedEntityStatus>> & names_and_statuses) const -> void
+{
+  /**
+   * @note Same result as fillLaneletPose of every entity: statuses are matched to their route
+   * lanelets first, and the rest are matched by their bounding box in one batch per crosswalk
+   * setting.
+   */
+  std::vector<entity::LaneMatchingParameters> parameters;
+  parameters.reserve(names_and_statuses.size());
+  for (const auto & [name, status] : names_and_statuses) {
+    parameters.push_back(entities_.at(name)->getLaneMatchingParameters());
+  }
+  std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>> lanelet_poses(
+    names_and_statuses.size());
+  helper::ThreadPool::shared().parallelFor(names_and_statuses.size(), [&](auto i) {
+    if (const auto & route_lanelets = parameters[i].route_lanelets; not route_lanelets.empty()) {
+      lanelet_poses[i] = hdmap_utils_ptr_->toLaneletPose(
+        names_and_statuses[i].second.getMapPose(), route_lanelets, 1.0);
+    }
+  });
+  for (const auto include_crosswalk : {false, true}) {
+    std::vector<std::size_t> indices;
+    std::vector<std::pair<geometry_msgs::msg::Pose, traffic_simulator_msgs::msg::BoundingBox>>
+      poses_and_bounding_boxes;
+    for (std::size_t i = 0; i < names_and_statuses.size(); ++i) {
+      if (not lanelet_poses[i] and parameters[i].include_crosswalk == include_crosswalk) {
+        const auto & status = names_and_statuses[i].second;
+        indices.push_back(i);
+        poses_and_bounding_boxes.emplace_back(status.getMapPose(), status.getBoundingBox());
+      }
+    }
+    const auto matched_lanelet_poses =
+      hdmap_utils_ptr_->toLaneletPoses(poses_and_bounding_boxes, include_crosswalk, 1.0);
+    for (std::size_t j = 0; j < indices.size(); ++j) {
+      lanelet_poses[indices[j]] = matched_lanelet_poses[j];
+    }
+  }
+  for (std::size_t i = 0; i < names_and_statuses.size(); ++i) {
+    auto & [name, status] = names_and_statuses[i];
+    entities_.at(name)->fillLaneletPose(status, lanelet_poses[i]);
+  }
+}
+
 auto EntityManager::getBoundingBoxDistance(const std::string & from, const std::string & to)
   -> std::optional<double>
 {
@@ -622,6 +695,11 @@ bool EntityManager::isStopping(const std::string & name) const
   return std::fabs(getCurrentTwist(name).linear.x) < std::numeric_limits<double>::epsilon();
 }
 
+auto EntityManager::poolEntityOnDespawn(const std::string & name) -> void
+{
+  pooled_entity_names_.insert(name);
+}
+
 bool EntityManager::reachPosition(
   const std::string & name, const std::string & target_name, const double tolerance) const
 {
@@ -654,12 +732,6 @@ void EntityManager::requestLaneChange(
   }
 }
 
-bool EntityManager::trafficLightsChanged()
-{
-  return conventional_traffic_light_manager_ptr_->hasAnyLightChanged() or
-         v2i_traffic_light_manager_ptr_->hasAnyLightChanged();
-}
-
 void EntityManager::requestSpeedChange(
   const std::string & name, double target_speed, bool continuous)
 {
@@ -742,16 +814,62 @@ auto EntityManager::updateNpcLogic(
   const std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType> & type_list)
   -> const CanonicalizedEntityStatus &
 {
-  if (configuration.verbose) {
-    std::cout << "update " << name << " behavior" << std::endl;
+  FRAME_PROFILER_ZONE("EntityManager::updateNpcLogic");
+  const auto & entity = entities_.at(name);
+  entity->setEntityTypeList(type_list);
+  entity->onUpdate(current_time_, step_time_);
+  return entity->getStatus();
+}
+
+auto EntityManager::updateNpcLogicInParallel(
+  const std::unordered_map<std::string, traffic_simulator_msgs::msg::EntityType> & type_list)
+  -> std::unordered_map<std::string, CanonicalizedEntityStatus>
+{
+  /**
+   * @note Every entity only reads the other status snapshot taken before this phase, so NPCs are
+   * independent of each other here. Ego entities talk to Autoware and stay on this thread.
+   * Results and exceptions are collected per entity and merged in the order of entities_, which
+   * is the order of the serial path, so the outcome does not depend on thread scheduling.
+   */
+  std::vector<std::string> names;
+  names.reserve(entities_.size());
+  for (const auto & [name, entity] : entities_) {
+    names.push_back(name);
+  }
+  std::vector<std::exception_ptr> exceptions(names.size());
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    if (isEgo(names[i])) {
+      try {
+        updateNpcLogic(names[i], type_list);
+      } catch (...) {
+        exceptions[i] = std::current_exception();
+      }
+    }
+  }
+  npc_logic_thread_pool_->parallelFor(names.size(), [&](auto i) {
+    if (not isEgo(names[i])) {
+      try {
+        updateNpcLogic(names[i], type_list);
+      } catch (...) {
+        exceptions[i] = std::current_exception();
+      }
+    }
+  });
+  for (const auto & exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+  std::unordered_map<std::string, CanonicalizedEntityStatus> all_status;
+  for (const auto & name : names) {
+    all_status.emplace(name, entities_.at(name)->getStatus());
   }
-  entities_[name]->setEntityTypeList(type_list);
-  entities_[name]->onUpdate(current_time_, step_time_);
-  return entities_[name]->getStatus();
+  return all_status;
 }
 
 void EntityManager::update(const double current_time, const double step_time)
 {
+  FRAME_PROFILER_ZONE("EntityManager::update");
   traffic_simulator::helper::StopWatch<std::chrono::milliseconds> stop_watch_update(
     "EntityManager::update", configuration.verbose);
   step_time_ = step_time;
@@ -767,18 +885,31 @@ void EntityManager::update(const double current_time, const double step_time)
   for (auto && [name, entity] : entities_) {
     all_status.emplace(name, entity->getStatus());
   }
+  const auto status_before_update =
+    std::make_shared<const EntityStatusTable>(std::move(all_status));
   for (auto && [name, entity] : entities_) {
-    entity->setOtherStatus(all_status);
+    entity->setOtherStatus(status_before_update);
   }
   all_status.clear();
-  for (auto && [name, entity] : entities_) {
-    all_status.emplace(name, updateNpcLogic(name, type_list));
+  /// @note Printed here rather than in updateNpcLogic, which may run on the thread pool.
+  if (configuration.verbose) {
+    for (const auto & [name, entity] : entities_) {
+      std::cout << "update " << name << " behavior" << std::endl;
+    }
+  }
+  if (configuration.parallel_npc_logic) {
+    all_status = updateNpcLogicInParallel(type_list);
+  } else {
+    for (auto && [name, entity] : entities_) {
+      all_status.emplace(name, updateNpcLogic(name, type_list));
+    }
   }
+  const auto status_after_update = std::make_shared<const EntityStatusTable>(std::move(all_status));
   for (auto && [name, entity] : entities_) {
-    entity->setOtherStatus(all_status);
+    entity->setOtherStatus(status_after_update);
   }
   traffic_simulator_msgs::msg::EntityStatusWithTrajectoryArray status_array_msg;
-  for (auto && [name, status] : all_status) {
+  for (auto && [name, status] : status_after_update->getStatuses()) {
     traffic_simulator_msgs::msg::EntityStatusWithTrajectory status_with_trajectory;
     status_with_trajectory.waypoint = getWaypoints(name);
     for (const auto & goal : getGoalPoses<geometry_msgs::msg::Pose>(name)) {
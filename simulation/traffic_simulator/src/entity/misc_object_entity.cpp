@@ -89,9 +89,9 @@ void MiscObjectEntity::requestSpeedChange(
   THROW_SEMANTIC_ERROR("requestSpeedChange function cannot not use in MiscObjectEntity");
 }
 
-auto MiscObjectEntity::fillLaneletPose(CanonicalizedEntityStatus & status) -> void
+auto MiscObjectEntity::getLaneMatchingParameters() -> LaneMatchingParameters
 {
-  EntityBase::fillLaneletPose(status, false);
+  return {lanelet::Ids(), false};
 }
 
 }  // namespace entity
@@ -231,9 +231,9 @@ void PedestrianEntity::setDecelerationRateLimit(double deceleration_rate)
   setBehaviorParameter(behavior_parameter);
 }
 
-auto PedestrianEntity::fillLaneletPose(CanonicalizedEntityStatus & status) -> void
+auto PedestrianEntity::getLaneMatchingParameters() -> LaneMatchingParameters
 {
-  EntityBase::fillLaneletPose(status, true);
+  return {helper::getUniqueValues(getRouteLanelets()), true};
 }
 
 void PedestrianEntity::onUpdate(double current_time, double step_time)
@@ -245,7 +245,10 @@ void PedestrianEntity::onUpdate(double current_time, double step_time)
     behavior_plugin_ptr_->setEntityStatus(
       std::make_shared<traffic_simulator::CanonicalizedEntityStatus>(status_));
     behavior_plugin_ptr_->setTargetSpeed(target_speed_);
-    behavior_plugin_ptr_->setRouteLanelets(getRouteLanelets());
+    const auto route_lanelets = getRouteLanelets();
+    behavior_plugin_ptr_->setRouteLanelets(route_lanelets);
+    updateReferencePath(route_lanelets);
+    behavior_plugin_ptr_->setReferenceTrajectory(reference_path_);
     behavior_plugin_ptr_->update(current_time, step_time);
     auto status_updated = behavior_plugin_ptr_->getUpdatedStatus();
     if (status_updated->laneMatchingSucceed()) {
@@ -31,6 +31,7 @@ VehicleEntity::VehicleEntity(
   const traffic_simulator_msgs::msg::VehicleParameters & parameters,
   const std::string & plugin_name)
 : EntityBase(name, entity_status, hdmap_utils_ptr),
+  plugin_name(plugin_name),
   loader_(pluginlib::ClassLoader<entity_behavior::BehaviorPluginBase>(
     "traffic_simulator", "entity_behavior::BehaviorPluginBase")),
   behavior_plugin_ptr_(loader_.createSharedInstance(plugin_name)),
@@ -139,18 +140,8 @@ void VehicleEntity::onUpdate(double current_time, double step_time)
     auto route_lanelets = getRouteLanelets();
     behavior_plugin_ptr_->setRouteLanelets(route_lanelets);
 
-    // recalculate spline only when input data changes
-    if (previous_route_lanelets_ != route_lanelets) {
-      previous_route_lanelets_ = route_lanelets;
-      try {
-        spline_ = std::make_shared<math::geometry::CatmullRomSpline>(
-          hdmap_utils_ptr_->getCenterPoints(route_lanelets));
-      } catch (const common::scenario_simulator_exception::SemanticError & error) {
-        // reset the ptr when spline cannot be calculated
-        spline_.reset();
-      }
-    }
-    behavior_plugin_ptr_->setReferenceTrajectory(spline_);
+    updateReferencePath(route_lanelets);
+    behavior_plugin_ptr_->setReferenceTrajectory(reference_path_);
     behavior_plugin_ptr_->update(current_time, step_time);
     auto status_updated = behavior_plugin_ptr_->getUpdatedStatus();
     if (status_updated->laneMatchingSucceed()) {
@@ -244,6 +235,32 @@ void VehicleEntity::requestLaneChange(const traffic_simulator::lane_change::Para
   behavior_plugin_ptr_->setLaneChangeParameters(parameter);
 }
 
+void VehicleEntity::reset(const CanonicalizedEntityStatus & entity_status)
+{
+  EntityBase::reset(entity_status);
+  route_planner_.cancelRoute();
+  behavior_plugin_ptr_->reset();
+  behavior_plugin_ptr_->setDebugMarker({});
+  behavior_plugin_ptr_->setGoalPoses({});
+  behavior_plugin_ptr_->setPolylineTrajectory(nullptr);
+  behavior_plugin_ptr_->setBehaviorParameter(traffic_simulator_msgs::msg::BehaviorParameter());
+}
+
+auto VehicleEntity::reset(
+  const CanonicalizedEntityStatus & entity_status,
+  const traffic_simulator_msgs::msg::VehicleParameters & parameters,
+  const std::string & plugin_name) -> bool
+{
+  if (plugin_name != this->plugin_name) {
+    return false;
+  } else {
+    /// @note Set before reset, as setBehaviorParameter clamps to the vehicle performance.
+    behavior_plugin_ptr_->setVehicleParameters(parameters);
+    reset(entity_status);
+    return true;
+  }
+}
+
 void VehicleEntity::setAccelerationLimit(double acceleration)
 {
   if (acceleration <= 0.0) {
@@ -297,9 +314,9 @@ void VehicleEntity::setTrafficLightManager(
   behavior_plugin_ptr_->setTrafficLightManager(traffic_light_manager_);
 }
 
-auto VehicleEntity::fillLaneletPose(CanonicalizedEntityStatus & status) -> void
+auto VehicleEntity::getLaneMatchingParameters() -> LaneMatchingParameters
 {
-  EntityBase::fillLaneletPose(status, false);
+  return {helper::getUniqueValues(getRouteLanelets()), false};
 }
 
 }  // namespace entity
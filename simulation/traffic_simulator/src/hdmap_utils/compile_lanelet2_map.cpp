@@ -0,0 +1,44 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/hdmap_utils/map_snapshot.hpp>
+
+/**
+ * @brief Compile a lanelet2 map into the snapshot HdMapUtils loads instead of the .osm file.
+ * @note Usage: compile_lanelet2_map <lanelet2_map.osm> [<output>]
+ *       Without output, the snapshot is written next to the map where HdMapUtils looks for it.
+ */
+int main(int argc, char ** argv)
+{
+  if (argc != 2 and argc != 3) {
+    std::cerr << "usage: " << argv[0] << " <lanelet2_map.osm> [<output>]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  try {
+    const boost::filesystem::path lanelet2_map_path = argv[1];
+    const auto snapshot_path = argc == 3 ? boost::filesystem::path(argv[2])
+                                         : hdmap_utils::MapSnapshot::getPath(lanelet2_map_path);
+    hdmap_utils::HdMapUtils(lanelet2_map_path, geographic_msgs::msg::GeoPoint())
+      .writeMapSnapshot(snapshot_path);
+    std::cout << "wrote " << snapshot_path.string() << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const std::exception & error) {
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
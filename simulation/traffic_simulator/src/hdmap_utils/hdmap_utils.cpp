@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <lanelet2_core/Exceptions.h>
 #include <lanelet2_core/utility/Units.h>
 #include <lanelet2_io/Io.h>
 #include <lanelet2_io/io_handlers/Serialize.h>
@@ -19,6 +20,7 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <algorithm>
+#include <array>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/assign/list_of.hpp>
@@ -45,6 +47,7 @@
 #include <traffic_simulator/color_utils/color_utils.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/helper/helper.hpp>
+#include <traffic_simulator/helper/thread_pool.hpp>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -52,24 +55,35 @@
 namespace hdmap_utils
 {
 HdMapUtils::HdMapUtils(
-  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint &)
-{
-  lanelet::projection::MGRSProjector projector;
+  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint &,
+  bool precompute_lanelet_geometry)
+: lanelet2_map_path_(lanelet2_map_path)
+{
+  if (map_snapshot_ = MapSnapshot::open(MapSnapshot::getPath(lanelet2_map_path), lanelet2_map_path);
+      map_snapshot_) {
+    /// @note The snapshot is already projected and its centerlines are already overwritten.
+    lanelet_map_ptr_ = map_snapshot_->loadLaneletMap();
+  } else {
+    lanelet::projection::MGRSProjector projector;
 
-  lanelet::ErrorMessages errors;
+    lanelet::ErrorMessages errors;
 
-  lanelet_map_ptr_ = lanelet::load(lanelet2_map_path.string(), projector, &errors);
+    lanelet_map_ptr_ = lanelet::load(lanelet2_map_path.string(), projector, &errors);
 
-  if (not errors.empty()) {
-    std::stringstream ss;
-    const auto * separator = "";
-    for (const auto & error : errors) {
-      ss << separator << error;
-      separator = "\n";
+    if (not errors.empty()) {
+      std::stringstream ss;
+      const auto * separator = "";
+      for (const auto & error : errors) {
+        ss << separator << error;
+        separator = "\n";
+      }
+      THROW_SIMULATION_ERROR("Failed to load lanelet map (", ss.str(), ")");
     }
-    THROW_SIMULATION_ERROR("Failed to load lanelet map (", ss.str(), ")");
+    overwriteLaneletsCenterline();
+  }
+  if (precompute_lanelet_geometry) {
+    precomputeLaneletGeometry();
   }
-  overwriteLaneletsCenterline();
   traffic_rules_vehicle_ptr_ = lanelet::traffic_rules::TrafficRulesFactory::create(
     lanelet::Locations::Germany, lanelet::Participants::Vehicle);
   vehicle_routing_graph_ptr_ =
@@ -83,6 +97,112 @@ HdMapUtils::HdMapUtils(
   all_graphs.push_back(pedestrian_routing_graph_ptr_);
   shoulder_lanelets_ =
     lanelet::utils::query::shoulderLanelets(lanelet::utils::query::laneletLayer(lanelet_map_ptr_));
+  buildLaneletAdjacencyTables();
+  buildLaneletConflictTables();
+}
+
+auto HdMapUtils::buildLaneletAdjacencyTables() -> void
+{
+  using Rows = std::vector<std::pair<lanelet::Id, lanelet::Ids>>;
+  Rows next, previous;
+  std::unordered_map<std::string, Rows> next_by_turn_direction, previous_by_turn_direction;
+  const auto append_side_rows = [this](const auto & graph, const auto & lanelet_obj, auto & rows) {
+    const auto id = lanelet_obj.id();
+    rows[0].emplace_back(id, getLaneletIds(graph->lefts(lanelet_obj)));
+    rows[1].emplace_back(id, getLaneletIds(graph->adjacentLefts(lanelet_obj)));
+    rows[2].emplace_back(id, getLaneletIds(graph->rights(lanelet_obj)));
+    rows[3].emplace_back(id, getLaneletIds(graph->adjacentRights(lanelet_obj)));
+  };
+  std::array<Rows, 4> vehicle_sides, pedestrian_sides;
+  for (const auto & lanelet_obj : lanelet_map_ptr_->laneletLayer) {
+    const auto id = lanelet_obj.id();
+    /// @note Same order as the routing graph queries did: routing graph first, then road shoulders.
+    lanelet::Ids next_ids, previous_ids;
+    std::unordered_map<std::string, lanelet::Ids> next_ids_by_turn_direction,
+      previous_ids_by_turn_direction;
+    for (const auto & following : vehicle_routing_graph_ptr_->following(lanelet_obj)) {
+      next_ids.push_back(following.id());
+      next_ids_by_turn_direction[following.attributeOr("turn_direction", "else")].push_back(
+        following.id());
+    }
+    for (const auto & preceding : vehicle_routing_graph_ptr_->previous(lanelet_obj)) {
+      previous_ids.push_back(preceding.id());
+      previous_ids_by_turn_direction[preceding.attributeOr("turn_direction", "else")].push_back(
+        preceding.id());
+    }
+    next.emplace_back(id, next_ids + getNextRoadShoulderLanelet(id));
+    previous.emplace_back(id, previous_ids + getPreviousRoadShoulderLanelet(id));
+    for (auto & [turn_direction, ids] : next_ids_by_turn_direction) {
+      next_by_turn_direction[turn_direction].emplace_back(id, std::move(ids));
+    }
+    for (auto & [turn_direction, ids] : previous_ids_by_turn_direction) {
+      previous_by_turn_direction[turn_direction].emplace_back(id, std::move(ids));
+    }
+    append_side_rows(vehicle_routing_graph_ptr_, lanelet_obj, vehicle_sides);
+    append_side_rows(pedestrian_routing_graph_ptr_, lanelet_obj, pedestrian_sides);
+  }
+  next_lanelet_ids_ = LaneletAdjacencyTable(std::move(next));
+  previous_lanelet_ids_ = LaneletAdjacencyTable(std::move(previous));
+  for (auto & [turn_direction, rows] : next_by_turn_direction) {
+    next_lanelet_ids_by_turn_direction_.emplace(turn_direction, std::move(rows));
+  }
+  for (auto & [turn_direction, rows] : previous_by_turn_direction) {
+    previous_lanelet_ids_by_turn_direction_.emplace(turn_direction, std::move(rows));
+  }
+  const auto make_side_lanelet_ids = [](auto & rows) {
+    return SideLaneletIds{
+      LaneletAdjacencyTable(std::move(rows[0])), LaneletAdjacencyTable(std::move(rows[1])),
+      LaneletAdjacencyTable(std::move(rows[2])), LaneletAdjacencyTable(std::move(rows[3]))};
+  };
+  vehicle_side_lanelet_ids_ = make_side_lanelet_ids(vehicle_sides);
+  pedestrian_side_lanelet_ids_ = make_side_lanelet_ids(pedestrian_sides);
+}
+
+auto HdMapUtils::buildLaneletConflictTables() -> void
+{
+  using Rows = std::vector<std::pair<lanelet::Id, lanelet::Ids>>;
+  Rows conflicting_lanes, conflicting_crosswalks, right_of_ways;
+  /// @note Built once here instead of once per getConflictingCrosswalkIds call.
+  const lanelet::routing::RoutingGraphContainer container(
+    std::vector<lanelet::routing::RoutingGraphConstPtr>{
+      vehicle_routing_graph_ptr_, pedestrian_routing_graph_ptr_});
+  constexpr std::size_t pedestrian_routing_graph_id = 1;
+  constexpr double height_clearance = 4;
+  for (const auto & lanelet_obj : lanelet_map_ptr_->laneletLayer) {
+    const auto id = lanelet_obj.id();
+    conflicting_lanes.emplace_back(
+      id, getLaneletIds(
+            lanelet::utils::getConflictingLanelets(vehicle_routing_graph_ptr_, lanelet_obj)));
+    conflicting_crosswalks.emplace_back(
+      id, getLaneletIds(container.conflictingInGraph(
+            lanelet_obj, pedestrian_routing_graph_id, height_clearance)));
+    lanelet::Ids right_of_way_ids;
+    for (const auto & right_of_way : lanelet_obj.regulatoryElementsAs<lanelet::RightOfWay>()) {
+      for (const auto & right_of_way_lanelet : right_of_way->rightOfWayLanelets()) {
+        if (right_of_way_lanelet.id() != id) {
+          right_of_way_ids.push_back(right_of_way_lanelet.id());
+        }
+      }
+    }
+    right_of_ways.emplace_back(id, std::move(right_of_way_ids));
+  }
+  conflicting_lane_ids_ = LaneletAdjacencyTable(std::move(conflicting_lanes));
+  conflicting_crosswalk_ids_ = LaneletAdjacencyTable(std::move(conflicting_crosswalks));
+  right_of_way_lanelet_ids_ = LaneletAdjacencyTable(std::move(right_of_ways));
+}
+
+auto HdMapUtils::findAdjacentLaneletIds(
+  const LaneletAdjacencyTable & table, lanelet::Id lanelet_id) const -> LaneletIdsView
+{
+  /// @note Every lanelet of the map has a row in next_lanelet_ids_, possibly an empty one.
+  if (const auto ids = table.find(lanelet_id);
+      not ids.empty() or next_lanelet_ids_.contains(lanelet_id)) {
+    return ids;
+  } else {
+    /// @note Same exception as the lanelet layer of the map throws, which callers may catch.
+    throw lanelet::NoSuchPrimitiveError(
+      "Lanelet " + std::to_string(lanelet_id) + " does not exist in the lanelet map.");
+  }
 }
 
 auto HdMapUtils::getAllCanonicalizedLaneletPoses(
@@ -361,12 +481,7 @@ auto HdMapUtils::getConflictingLaneIds(const lanelet::Ids & lanelet_ids) const -
 {
   lanelet::Ids ids;
   for (const auto & lanelet_id : lanelet_ids) {
-    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-    const auto conflicting_lanelets =
-      lanelet::utils::getConflictingLanelets(vehicle_routing_graph_ptr_, lanelet);
-    for (const auto & conflicting_lanelet : conflicting_lanelets) {
-      ids.emplace_back(conflicting_lanelet.id());
-    }
+    ids += findAdjacentLaneletIds(conflicting_lane_ids_, lanelet_id);
   }
   return ids;
 }
@@ -374,19 +489,8 @@ auto HdMapUtils::getConflictingLaneIds(const lanelet::Ids & lanelet_ids) const -
 auto HdMapUtils::getConflictingCrosswalkIds(const lanelet::Ids & lanelet_ids) const -> lanelet::Ids
 {
   lanelet::Ids ids;
-  std::vector<lanelet::routing::RoutingGraphConstPtr> graphs;
-  graphs.emplace_back(vehicle_routing_graph_ptr_);
-  graphs.emplace_back(pedestrian_routing_graph_ptr_);
-  lanelet::routing::RoutingGraphContainer container(graphs);
   for (const auto & lanelet_id : lanelet_ids) {
-    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-    double height_clearance = 4;
-    size_t routing_graph_id = 1;
-    const auto conflicting_crosswalks =
-      container.conflictingInGraph(lanelet, routing_graph_id, height_clearance);
-    for (const auto & crosswalk : conflicting_crosswalks) {
-      ids.emplace_back(crosswalk.id());
-    }
+    ids += findAdjacentLaneletIds(conflicting_crosswalk_ids_, lanelet_id);
   }
   return ids;
 }
@@ -648,6 +752,48 @@ auto HdMapUtils::toLaneletPoses(
   return ret;
 }
 
+auto HdMapUtils::toLaneletPoses(
+  const std::vector<
+    std::pair<geometry_msgs::msg::Pose, traffic_simulator_msgs::msg::BoundingBox>> &
+    poses_and_bounding_boxes,
+  bool include_crosswalk, double matching_distance) const
+  -> std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>>
+{
+  auto & thread_pool = traffic_simulator::helper::ThreadPool::shared();
+
+  std::vector<std::optional<lanelet::Id>> matched_lanelet_ids(poses_and_bounding_boxes.size());
+  thread_pool.parallelFor(poses_and_bounding_boxes.size(), [&](auto i) {
+    const auto & [pose, bounding_box] = poses_and_bounding_boxes[i];
+    matched_lanelet_ids[i] = matchToLane(pose, bounding_box, include_crosswalk);
+  });
+
+  /// @note Same candidate order as toLaneletPose: the matched lanelet, then its previous lanelets.
+  std::unordered_map<lanelet::Id, lanelet::Ids> candidate_lanelet_ids;
+  for (const auto & matched_lanelet_id : matched_lanelet_ids) {
+    if (matched_lanelet_id and candidate_lanelet_ids.count(matched_lanelet_id.value()) == 0) {
+      lanelet::Ids ids = {matched_lanelet_id.value()};
+      ids += getPreviousLaneletIds(matched_lanelet_id.value());
+      candidate_lanelet_ids.emplace(matched_lanelet_id.value(), std::move(ids));
+    }
+  }
+
+  std::vector<std::optional<traffic_simulator_msgs::msg::LaneletPose>> lanelet_poses(
+    poses_and_bounding_boxes.size());
+  thread_pool.parallelFor(poses_and_bounding_boxes.size(), [&](auto i) {
+    const auto & pose = poses_and_bounding_boxes[i].first;
+    if (not matched_lanelet_ids[i]) {
+      lanelet_poses[i] = toLaneletPose(pose, include_crosswalk, matching_distance);
+    } else if (
+      const auto lanelet_pose = toLaneletPose(
+        pose, candidate_lanelet_ids.at(matched_lanelet_ids[i].value()), matching_distance)) {
+      lanelet_poses[i] = lanelet_pose;
+    } else {
+      lanelet_poses[i] = toLaneletPose(pose, include_crosswalk);
+    }
+  });
+  return lanelet_poses;
+}
+
 auto HdMapUtils::getClosestLaneletId(
   const geometry_msgs::msg::Pose & pose, double distance_thresh, bool include_crosswalk) const
   -> std::optional<lanelet::Id>
@@ -868,9 +1014,24 @@ auto HdMapUtils::getRoute(lanelet::Id from_lanelet_id, lanelet::Id to_lanelet_id
   return ids;
 }
 
+auto HdMapUtils::getRouteConflicts(const lanelet::Ids & route_lanelets) const -> RouteConflicts
+{
+  RouteConflicts conflicts;
+  for (const auto & lanelet_id : route_lanelets) {
+    conflicts.lanes += findAdjacentLaneletIds(conflicting_lane_ids_, lanelet_id);
+    conflicts.crosswalks += findAdjacentLaneletIds(conflicting_crosswalk_ids_, lanelet_id);
+  }
+  conflicts.lanes = sortAndUnique(conflicts.lanes);
+  conflicts.crosswalks = sortAndUnique(conflicts.crosswalks);
+  return conflicts;
+}
+
 auto HdMapUtils::getCenterPointsSpline(lanelet::Id lanelet_id) const
   -> std::shared_ptr<math::geometry::CatmullRomSpline>
 {
+  if (const auto entry = lanelet_geometry_table_.find(lanelet_id)) {
+    return entry->spline;
+  }
   getCenterPoints(lanelet_id);
   return center_points_cache_.getCenterPointsSpline(lanelet_id);
 }
@@ -892,7 +1053,9 @@ auto HdMapUtils::getCenterPoints(const lanelet::Ids & lanelet_ids) const
 auto HdMapUtils::getCenterPoints(lanelet::Id lanelet_id) const
   -> std::vector<geometry_msgs::msg::Point>
 {
-  std::vector<geometry_msgs::msg::Point> ret;
+  if (const auto entry = lanelet_geometry_table_.find(lanelet_id)) {
+    return entry->center_points;
+  }
   if (!lanelet_map_ptr_) {
     THROW_SIMULATION_ERROR("lanelet map is null pointer");
   }
@@ -902,7 +1065,15 @@ auto HdMapUtils::getCenterPoints(lanelet::Id lanelet_id) const
   if (center_points_cache_.exists(lanelet_id)) {
     return center_points_cache_.getCenterPoints(lanelet_id);
   }
+  const auto ret = calculateCenterPoints(lanelet_id);
+  center_points_cache_.appendData(lanelet_id, ret);
+  return ret;
+}
 
+auto HdMapUtils::calculateCenterPoints(lanelet::Id lanelet_id) const
+  -> std::vector<geometry_msgs::msg::Point>
+{
+  std::vector<geometry_msgs::msg::Point> ret;
   const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
   const auto centerline = lanelet.centerline();
   for (const auto & point : centerline) {
@@ -924,12 +1095,19 @@ auto HdMapUtils::getCenterPoints(lanelet::Id lanelet_id) const
     ret.push_back(p1);
     ret.push_back(p2);
   }
-  center_points_cache_.appendData(lanelet_id, ret);
   return ret;
 }
 
 auto HdMapUtils::getLaneletLength(lanelet::Id lanelet_id) const -> double
 {
+  if (const auto entry = lanelet_geometry_table_.find(lanelet_id)) {
+    return entry->length;
+  }
+  if (map_snapshot_) {
+    if (const auto length = map_snapshot_->getLaneletLength(lanelet_id)) {
+      return length.value();
+    }
+  }
   if (lanelet_length_cache_.exists(lanelet_id)) {
     return lanelet_length_cache_.getLength(lanelet_id);
   }
@@ -950,17 +1128,9 @@ auto HdMapUtils::getPreviousRoadShoulderLanelet(lanelet::Id lanelet_id) const ->
   return ids;
 }
 
-auto HdMapUtils::getPreviousLaneletIds(lanelet::Id lanelet_id) const -> lanelet::Ids
+auto HdMapUtils::getPreviousLaneletIds(lanelet::Id lanelet_id) const -> LaneletIdsView
 {
-  lanelet::Ids ids;
-  const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-  for (const auto & llt : vehicle_routing_graph_ptr_->previous(lanelet)) {
-    ids.push_back(llt.id());
-  }
-  for (const auto & id : getPreviousRoadShoulderLanelet(lanelet_id)) {
-    ids.emplace_back(id);
-  }
-  return ids;
+  return findAdjacentLaneletIds(previous_lanelet_ids_, lanelet_id);
 }
 
 auto HdMapUtils::getPreviousLaneletIds(const lanelet::Ids & lanelet_ids) const -> lanelet::Ids
@@ -973,16 +1143,14 @@ auto HdMapUtils::getPreviousLaneletIds(const lanelet::Ids & lanelet_ids) const -
 }
 
 auto HdMapUtils::getPreviousLaneletIds(
-  lanelet::Id lanelet_id, const std::string & turn_direction) const -> lanelet::Ids
+  lanelet::Id lanelet_id, const std::string & turn_direction) const -> LaneletIdsView
 {
-  lanelet::Ids ids;
-  const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-  for (const auto & llt : vehicle_routing_graph_ptr_->previous(lanelet)) {
-    if (llt.attributeOr("turn_direction", "else") == turn_direction) {
-      ids.push_back(llt.id());
-    }
+  if (const auto iter = previous_lanelet_ids_by_turn_direction_.find(turn_direction);
+      iter != previous_lanelet_ids_by_turn_direction_.end()) {
+    return findAdjacentLaneletIds(iter->second, lanelet_id);
+  } else {
+    return findAdjacentLaneletIds(LaneletAdjacencyTable(), lanelet_id);
   }
-  return ids;
 }
 
 auto HdMapUtils::getPreviousLaneletIds(
@@ -1007,17 +1175,9 @@ auto HdMapUtils::getNextRoadShoulderLanelet(lanelet::Id lanelet_id) const -> lan
   return ids;
 }
 
-auto HdMapUtils::getNextLaneletIds(lanelet::Id lanelet_id) const -> lanelet::Ids
+auto HdMapUtils::getNextLaneletIds(lanelet::Id lanelet_id) const -> LaneletIdsView
 {
-  lanelet::Ids ids;
-  const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-  for (const auto & llt : vehicle_routing_graph_ptr_->following(lanelet)) {
-    ids.push_back(llt.id());
-  }
-  for (const auto & id : getNextRoadShoulderLanelet(lanelet_id)) {
-    ids.push_back(id);
-  }
-  return ids;
+  return findAdjacentLaneletIds(next_lanelet_ids_, lanelet_id);
 }
 
 auto HdMapUtils::getNextLaneletIds(const lanelet::Ids & lanelet_ids) const -> lanelet::Ids
@@ -1030,16 +1190,14 @@ auto HdMapUtils::getNextLaneletIds(const lanelet::Ids & lanelet_ids) const -> la
 }
 
 auto HdMapUtils::getNextLaneletIds(lanelet::Id lanelet_id, const std::string & turn_direction) const
-  -> lanelet::Ids
+  -> LaneletIdsView
 {
-  lanelet::Ids ids;
-  const auto lanelet = lanelet_map_ptr_->laneletLayer.get(lanelet_id);
-  for (const auto & llt : vehicle_routing_graph_ptr_->following(lanelet)) {
-    if (llt.attributeOr("turn_direction", "else") == turn_direction) {
-      ids.push_back(llt.id());
-    }
+  if (const auto iter = next_lanelet_ids_by_turn_direction_.find(turn_direction);
+      iter != next_lanelet_ids_by_turn_direction_.end()) {
+    return findAdjacentLaneletIds(iter->second, lanelet_id);
+  } else {
+    return findAdjacentLaneletIds(LaneletAdjacencyTable(), lanelet_id);
   }
-  return ids;
 }
 
 auto HdMapUtils::getNextLaneletIds(
@@ -1159,33 +1317,20 @@ auto HdMapUtils::getRightBound(lanelet::Id lanelet_id) const
 
 auto HdMapUtils::getLeftLaneletIds(
   lanelet::Id lanelet_id, traffic_simulator_msgs::msg::EntityType type,
-  bool include_opposite_direction) const -> lanelet::Ids
+  bool include_opposite_direction) const -> LaneletIdsView
 {
   switch (type.type) {
     case traffic_simulator_msgs::msg::EntityType::EGO:
-      if (include_opposite_direction) {
-        return getLaneletIds(
-          vehicle_routing_graph_ptr_->lefts(lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      } else {
-        return getLaneletIds(vehicle_routing_graph_ptr_->adjacentLefts(
-          lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      }
     case traffic_simulator_msgs::msg::EntityType::VEHICLE:
-      if (include_opposite_direction) {
-        return getLaneletIds(
-          vehicle_routing_graph_ptr_->lefts(lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      } else {
-        return getLaneletIds(vehicle_routing_graph_ptr_->adjacentLefts(
-          lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      }
+      return findAdjacentLaneletIds(
+        include_opposite_direction ? vehicle_side_lanelet_ids_.lefts
+                                   : vehicle_side_lanelet_ids_.adjacent_lefts,
+        lanelet_id);
     case traffic_simulator_msgs::msg::EntityType::PEDESTRIAN:
-      if (include_opposite_direction) {
-        return getLaneletIds(
-          pedestrian_routing_graph_ptr_->lefts(lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      } else {
-        return getLaneletIds(pedestrian_routing_graph_ptr_->adjacentLefts(
-          lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      }
+      return findAdjacentLaneletIds(
+        include_opposite_direction ? pedestrian_side_lanelet_ids_.lefts
+                                   : pedestrian_side_lanelet_ids_.adjacent_lefts,
+        lanelet_id);
     default:
     case traffic_simulator_msgs::msg::EntityType::MISC_OBJECT:
       return {};
@@ -1194,33 +1339,20 @@ auto HdMapUtils::getLeftLaneletIds(
 
 auto HdMapUtils::getRightLaneletIds(
   lanelet::Id lanelet_id, traffic_simulator_msgs::msg::EntityType type,
-  bool include_opposite_direction) const -> lanelet::Ids
+  bool include_opposite_direction) const -> LaneletIdsView
 {
   switch (type.type) {
     case traffic_simulator_msgs::msg::EntityType::EGO:
-      if (include_opposite_direction) {
-        return getLaneletIds(
-          vehicle_routing_graph_ptr_->rights(lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      } else {
-        return getLaneletIds(vehicle_routing_graph_ptr_->adjacentRights(
-          lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      }
     case traffic_simulator_msgs::msg::EntityType::VEHICLE:
-      if (include_opposite_direction) {
-        return getLaneletIds(
-          vehicle_routing_graph_ptr_->rights(lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      } else {
-        return getLaneletIds(vehicle_routing_graph_ptr_->adjacentRights(
-          lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      }
+      return findAdjacentLaneletIds(
+        include_opposite_direction ? vehicle_side_lanelet_ids_.rights
+                                   : vehicle_side_lanelet_ids_.adjacent_rights,
+        lanelet_id);
     case traffic_simulator_msgs::msg::EntityType::PEDESTRIAN:
-      if (include_opposite_direction) {
-        return getLaneletIds(
-          pedestrian_routing_graph_ptr_->rights(lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      } else {
-        return getLaneletIds(pedestrian_routing_graph_ptr_->adjacentRights(
-          lanelet_map_ptr_->laneletLayer.get(lanelet_id)));
-      }
+      return findAdjacentLaneletIds(
+        include_opposite_direction ? pedestrian_side_lanelet_ids_.rights
+                                   : pedestrian_side_lanelet_ids_.adjacent_rights,
+        lanelet_id);
     default:
     case traffic_simulator_msgs::msg::EntityType::MISC_OBJECT:
       return {};
@@ -1485,6 +1617,11 @@ auto HdMapUtils::toMapBin() const -> autoware_auto_mapping_msgs::msg::HADMapBin
   return msg;
 }
 
+auto HdMapUtils::writeMapSnapshot(const boost::filesystem::path & snapshot_path) const -> void
+{
+  MapSnapshot::write(snapshot_path, lanelet2_map_path_, *lanelet_map_ptr_);
+}
+
 auto HdMapUtils::insertMarkerArray(
   visualization_msgs::msg::MarkerArray & a1, const visualization_msgs::msg::MarkerArray & a2) const
   -> void
@@ -1562,6 +1699,20 @@ auto HdMapUtils::overwriteLaneletsCenterline() -> void
   }
 }
 
+auto HdMapUtils::precomputeLaneletGeometry() -> void
+{
+  std::vector<LaneletGeometryTable::Entry> entries;
+  entries.reserve(lanelet_map_ptr_->laneletLayer.size());
+  for (const auto & lanelet_obj : lanelet_map_ptr_->laneletLayer) {
+    auto center_points = calculateCenterPoints(lanelet_obj.id());
+    auto spline = std::make_shared<math::geometry::CatmullRomSpline>(center_points);
+    entries.push_back(
+      {lanelet_obj.id(), std::move(center_points), std::move(spline),
+       lanelet::utils::getLaneletLength2d(lanelet_obj)});
+  }
+  lanelet_geometry_table_ = LaneletGeometryTable(std::move(entries));
+}
+
 auto HdMapUtils::findNearestIndexPair(
   const std::vector<double> & accumulated_lengths, const double target_length) const
   -> std::pair<std::size_t, std::size_t>
@@ -1600,18 +1751,9 @@ auto HdMapUtils::getRightOfWayLaneletIds(const lanelet::Ids & lanelet_ids) const
   return ret;
 }
 
-auto HdMapUtils::getRightOfWayLaneletIds(lanelet::Id lanelet_id) const -> lanelet::Ids
+auto HdMapUtils::getRightOfWayLaneletIds(lanelet::Id lanelet_id) const -> LaneletIdsView
 {
-  lanelet::Ids ids;
-  for (const auto & right_of_way :
-       lanelet_map_ptr_->laneletLayer.get(lanelet_id).regulatoryElementsAs<lanelet::RightOfWay>()) {
-    for (const auto & ll : right_of_way->rightOfWayLanelets()) {
-      if (lanelet_id != ll.id()) {
-        ids.push_back(ll.id());
-      }
-    }
-  }
-  return ids;
+  return findAdjacentLaneletIds(right_of_way_lanelet_ids_, lanelet_id);
 }
 
 auto HdMapUtils::getTrafficSignRegElementsOnPath(const lanelet::Ids & lanelet_ids) const
@@ -0,0 +1,202 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <lanelet2_io/io_handlers/Serialize.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <fstream>
+#include <lanelet2_extension/utility/utilities.hpp>
+#include <scenario_simulator_exception/exception.hpp>
+#include <sstream>
+#include <string>
+#include <traffic_simulator/hdmap_utils/map_snapshot.hpp>
+#include <vector>
+
+namespace hdmap_utils
+{
+struct MapSnapshot::Header
+{
+  static constexpr std::uint64_t magic = 0x5353'4D41'5053'4E50;  // "SSMAPSNP"
+
+  std::uint64_t signature;
+
+  std::uint32_t version;
+
+  std::uint32_t lanelet_id_size;
+
+  std::uint64_t lanelet2_map_hash;
+
+  std::uint64_t lanelet_length_count;
+
+  std::uint64_t lanelet_map_size;
+
+  auto getLaneletLengths() const noexcept
+  {
+    return reinterpret_cast<const LaneletLength *>(this + 1);
+  }
+
+  auto getLaneletMap() const noexcept
+  {
+    return reinterpret_cast<const char *>(getLaneletLengths() + lanelet_length_count);
+  }
+};
+
+MapSnapshot::MapSnapshot(void * region, std::size_t size) : region_(region), size_(size) {}
+
+MapSnapshot::~MapSnapshot() { munmap(region_, size_); }
+
+auto MapSnapshot::header() const noexcept -> const Header &
+{
+  return *static_cast<const Header *>(region_);
+}
+
+auto MapSnapshot::getPath(const boost::filesystem::path & lanelet2_map_path)
+  -> boost::filesystem::path
+{
+  return boost::filesystem::path(lanelet2_map_path).replace_extension(".snapshot");
+}
+
+auto MapSnapshot::hash(const boost::filesystem::path & lanelet2_map_path) -> std::uint64_t
+{
+  std::ifstream file(lanelet2_map_path.string(), std::ios::binary);
+  if (not file) {
+    THROW_SIMULATION_ERROR("Failed to open lanelet map ", lanelet2_map_path.string());
+  }
+  std::uint64_t hash = 0xCBF2'9CE4'8422'2325;
+  std::vector<char> buffer(1 << 20);
+  while (file.read(buffer.data(), buffer.size()) or file.gcount() != 0) {
+    for (auto iter = buffer.begin(); iter != buffer.begin() + file.gcount(); ++iter) {
+      hash = (hash ^ static_cast<unsigned char>(*iter)) * 0x0000'0100'0000'01B3;
+    }
+  }
+  return hash;
+}
+
+auto MapSnapshot::open(
+  const boost::filesystem::path & snapshot_path, const boost::filesystem::path & lanelet2_map_path)
+  -> std::unique_ptr<const MapSnapshot>
+{
+  const auto fd = ::open(snapshot_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 or static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+    close(fd);
+    return nullptr;
+  }
+  const auto region = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (region == MAP_FAILED) {
+    return nullptr;
+  }
+  /// @note Constructed here to unmap the region on every return below.
+  std::unique_ptr<const MapSnapshot> snapshot(new MapSnapshot(region, status.st_size));
+  if (const auto & header = snapshot->header();
+      header.signature == Header::magic and header.version == version and
+      header.lanelet_id_size == sizeof(lanelet::Id) and
+      sizeof(Header) + header.lanelet_length_count * sizeof(LaneletLength) +
+          header.lanelet_map_size ==
+        snapshot->size_ and
+      header.lanelet2_map_hash == hash(lanelet2_map_path)) {
+    return snapshot;
+  } else {
+    return nullptr;
+  }
+}
+
+auto MapSnapshot::write(
+  const boost::filesystem::path & snapshot_path, const boost::filesystem::path & lanelet2_map_path,
+  const lanelet::LaneletMap & lanelet_map) -> void
+{
+  std::vector<LaneletLength> lanelet_lengths;
+  lanelet_lengths.reserve(lanelet_map.laneletLayer.size());
+  for (const auto & lanelet : lanelet_map.laneletLayer) {
+    lanelet_lengths.push_back({lanelet.id(), lanelet::utils::getLaneletLength2d(lanelet)});
+  }
+  std::sort(lanelet_lengths.begin(), lanelet_lengths.end(), [](const auto & lhs, const auto & rhs) {
+    return lhs.lanelet_id < rhs.lanelet_id;
+  });
+
+  /// @note Same layout as HdMapUtils::toMapBin, the id counter follows the map.
+  std::stringstream lanelet_map_stream;
+  {
+    boost::archive::binary_oarchive archive(lanelet_map_stream);
+    archive << lanelet_map;
+    auto id_counter = lanelet::utils::getId();
+    archive << id_counter;
+  }
+  const auto lanelet_map_data = lanelet_map_stream.str();
+
+  Header header;
+  header.signature = Header::magic;
+  header.version = version;
+  header.lanelet_id_size = sizeof(lanelet::Id);
+  header.lanelet2_map_hash = hash(lanelet2_map_path);
+  header.lanelet_length_count = lanelet_lengths.size();
+  header.lanelet_map_size = lanelet_map_data.size();
+
+  const auto temporary_path = boost::filesystem::path(snapshot_path).concat(
+    "." + boost::filesystem::unique_path().string());
+  {
+    std::ofstream file(temporary_path.string(), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(
+      reinterpret_cast<const char *>(lanelet_lengths.data()),
+      lanelet_lengths.size() * sizeof(LaneletLength));
+    file.write(lanelet_map_data.data(), lanelet_map_data.size());
+    if (not file) {
+      boost::system::error_code error;
+      boost::filesystem::remove(temporary_path, error);
+      THROW_SIMULATION_ERROR("Failed to write map snapshot ", temporary_path.string());
+    }
+  }
+  boost::filesystem::rename(temporary_path, snapshot_path);
+}
+
+auto MapSnapshot::getLaneletLength(lanelet::Id lanelet_id) const -> std::optional<double>
+{
+  const auto begin = header().getLaneletLengths();
+  const auto end = begin + header().lanelet_length_count;
+  if (const auto iter = std::lower_bound(
+        begin, end, lanelet_id, [](const auto & each, auto id) { return each.lanelet_id < id; });
+      iter != end and iter->lanelet_id == lanelet_id) {
+    return iter->length;
+  } else {
+    return std::nullopt;
+  }
+}
+
+auto MapSnapshot::loadLaneletMap() const -> lanelet::LaneletMapPtr
+{
+  boost::iostreams::stream<boost::iostreams::array_source> stream(
+    header().getLaneletMap(), header().lanelet_map_size);
+  boost::archive::binary_iarchive archive(stream);
+  auto lanelet_map = std::make_shared<lanelet::LaneletMap>();
+  archive >> *lanelet_map;
+  lanelet::Id id_counter;
+  archive >> id_counter;
+  lanelet::utils::registerId(id_counter);
+  return lanelet_map;
+}
+}  // namespace hdmap_utils
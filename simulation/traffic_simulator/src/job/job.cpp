@@ -18,23 +18,12 @@ namespace traffic_simulator
 {
 namespace job
 {
-Job::Job(
-  const std::function<bool(const double)> & func_on_update,
-  const std::function<void()> & func_on_cleanup, job::Type type, bool exclusive, job::Event event)
-: func_on_update_(func_on_update),
-  func_on_cleanup_(func_on_cleanup),
-  job_duration_(0.0),
-  type(type),
-  exclusive(exclusive),
-  event(event)
-{
-  status_ = Status::ACTIVE;
-}
+Job::~Job() { functions_->~FunctionsBase(); }
 
 void Job::inactivate()
 {
   status_ = Status::INACTIVE;
-  func_on_cleanup_();
+  functions_->onCleanup();
 }
 
 Status Job::getStatus() const { return status_; }
@@ -43,7 +32,7 @@ void Job::onUpdate(const double step_time)
 {
   switch (status_) {
     case Status::ACTIVE:
-      if (func_on_update_(job_duration_)) {
+      if (functions_->onUpdate(job_duration_)) {
         inactivate();
       }
       job_duration_ = job_duration_ + step_time;
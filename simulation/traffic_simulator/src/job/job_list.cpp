@@ -12,30 +12,48 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <rclcpp/rclcpp.hpp>
+#include <algorithm>
 #include <traffic_simulator/job/job_list.hpp>
 
 namespace traffic_simulator
 {
 namespace job
 {
-void JobList::append(
-  const std::function<bool(double)> & func_on_update, const std::function<void()> & func_on_cleanup,
-  job::Type type, bool exclusive, const job::Event event)
+void JobList::remove(std::size_t key)
 {
-  for (auto & job : list_) {
-    if (job.type == type && job.exclusive == exclusive && job.getStatus() == job::Status::ACTIVE) {
-      job.inactivate();
+  if (auto & job = jobs_[key]) {
+    auto & keys = getKeys(job->event);
+    keys.erase(std::find(keys.begin(), keys.end(), key));
+    if (job->getStatus() == job::Status::ACTIVE) {
+      job->inactivate();
     }
+    job.reset();
+  }
+}
+
+void JobList::clear()
+{
+  for (auto & job : jobs_) {
+    job.reset();
+  }
+  for (auto & keys : keys_) {
+    keys.clear();
   }
-  list_.emplace_back(Job(func_on_update, func_on_cleanup, type, exclusive, event));
 }
 
 void JobList::update(const double step_time, const job::Event event)
 {
-  for (auto & job : list_) {
-    if (job.event == event) {
-      job.onUpdate(step_time);
+  auto & keys = getKeys(event);
+  for (std::size_t i = 0; i < keys.size();) {
+    const auto key = keys[i];
+    jobs_[key]->onUpdate(step_time);
+    if (i < keys.size() and keys[i] == key) {
+      if (jobs_[key]->getStatus() == job::Status::INACTIVE) {
+        keys.erase(keys.begin() + i);
+        jobs_[key].reset();
+      } else {
+        ++i;
+      }
     }
   }
 }
@@ -27,7 +27,6 @@
 #include <string>
 #include <traffic_simulator/data_type/lanelet_pose.hpp>
 #include <traffic_simulator/traffic/traffic_controller.hpp>
-#include <traffic_simulator/traffic/traffic_sink.hpp>
 #include <utility>
 #include <vector>
 
@@ -59,9 +58,18 @@ void TrafficController::autoSink()
       lanelet_pose.lanelet_id = lanelet_id;
       lanelet_pose.s = hdmap_utils_->getLaneletLength(lanelet_id);
       const auto pose = hdmap_utils_->toMapPose(lanelet_pose);
-      addModule<traffic_simulator::traffic::TrafficSink>(
-        1, pose.pose.position, get_entity_names_function, get_entity_pose_function,
-        despawn_function);
+      sinks_.add(pose.pose.position, 1);
+    }
+  }
+}
+
+void TrafficController::executeSinks()
+{
+  if (not sinks_.empty()) {
+    for (const auto & name : get_entity_names_function()) {
+      if (sinks_.contains(get_entity_pose_function(name).position)) {
+        despawn_function(name);
+      }
     }
   }
 }
@@ -71,6 +79,7 @@ void TrafficController::execute()
   for (const auto & module : modules_) {
     module->execute();
   }
+  executeSinks();
 }
 }  // namespace traffic
 }  // namespace traffic_simulator
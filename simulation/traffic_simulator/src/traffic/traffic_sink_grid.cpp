@@ -0,0 +1,77 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <geometry/distance.hpp>
+#include <limits>
+#include <traffic_simulator/traffic/traffic_sink_grid.hpp>
+#include <tuple>
+
+namespace traffic_simulator
+{
+namespace traffic
+{
+void TrafficSinkGrid::add(const geometry_msgs::msg::Point & position, double radius)
+{
+  sinks_.push_back({0, 0, position, radius});
+  cell_size_ = std::max({cell_size_, radius, std::numeric_limits<double>::epsilon()});
+  built_ = false;
+}
+
+auto TrafficSinkGrid::getCell(double value) const -> std::int64_t
+{
+  return static_cast<std::int64_t>(std::floor(value / cell_size_));
+}
+
+auto TrafficSinkGrid::build() const -> void
+{
+  for (auto & sink : sinks_) {
+    sink.cell_x = getCell(sink.position.x);
+    sink.cell_y = getCell(sink.position.y);
+  }
+  std::sort(sinks_.begin(), sinks_.end(), [](const auto & lhs, const auto & rhs) {
+    return std::tie(lhs.cell_x, lhs.cell_y) < std::tie(rhs.cell_x, rhs.cell_y);
+  });
+  built_ = true;
+}
+
+auto TrafficSinkGrid::contains(const geometry_msgs::msg::Point & point) const -> bool
+{
+  if (sinks_.empty()) {
+    return false;
+  } else if (not built_) {
+    build();
+  }
+  const auto cell_x = getCell(point.x);
+  const auto cell_y = getCell(point.y);
+  for (auto x = cell_x - 1; x <= cell_x + 1; ++x) {
+    /// @note Cells of the same x are contiguous, so the 3 cells of each column are one range.
+    const auto begin = std::lower_bound(
+      sinks_.begin(), sinks_.end(), std::make_pair(x, cell_y - 1),
+      [](const auto & sink, const auto & cell) {
+        return std::tie(sink.cell_x, sink.cell_y) < std::tie(cell.first, cell.second);
+      });
+    for (auto iter = begin; iter != sinks_.end() and iter->cell_x == x and
+                            iter->cell_y <= cell_y + 1;
+         ++iter) {
+      if (math::geometry::getDistance(iter->position, point) <= iter->radius) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+}  // namespace traffic
+}  // namespace traffic_simulator
@@ -0,0 +1,80 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <geometry/distance.hpp>
+#include <iomanip>
+#include <scenario_simulator_exception/exception.hpp>
+#include <string>
+#include <traffic_simulator/traffic/traffic_source.hpp>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace traffic_simulator
+{
+namespace traffic
+{
+TrafficSource::TrafficSource(
+  const std::string & name, double rate, const geometry_msgs::msg::Pose & pose, double clearance,
+  const std::function<double(void)> & get_current_time_function,
+  const std::function<std::vector<std::string>(void)> & get_entity_names_function,
+  const std::function<geometry_msgs::msg::Pose(const std::string &)> & get_entity_pose_function,
+  const std::function<bool(const std::string &, const geometry_msgs::msg::Pose &)> & spawn_function)
+: TrafficModuleBase(),
+  name(name),
+  rate(rate),
+  pose(pose),
+  clearance(clearance),
+  get_current_time_function(get_current_time_function),
+  get_entity_names_function(get_entity_names_function),
+  get_entity_pose_function(get_entity_pose_function),
+  spawn_function(spawn_function)
+{
+  if (not(rate > 0.0)) {
+    THROW_SEMANTIC_ERROR("rate of traffic source ", std::quoted(name), " must be positive.");
+  }
+}
+
+void TrafficSource::execute()
+{
+  const auto current_time = get_current_time_function();
+  if (last_spawn_time_ and current_time - last_spawn_time_.value() < 1.0 / rate) {
+    return;
+  }
+  const auto names = get_entity_names_function();
+  if (std::any_of(names.begin(), names.end(), [this](const auto & each) {
+        return math::geometry::getDistance(pose, get_entity_pose_function(each)) < clearance;
+      })) {
+    return;
+  }
+  const std::unordered_set<std::string> spawned_names(names.begin(), names.end());
+  const auto iter =
+    std::find_if(entity_names_.begin(), entity_names_.end(), [&](const auto & each) {
+      return spawned_names.count(each) == 0;
+    });
+  const auto entity_name = iter != entity_names_.end() ? *iter : [&]() {
+    /// @note Skip names taken by entities not spawned by this source, spawning them would throw.
+    for (auto number = entity_names_.size();; ++number) {
+      if (auto new_name = name + "_" + std::to_string(number); spawned_names.count(new_name) == 0) {
+        return entity_names_.emplace_back(std::move(new_name));
+      }
+    }
+  }();
+  if (spawn_function(entity_name, pose)) {
+    last_spawn_time_ = current_time;
+  }
+}
+}  // namespace traffic
+}  // namespace traffic_simulator
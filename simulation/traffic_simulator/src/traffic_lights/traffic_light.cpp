@@ -198,6 +198,15 @@ TrafficLight::TrafficLight(const lanelet::Id lanelet_id, hdmap_utils::HdMapUtils
 {
 }
 
+auto TrafficLight::assign(const std::string & states) -> void
+{
+  const auto previous_bulbs = bulbs;
+  const auto previous_version = version_;
+  clear();
+  set(states);
+  version_ = previous_version + (bulbs != previous_bulbs);
+}
+
 auto TrafficLight::set(const std::string & states) -> void
 {
   auto split = [](auto && given) {
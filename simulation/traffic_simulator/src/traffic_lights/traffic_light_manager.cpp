@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <string>
 #include <traffic_simulator/traffic_lights/traffic_light_manager.hpp>
 #include <type_traits>
@@ -27,14 +30,24 @@ TrafficLightManager::TrafficLightManager(const std::shared_ptr<hdmap_utils::HdMa
 {
 }
 
-auto TrafficLightManager::hasAnyLightChanged() -> bool
+auto TrafficLightManager::getVersion() const -> std::size_t
 {
-  return true;
-  // return std::any_of(
-  //   std::begin(getTrafficLights()), std::end(getTrafficLights()), [](auto && id_and_traffic_light) {
-  //     return id_and_traffic_light.second.colorChanged() or
-  //            id_and_traffic_light.second.arrowChanged();
-  //   });
+  /// @note Traffic lights are never removed, so adding one increases the sum too.
+  return std::accumulate(
+    std::begin(traffic_lights_), std::end(traffic_lights_), traffic_lights_.size(),
+    [](auto sum, auto && id_and_traffic_light) {
+      return sum + id_and_traffic_light.second.getVersion();
+    });
+}
+
+auto TrafficLightManager::hasAnyLightChanged() const -> bool
+{
+  return std::any_of(
+    std::begin(traffic_lights_), std::end(traffic_lights_), [this](auto && id_and_traffic_light) {
+      const auto iter = delta_versions_.find(id_and_traffic_light.first);
+      return iter == std::end(delta_versions_) or
+             iter->second != id_and_traffic_light.second.getVersion();
+    });
 }
 
 auto TrafficLightManager::getTrafficLight(const lanelet::Id traffic_light_id) -> TrafficLight &
@@ -49,6 +62,16 @@ auto TrafficLightManager::getTrafficLight(const lanelet::Id traffic_light_id) ->
   }
 }
 
+auto TrafficLightManager::findTrafficLight(const lanelet::Id traffic_light_id) const
+  -> const TrafficLight *
+{
+  if (auto iter = traffic_lights_.find(traffic_light_id); iter != std::end(traffic_lights_)) {
+    return &iter->second;
+  } else {
+    return nullptr;
+  }
+}
+
 auto TrafficLightManager::getTrafficLights() const -> const TrafficLightMap &
 {
   return traffic_lights_;
@@ -77,14 +100,43 @@ auto TrafficLightManager::getTrafficLights(const lanelet::Id lanelet_id)
 }
 
 auto TrafficLightManager::generateUpdateTrafficLightsRequest()
-  -> simulation_api_schema::UpdateTrafficLightsRequest
+  -> const simulation_api_schema::UpdateTrafficLightsRequest &
+{
+  if (const auto version = getVersion(); request_version_ != version) {
+    request_.Clear();
+    for (auto && [lanelet_id, traffic_light] : traffic_lights_) {
+      *request_.add_states() = static_cast<simulation_api_schema::TrafficSignal>(traffic_light);
+    }
+    request_version_ = version;
+  }
+  return request_;
+}
+
+auto TrafficLightManager::generateUpdateTrafficLightsDelta(const bool delta)
+  -> std::optional<simulation_api_schema::UpdateTrafficLightsRequest>
 {
   simulation_api_schema::UpdateTrafficLightsRequest update_traffic_lights_request;
+  update_traffic_lights_request.set_delta(true);
   for (auto && [lanelet_id, traffic_light] : traffic_lights_) {
-    *update_traffic_lights_request.add_states() =
-      static_cast<simulation_api_schema::TrafficSignal>(traffic_light);
+    const auto version = traffic_light.getVersion();
+    if (const auto [iter, inserted] = delta_versions_.try_emplace(lanelet_id, version);
+        inserted or std::exchange(iter->second, version) != version) {
+      *update_traffic_lights_request.add_states() =
+        static_cast<simulation_api_schema::TrafficSignal>(traffic_light);
+    }
+  }
+  if (delta and ++deltas_since_keyframe_ < keyframe_interval) {
+    if (update_traffic_lights_request.states().empty()) {
+      return std::nullopt;
+    } else {
+      return update_traffic_lights_request;
+    }
+  } else if (delta or not update_traffic_lights_request.states().empty()) {
+    deltas_since_keyframe_ = 0;
+    return generateUpdateTrafficLightsRequest();
+  } else {
+    return std::nullopt;
   }
-  return update_traffic_lights_request;
 }
 
 }  // namespace traffic_simulator
@@ -44,8 +44,9 @@ auto TrafficLightMarkerPublisher::drawMarkers() const -> void
 
 auto TrafficLightMarkerPublisher::publish() -> void
 {
-  if (traffic_light_manager_->hasAnyLightChanged()) {
+  if (const auto version = traffic_light_manager_->getVersion(); drawn_version_ != version) {
     deleteAllMarkers();
+    drawn_version_ = version;
   }
 
   drawMarkers();
@@ -0,0 +1,196 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <traffic_simulator/data_type/entity_status_table.hpp>
+#include <traffic_simulator/helper/helper.hpp>
+#include <vector>
+
+auto makeHdMapUtils() -> std::shared_ptr<hdmap_utils::HdMapUtils>
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  return std::make_shared<hdmap_utils::HdMapUtils>(path, origin);
+}
+
+/**
+ * @note Entities at the start and the middle of lanelets, which are lane matched, and entities
+ * scattered around the map origin, which are not.
+ */
+auto makeStatuses(const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils)
+  -> traffic_simulator::EntityStatusTable::Statuses
+{
+  traffic_simulator::EntityStatusTable::Statuses statuses;
+  auto lanelet_ids = hdmap_utils->getLaneletIds();
+  std::sort(lanelet_ids.begin(), lanelet_ids.end());
+  lanelet_ids.resize(std::min<std::size_t>(lanelet_ids.size(), 40));
+  for (const auto lanelet_id : lanelet_ids) {
+    for (const auto ratio : {0.0, 0.5}) {
+      traffic_simulator::EntityStatus status;
+      status.name = "lanelet_" + std::to_string(lanelet_id) + "_" + std::to_string(ratio);
+      status.lanelet_pose = traffic_simulator::helper::constructLaneletPose(
+        lanelet_id, hdmap_utils->getLaneletLength(lanelet_id) * ratio);
+      status.lanelet_pose_valid = true;
+      status.pose = hdmap_utils->toMapPose(status.lanelet_pose).pose;
+      statuses.emplace(
+        status.name, traffic_simulator::CanonicalizedEntityStatus(status, hdmap_utils));
+    }
+  }
+  for (int i = 0; i < 40; ++i) {
+    traffic_simulator::EntityStatus status;
+    status.name = "free_" + std::to_string(i);
+    status.pose.position.x = (i % 8 - 4) * 13.7;
+    status.pose.position.y = (i / 8 - 2) * -21.3;
+    status.lanelet_pose_valid = false;
+    statuses.emplace(
+      status.name, traffic_simulator::CanonicalizedEntityStatus(status, hdmap_utils));
+  }
+  return statuses;
+}
+
+auto names(const std::vector<const traffic_simulator::EntityStatusTable::value_type *> & entities)
+  -> std::vector<std::string>
+{
+  std::vector<std::string> names;
+  for (const auto each : entities) {
+    names.push_back(each->first);
+  }
+  return names;
+}
+
+auto sorted(std::vector<std::string> names) -> std::vector<std::string>
+{
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+/**
+ * @note Testcase for the grid index of EntityStatusTable.
+ * Entities within a radius are supposed to be the same as the ones found by a linear scan, for
+ * small and large cells and for queries which fall back to the linear scan.
+ */
+TEST(EntityStatusTable, GetEntitiesWithin)
+{
+  const auto hdmap_utils = makeHdMapUtils();
+  for (const auto grid_cell_size : {5.0, 20.0}) {
+    const traffic_simulator::EntityStatusTable table(makeStatuses(hdmap_utils), grid_cell_size);
+    std::vector<geometry_msgs::msg::Point> points;
+    for (const auto & [name, status] : table.getStatuses()) {
+      points.push_back(status.getMapPose().position);
+      points.back().x += 3.3;
+    }
+    for (const auto & point : points) {
+      for (const auto radius : {0.0, 4.0, 25.0, 150.0, 1.0e4}) {
+        std::vector<std::string> expected;
+        for (const auto & [name, status] : table.getStatuses()) {
+          const auto position = status.getMapPose().position;
+          if (std::hypot(position.x - point.x, position.y - point.y) <= radius) {
+            expected.push_back(name);
+          }
+        }
+        EXPECT_EQ(sorted(names(table.getEntitiesWithin(point, radius))), sorted(expected));
+      }
+      EXPECT_TRUE(table.getEntitiesWithin(point, -1.0).empty());
+    }
+  }
+}
+
+/**
+ * @note Testcase for the lanelet index of EntityStatusTable.
+ * Entities on lanelets are supposed to be the same as the ones found by a linear scan, in the
+ * order of the given lanelet ids, without duplicates and without entities not lane matched.
+ */
+TEST(EntityStatusTable, GetEntitiesOnLanelets)
+{
+  const auto hdmap_utils = makeHdMapUtils();
+  const traffic_simulator::EntityStatusTable table(makeStatuses(hdmap_utils));
+  auto lanelet_ids = hdmap_utils->getLaneletIds();
+  std::sort(lanelet_ids.begin(), lanelet_ids.end());
+  std::vector<lanelet::Ids> queries = {{}, {-1}};
+  for (std::size_t i = 0; i + 3 < lanelet_ids.size() and i < 50; ++i) {
+    queries.push_back({lanelet_ids[i]});
+    queries.push_back({lanelet_ids[i + 3], lanelet_ids[i], -1, lanelet_ids[i + 3]});
+  }
+  for (const auto & query : queries) {
+    std::vector<std::string> expected;
+    for (const auto lanelet_id : query) {
+      for (const auto & [name, status] : table.getStatuses()) {
+        if (
+          status.laneMatchingSucceed() and status.getLaneletPose().lanelet_id == lanelet_id and
+          std::find(expected.begin(), expected.end(), name) == expected.end()) {
+          expected.push_back(name);
+        }
+      }
+    }
+    EXPECT_EQ(names(table.getEntitiesOnLanelets(query)), expected);
+  }
+}
+
+/**
+ * @note Testcase for OtherEntityStatus.
+ * A view is supposed to hide its owner from every query, and its iterators are supposed to stay
+ * valid after the view itself is gone.
+ */
+TEST(OtherEntityStatus, ExcludesOwner)
+{
+  const auto hdmap_utils = makeHdMapUtils();
+  const auto table = std::make_shared<const traffic_simulator::EntityStatusTable>(
+    makeStatuses(hdmap_utils));
+  const std::string owner = "free_3";
+  const auto view = [&]() { return traffic_simulator::OtherEntityStatus(table, owner); };
+
+  auto begin = view().begin();
+  const auto end = view().end();
+  std::vector<std::string> iterated;
+  for (; begin != end; ++begin) {
+    iterated.push_back(begin->first);
+  }
+  std::vector<std::string> expected;
+  for (const auto & [name, status] : table->getStatuses()) {
+    if (name != owner) {
+      expected.push_back(name);
+    }
+  }
+  EXPECT_EQ(sorted(iterated), sorted(expected));
+  EXPECT_EQ(view().size(), table->getStatuses().size() - 1);
+  EXPECT_EQ(view().count(owner), std::size_t(0));
+  EXPECT_EQ(view().count("free_4"), std::size_t(1));
+  EXPECT_THROW(view().at(owner), std::out_of_range);
+
+  const auto owner_position = table->getStatuses().at(owner).getMapPose().position;
+  const auto within = names(view().getEntitiesWithin(owner_position, 50.0));
+  EXPECT_EQ(std::count(within.begin(), within.end(), owner), 0);
+  EXPECT_EQ(within.size(), table->getEntitiesWithin(owner_position, 50.0).size() - 1);
+
+  EXPECT_TRUE(traffic_simulator::OtherEntityStatus().empty());
+  EXPECT_EQ(traffic_simulator::OtherEntityStatus().size(), std::size_t(0));
+  EXPECT_EQ(
+    traffic_simulator::OtherEntityStatus(table, "nobody").size(), table->getStatuses().size());
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
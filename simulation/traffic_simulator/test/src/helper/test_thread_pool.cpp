@@ -0,0 +1,96 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <traffic_simulator/helper/thread_pool.hpp>
+#include <vector>
+
+using traffic_simulator::helper::ThreadPool;
+
+/**
+ * @note Test that every index is processed exactly once.
+ */
+TEST(ThreadPool, parallelFor)
+{
+  ThreadPool pool(3);
+  std::vector<int> counts(1000, 0);
+  pool.parallelFor(counts.size(), [&](auto i) { ++counts[i]; });
+  for (const auto count : counts) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+/**
+ * @note Test that parallelFor called from inside a parallelFor of the same pool runs on the calling
+ * thread instead of waiting for the outer call forever.
+ */
+TEST(ThreadPool, parallelForNested)
+{
+  ThreadPool pool(3);
+  std::vector<std::atomic<int>> counts(16 * 16);
+  pool.parallelFor(16, [&](auto i) {
+    pool.parallelFor(16, [&](auto j) { ++counts[i * 16 + j]; });
+  });
+  for (const auto & count : counts) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+/**
+ * @note Test parallelFor of another pool called from inside a parallelFor, as the NPC logic does
+ * when it queries HdMapUtils, and a call back to the outer pool from there.
+ */
+TEST(ThreadPool, parallelForOfAnotherPool)
+{
+  ThreadPool outer(3);
+  ThreadPool inner(3);
+  std::atomic<int> count = 0;
+  outer.parallelFor(8, [&](auto) {
+    inner.parallelFor(8, [&](auto) { outer.parallelFor(2, [&](auto) { ++count; }); });
+  });
+  EXPECT_EQ(count, 8 * 8 * 2);
+}
+
+/**
+ * @note Test that an exception thrown by a nested call reaches the outermost caller and leaves the
+ * pool usable.
+ */
+TEST(ThreadPool, parallelForException)
+{
+  ThreadPool pool(3);
+  EXPECT_THROW(
+    pool.parallelFor(
+      16,
+      [&](auto i) {
+        pool.parallelFor(16, [&](auto j) {
+          if (i == 3 and j == 5) {
+            throw std::runtime_error("index");
+          }
+        });
+      }),
+    std::runtime_error);
+  std::atomic<int> count = 0;
+  pool.parallelFor(16, [&](auto) { pool.parallelFor(4, [&](auto) { ++count; }); });
+  EXPECT_EQ(count, 16 * 4);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,200 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <traffic_simulator/job/job_list.hpp>
+
+using traffic_simulator::job::Event;
+using traffic_simulator::job::Job;
+using traffic_simulator::job::JobList;
+using traffic_simulator::job::Type;
+
+/**
+ * @note Test appending a job of the same type and exclusivity as an active one.
+ * The old job should be cleaned up and never updated again, the new one should take its place.
+ */
+TEST(JobList, append_replaceSameType)
+{
+  JobList job_list;
+  std::string log;
+  job_list.append(
+    [&](double) { return log += "a", false; }, [&]() { log += "A"; }, Type::LINEAR_VELOCITY, true,
+    Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  job_list.append(
+    [&](double) { return log += "b", false; }, [&]() { log += "B"; }, Type::LINEAR_VELOCITY, true,
+    Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  EXPECT_EQ(log, "aAbb");
+}
+
+/**
+ * @note Test appending a job of the same type but different exclusivity as an active one.
+ * Both jobs should be kept and updated in the order they were appended.
+ */
+TEST(JobList, append_keepDifferentExclusivity)
+{
+  JobList job_list;
+  std::string log;
+  job_list.append(
+    [&](double) { return log += "a", false; }, [&]() { log += "A"; }, Type::LINEAR_VELOCITY, true,
+    Event::PRE_UPDATE);
+  job_list.append(
+    [&](double) { return log += "b", false; }, [&]() { log += "B"; }, Type::LINEAR_VELOCITY, false,
+    Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  EXPECT_EQ(log, "ab");
+}
+
+/**
+ * @note Test removal of a job that finishes during update.
+ * It should be cleaned up exactly once and never updated again, while the others keep running.
+ * The duration passed to the job should be the sum of the previous step times.
+ */
+TEST(JobList, update_removeFinished)
+{
+  JobList job_list;
+  std::string log;
+  job_list.append(
+    [&](double duration) { return log += "a", duration >= 0.15; }, [&]() { log += "A"; },
+    Type::LINEAR_VELOCITY, true, Event::PRE_UPDATE);
+  job_list.append(
+    [&](double) { return log += "b", false; }, [&]() { log += "B"; }, Type::LINEAR_ACCELERATION,
+    true, Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  EXPECT_EQ(log, "ababaAbb");
+}
+
+/**
+ * @note Test appending a job to the slot of a finished one.
+ * The finished job should not be cleaned up a second time.
+ */
+TEST(JobList, append_afterFinished)
+{
+  JobList job_list;
+  std::string log;
+  job_list.append(
+    [&](double) { return log += "a", true; }, [&]() { log += "A"; }, Type::LINEAR_VELOCITY, true,
+    Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  job_list.append(
+    [&](double) { return log += "b", false; }, [&]() { log += "B"; }, Type::LINEAR_VELOCITY, true,
+    Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  EXPECT_EQ(log, "aAb");
+}
+
+/**
+ * @note Test that update only visits the jobs of the given event, in the order they were appended.
+ */
+TEST(JobList, update_event)
+{
+  JobList job_list;
+  std::string log;
+  job_list.append(
+    [&](double) { return log += "a", false; }, [&]() {}, Type::LINEAR_VELOCITY, true,
+    Event::POST_UPDATE);
+  job_list.append(
+    [&](double) { return log += "b", false; }, [&]() {}, Type::LINEAR_ACCELERATION, true,
+    Event::PRE_UPDATE);
+  job_list.append(
+    [&](double) { return log += "c", false; }, [&]() {}, Type::STAND_STILL_DURATION, true,
+    Event::POST_UPDATE);
+  job_list.append(
+    [&](double) { return log += "d", false; }, [&]() {}, Type::TRAVELED_DISTANCE, true,
+    Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  EXPECT_EQ(log, "bd");
+  job_list.update(0.1, Event::POST_UPDATE);
+  EXPECT_EQ(log, "bdac");
+}
+
+/**
+ * @note Test moving a job to another event by appending a job of the same type and exclusivity.
+ */
+TEST(JobList, append_replaceOtherEvent)
+{
+  JobList job_list;
+  std::string log;
+  job_list.append(
+    [&](double) { return log += "a", false; }, [&]() { log += "A"; }, Type::LINEAR_VELOCITY, true,
+    Event::PRE_UPDATE);
+  job_list.append(
+    [&](double) { return log += "b", false; }, [&]() { log += "B"; }, Type::LINEAR_VELOCITY, true,
+    Event::POST_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  job_list.update(0.1, Event::POST_UPDATE);
+  EXPECT_EQ(log, "Ab");
+}
+
+/**
+ * @note Test a job whose callables do not fit in the inline storage of Job.
+ * It should behave like an inline one and release its captures once removed.
+ */
+TEST(JobList, append_heapFallback)
+{
+  JobList job_list;
+  std::string log;
+  auto alive = std::make_shared<int>(0);
+  const std::array<double, 32> payload{1.0};
+  auto func_on_update = [&, payload, alive](double) { return log += "a", payload[0] > 0.0; };
+  static_assert(sizeof(func_on_update) > Job::inline_capacity);
+  job_list.append(
+    std::move(func_on_update), [&]() { log += "A"; }, Type::LINEAR_VELOCITY, true,
+    Event::PRE_UPDATE);
+  EXPECT_EQ(alive.use_count(), 2);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  EXPECT_EQ(log, "aA");
+  EXPECT_EQ(alive.use_count(), 1);
+}
+
+/**
+ * @note Test clear. The jobs should be destroyed without being cleaned up or updated again.
+ */
+TEST(JobList, clear)
+{
+  JobList job_list;
+  std::string log;
+  auto alive = std::make_shared<int>(0);
+  job_list.append(
+    [&, alive](double) { return log += "a", false; }, [&]() { log += "A"; },
+    Type::LINEAR_VELOCITY, true, Event::PRE_UPDATE);
+  job_list.append(
+    [&](double) { return log += "b", false; }, [&]() { log += "B"; }, Type::LINEAR_ACCELERATION,
+    true, Event::POST_UPDATE);
+  job_list.clear();
+  EXPECT_EQ(alive.use_count(), 1);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  job_list.update(0.1, Event::POST_UPDATE);
+  EXPECT_EQ(log, "");
+  job_list.append(
+    [&](double) { return log += "c", false; }, [&]() { log += "C"; }, Type::LINEAR_VELOCITY, true,
+    Event::PRE_UPDATE);
+  job_list.update(0.1, Event::PRE_UPDATE);
+  EXPECT_EQ(log, "c");
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
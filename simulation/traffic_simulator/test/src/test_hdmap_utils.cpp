@@ -14,10 +14,23 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <ament_index_cpp/get_package_share_directory.hpp>
+#include <fstream>
+#include <lanelet2_core/Exceptions.h>
+#include <lanelet2_core/geometry/Lanelet.h>
+#include <lanelet2_extension/utility/query.hpp>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_routing/RoutingGraphContainer.h>
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+#include <scenario_simulator_exception/exception.hpp>
 #include <string>
+#include <traffic_simulator/data_type/lanelet_pose.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <traffic_simulator/hdmap_utils/map_snapshot.hpp>
 #include <traffic_simulator/helper/helper.hpp>
+#include <utility>
+#include <vector>
 
 TEST(HdMapUtils, Construct)
 {
@@ -59,6 +72,58 @@ TEST(HdMapUtils, MatchToLane)
   }
 }
 
+/**
+ * @note Testcase for the batch lane matching.
+ * Each result is supposed to be the same as the one of toLaneletPose for the same pose, including
+ * poses that match no lanelet.
+ */
+TEST(HdMapUtils, ToLaneletPoses)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  traffic_simulator_msgs::msg::BoundingBox bbox;
+  bbox.center.x = 0.0;
+  bbox.center.y = 0.0;
+  bbox.dimensions.x = 4.0;
+  bbox.dimensions.y = 2.0;
+  std::vector<std::pair<geometry_msgs::msg::Pose, traffic_simulator_msgs::msg::BoundingBox>>
+    poses;
+  for (const auto lanelet_id : {120659, 34411, 34981, 34585}) {
+    for (const auto s : {1.0, 10.0}) {
+      for (const auto offset : {0.0, 0.5}) {
+        poses.emplace_back(
+          hdmap_utils
+            .toMapPose(traffic_simulator::helper::constructLaneletPose(lanelet_id, s, offset))
+            .pose,
+          bbox);
+      }
+    }
+  }
+  geometry_msgs::msg::Pose unmatchable_pose;
+  unmatchable_pose.position.x = 1.0e5;
+  unmatchable_pose.position.y = -1.0e5;
+  poses.emplace_back(unmatchable_pose, bbox);
+  poses.emplace(poses.begin() + poses.size() / 2, unmatchable_pose, bbox);
+
+  for (const auto include_crosswalk : {false, true}) {
+    const auto lanelet_poses = hdmap_utils.toLaneletPoses(poses, include_crosswalk);
+    ASSERT_EQ(lanelet_poses.size(), poses.size());
+    std::size_t matched = 0;
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+      const auto expected =
+        hdmap_utils.toLaneletPose(poses[i].first, poses[i].second, include_crosswalk);
+      EXPECT_EQ(lanelet_poses[i], expected);
+      matched += expected ? 1 : 0;
+    }
+    EXPECT_GT(matched, std::size_t(0));
+    EXPECT_LT(matched, poses.size());
+  }
+}
+
 TEST(HdMapUtils, AlongLaneletPose)
 {
   std::string path =
@@ -313,6 +378,264 @@ TEST(HdMapUtils, CanonicalizeAll)
   EXPECT_EQ(canonicalized_lanelet_poses[0].s, non_canonicalized_lanelet_s);
 }
 
+/**
+ * @note Testcase for the lanelet geometry precomputed at map load.
+ * Center points, splines and lengths are supposed to be the same as the lazily cached ones.
+ */
+TEST(HdMapUtils, PrecomputeLaneletGeometry)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils lazy_hdmap_utils(path, origin);
+  hdmap_utils::HdMapUtils eager_hdmap_utils(path, origin, true);
+
+  for (const auto lanelet_id : lazy_hdmap_utils.getLaneletIds()) {
+    EXPECT_EQ(
+      lazy_hdmap_utils.getCenterPoints(lanelet_id), eager_hdmap_utils.getCenterPoints(lanelet_id));
+    EXPECT_DOUBLE_EQ(
+      lazy_hdmap_utils.getLaneletLength(lanelet_id),
+      eager_hdmap_utils.getLaneletLength(lanelet_id));
+    EXPECT_DOUBLE_EQ(
+      lazy_hdmap_utils.getCenterPointsSpline(lanelet_id)->getLength(),
+      eager_hdmap_utils.getCenterPointsSpline(lanelet_id)->getLength());
+  }
+}
+
+/**
+ * @note Testcase for the map snapshot compiled by compile_lanelet2_map.
+ * A map loaded from its snapshot is supposed to be the same as the one loaded from the .osm file,
+ * and a snapshot of an .osm file which has changed since is supposed to be ignored.
+ */
+TEST(HdMapUtils, MapSnapshot)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  const auto directory =
+    boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(directory);
+  const auto copied_path = directory / "lanelet2_map.osm";
+  boost::filesystem::copy_file(path, copied_path);
+
+  hdmap_utils::HdMapUtils osm_hdmap_utils(path, origin);
+  osm_hdmap_utils.writeMapSnapshot(hdmap_utils::MapSnapshot::getPath(copied_path));
+  ASSERT_TRUE(hdmap_utils::MapSnapshot::open(
+    hdmap_utils::MapSnapshot::getPath(copied_path), copied_path));
+
+  hdmap_utils::HdMapUtils snapshot_hdmap_utils(copied_path, origin);
+  EXPECT_EQ(osm_hdmap_utils.getLaneletIds().size(), snapshot_hdmap_utils.getLaneletIds().size());
+  for (const auto lanelet_id : osm_hdmap_utils.getLaneletIds()) {
+    EXPECT_EQ(
+      osm_hdmap_utils.getCenterPoints(lanelet_id),
+      snapshot_hdmap_utils.getCenterPoints(lanelet_id));
+    EXPECT_DOUBLE_EQ(
+      osm_hdmap_utils.getLaneletLength(lanelet_id),
+      snapshot_hdmap_utils.getLaneletLength(lanelet_id));
+    EXPECT_EQ(
+      osm_hdmap_utils.getNextLaneletIds(lanelet_id),
+      snapshot_hdmap_utils.getNextLaneletIds(lanelet_id));
+  }
+
+  std::ofstream(copied_path.string(), std::ios::app) << "\n";
+  EXPECT_FALSE(hdmap_utils::MapSnapshot::open(
+    hdmap_utils::MapSnapshot::getPath(copied_path), copied_path));
+  boost::filesystem::remove_all(directory);
+}
+
+/**
+ * @note Testcase for the adjacency tables built at map load.
+ * Next lanelets of a turn direction are supposed to be among all next lanelets.
+ */
+/**
+ * @note Testcase for the adjacency tables of HdMapUtils.
+ * Every query for every lanelet of the map is supposed to return what the routing graphs (and the
+ * road shoulders) return for it, in the same order.
+ */
+TEST(HdMapUtils, LaneletAdjacencyTables)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  const auto lanelet_map = hdmap_utils.getLaneletMap();
+  const auto vehicle_traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
+  const auto vehicle_routing_graph =
+    lanelet::routing::RoutingGraph::build(*lanelet_map, *vehicle_traffic_rules);
+  const auto pedestrian_traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
+  const auto pedestrian_routing_graph =
+    lanelet::routing::RoutingGraph::build(*lanelet_map, *pedestrian_traffic_rules);
+  const auto shoulder_lanelets =
+    lanelet::utils::query::shoulderLanelets(lanelet::utils::query::laneletLayer(lanelet_map));
+  const auto ids = [](const auto & lanelets, const std::string & turn_direction = "") {
+    lanelet::Ids lanelet_ids;
+    for (const auto & lanelet_obj : lanelets) {
+      if (
+        turn_direction.empty() or
+        lanelet_obj.attributeOr("turn_direction", "else") == turn_direction) {
+        lanelet_ids.push_back(lanelet_obj.id());
+      }
+    }
+    return lanelet_ids;
+  };
+  traffic_simulator_msgs::msg::EntityType vehicle, pedestrian;
+  vehicle.type = traffic_simulator_msgs::msg::EntityType::VEHICLE;
+  pedestrian.type = traffic_simulator_msgs::msg::EntityType::PEDESTRIAN;
+  for (const auto & lanelet_obj : lanelet_map->laneletLayer) {
+    const auto id = lanelet_obj.id();
+    auto next_ids = ids(vehicle_routing_graph->following(lanelet_obj));
+    auto previous_ids = ids(vehicle_routing_graph->previous(lanelet_obj));
+    for (const auto & shoulder_lanelet : shoulder_lanelets) {
+      if (lanelet::geometry::follows(lanelet_obj, shoulder_lanelet)) {
+        next_ids.push_back(shoulder_lanelet.id());
+      }
+      if (lanelet::geometry::follows(shoulder_lanelet, lanelet_obj)) {
+        previous_ids.push_back(shoulder_lanelet.id());
+      }
+    }
+    EXPECT_EQ(lanelet::Ids(hdmap_utils.getNextLaneletIds(id)), next_ids) << id;
+    EXPECT_EQ(lanelet::Ids(hdmap_utils.getPreviousLaneletIds(id)), previous_ids) << id;
+    for (const auto turn_direction : {"straight", "left", "right", "else", "no such direction"}) {
+      EXPECT_EQ(
+        lanelet::Ids(hdmap_utils.getNextLaneletIds(id, turn_direction)),
+        ids(vehicle_routing_graph->following(lanelet_obj), turn_direction))
+        << id << " " << turn_direction;
+      EXPECT_EQ(
+        lanelet::Ids(hdmap_utils.getPreviousLaneletIds(id, turn_direction)),
+        ids(vehicle_routing_graph->previous(lanelet_obj), turn_direction))
+        << id << " " << turn_direction;
+    }
+    for (const auto & [type, routing_graph] :
+         {std::make_pair(vehicle, vehicle_routing_graph.get()),
+          std::make_pair(pedestrian, pedestrian_routing_graph.get())}) {
+      EXPECT_EQ(
+        lanelet::Ids(hdmap_utils.getLeftLaneletIds(id, type, true)),
+        ids(routing_graph->lefts(lanelet_obj)))
+        << id;
+      EXPECT_EQ(
+        lanelet::Ids(hdmap_utils.getLeftLaneletIds(id, type, false)),
+        ids(routing_graph->adjacentLefts(lanelet_obj)))
+        << id;
+      EXPECT_EQ(
+        lanelet::Ids(hdmap_utils.getRightLaneletIds(id, type, true)),
+        ids(routing_graph->rights(lanelet_obj)))
+        << id;
+      EXPECT_EQ(
+        lanelet::Ids(hdmap_utils.getRightLaneletIds(id, type, false)),
+        ids(routing_graph->adjacentRights(lanelet_obj)))
+        << id;
+    }
+  }
+  EXPECT_THROW(hdmap_utils.getNextLaneletIds(-1), lanelet::NoSuchPrimitiveError);
+}
+
+/**
+ * @note Testcase for the conflict tables of HdMapUtils.
+ * Conflicting lanes, conflicting crosswalks and right of way lanelets of every lanelet of the map
+ * are supposed to be what lanelet2 returns for it, in the same order.
+ */
+TEST(HdMapUtils, LaneletConflictTables)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  hdmap_utils::HdMapUtils hdmap_utils(path, origin);
+  const auto lanelet_map = hdmap_utils.getLaneletMap();
+  const auto vehicle_traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
+  const lanelet::routing::RoutingGraphConstPtr vehicle_routing_graph =
+    lanelet::routing::RoutingGraph::build(*lanelet_map, *vehicle_traffic_rules);
+  const auto pedestrian_traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
+  const lanelet::routing::RoutingGraphConstPtr pedestrian_routing_graph =
+    lanelet::routing::RoutingGraph::build(*lanelet_map, *pedestrian_traffic_rules);
+  const lanelet::routing::RoutingGraphContainer container(
+    std::vector<lanelet::routing::RoutingGraphConstPtr>{
+      vehicle_routing_graph, pedestrian_routing_graph});
+  const auto ids = [](const auto & lanelets) {
+    lanelet::Ids lanelet_ids;
+    for (const auto & lanelet_obj : lanelets) {
+      lanelet_ids.push_back(lanelet_obj.id());
+    }
+    return lanelet_ids;
+  };
+  lanelet::Ids route, all_conflicting_lane_ids, all_conflicting_crosswalk_ids;
+  for (const auto & lanelet_obj : lanelet_map->laneletLayer) {
+    const auto id = lanelet_obj.id();
+    const auto conflicting_lane_ids =
+      ids(lanelet::utils::getConflictingLanelets(vehicle_routing_graph, lanelet_obj));
+    const auto conflicting_crosswalk_ids = ids(container.conflictingInGraph(lanelet_obj, 1, 4));
+    lanelet::Ids right_of_way_ids;
+    for (const auto & right_of_way : lanelet_obj.regulatoryElementsAs<lanelet::RightOfWay>()) {
+      for (const auto & right_of_way_lanelet : right_of_way->rightOfWayLanelets()) {
+        if (right_of_way_lanelet.id() != id) {
+          right_of_way_ids.push_back(right_of_way_lanelet.id());
+        }
+      }
+    }
+    EXPECT_EQ(hdmap_utils.getConflictingLaneIds({id}), conflicting_lane_ids) << id;
+    EXPECT_EQ(hdmap_utils.getConflictingCrosswalkIds({id}), conflicting_crosswalk_ids) << id;
+    EXPECT_EQ(lanelet::Ids(hdmap_utils.getRightOfWayLaneletIds(id)), right_of_way_ids) << id;
+    const auto route_conflicts = hdmap_utils.getRouteConflicts({id});
+    EXPECT_EQ(route_conflicts.lanes, sortAndUnique(conflicting_lane_ids)) << id;
+    EXPECT_EQ(route_conflicts.crosswalks, sortAndUnique(conflicting_crosswalk_ids)) << id;
+    route.push_back(id);
+    all_conflicting_lane_ids.insert(
+      all_conflicting_lane_ids.end(), conflicting_lane_ids.begin(), conflicting_lane_ids.end());
+    all_conflicting_crosswalk_ids.insert(
+      all_conflicting_crosswalk_ids.end(), conflicting_crosswalk_ids.begin(),
+      conflicting_crosswalk_ids.end());
+  }
+  /// @note the sample map has intersections and crosswalks, so the tables are not all empty
+  EXPECT_FALSE(all_conflicting_lane_ids.empty());
+  EXPECT_FALSE(all_conflicting_crosswalk_ids.empty());
+  EXPECT_EQ(hdmap_utils.getConflictingLaneIds(route), all_conflicting_lane_ids);
+  EXPECT_EQ(hdmap_utils.getConflictingCrosswalkIds(route), all_conflicting_crosswalk_ids);
+  const auto route_conflicts = hdmap_utils.getRouteConflicts(route);
+  EXPECT_EQ(route_conflicts.lanes, sortAndUnique(all_conflicting_lane_ids));
+  EXPECT_EQ(route_conflicts.crosswalks, sortAndUnique(all_conflicting_crosswalk_ids));
+  for (const auto lanelet_id : all_conflicting_crosswalk_ids) {
+    EXPECT_TRUE(route_conflicts.containsCrosswalk(lanelet_id));
+  }
+  EXPECT_THROW(hdmap_utils.getRightOfWayLaneletIds(-1), lanelet::NoSuchPrimitiveError);
+}
+
+TEST(CanonicalizedLaneletPose, LazyMapPose)
+{
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  const auto hdmap_utils = std::make_shared<hdmap_utils::HdMapUtils>(path, origin);
+  for (const auto s : {2.0, 30.0}) {
+    const auto lanelet_pose = traffic_simulator::helper::constructLaneletPose(34981, s, 0);
+    const auto canonicalized_lanelet_pose =
+      std::get<std::optional<traffic_simulator::LaneletPose>>(
+        hdmap_utils->canonicalizeLaneletPose(lanelet_pose))
+        .value();
+    const traffic_simulator::CanonicalizedLaneletPose pose(lanelet_pose, hdmap_utils);
+    const auto copied_pose = pose;
+    EXPECT_EQ(static_cast<traffic_simulator::LaneletPose>(pose), canonicalized_lanelet_pose);
+    EXPECT_EQ(
+      static_cast<geometry_msgs::msg::Pose>(copied_pose),
+      hdmap_utils->toMapPose(canonicalized_lanelet_pose).pose);
+    EXPECT_EQ(
+      pose.hasAlternativeLaneletPose(),
+      hdmap_utils->getAllCanonicalizedLaneletPoses(lanelet_pose).size() > 1);
+  }
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,73 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <traffic_simulator/traffic/traffic_sink_grid.hpp>
+#include <vector>
+
+auto makePoint(double x, double y, double z = 0.0) -> geometry_msgs::msg::Point
+{
+  geometry_msgs::msg::Point point;
+  point.x = x;
+  point.y = y;
+  point.z = z;
+  return point;
+}
+
+TEST(TrafficSinkGrid, Empty)
+{
+  traffic_simulator::traffic::TrafficSinkGrid grid;
+  EXPECT_TRUE(grid.empty());
+  EXPECT_FALSE(grid.contains(makePoint(0.0, 0.0)));
+}
+
+TEST(TrafficSinkGrid, Radius)
+{
+  traffic_simulator::traffic::TrafficSinkGrid grid;
+  grid.add(makePoint(10.0, -10.0), 1.0);
+  EXPECT_TRUE(grid.contains(makePoint(10.0, -10.0)));
+  EXPECT_TRUE(grid.contains(makePoint(10.0, -9.0)));
+  EXPECT_FALSE(grid.contains(makePoint(10.0, -8.9)));
+  EXPECT_FALSE(grid.contains(makePoint(10.0, -10.0, 1.5)));
+}
+
+TEST(TrafficSinkGrid, SameAsLinearSearch)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> coordinate(-100.0, 100.0);
+  std::uniform_real_distribution<double> radius(0.5, 5.0);
+  traffic_simulator::traffic::TrafficSinkGrid grid;
+  std::vector<std::pair<geometry_msgs::msg::Point, double>> sinks;
+  for (int i = 0; i < 300; ++i) {
+    sinks.emplace_back(makePoint(coordinate(engine), coordinate(engine)), radius(engine));
+    grid.add(sinks.back().first, sinks.back().second);
+  }
+  for (int i = 0; i < 10000; ++i) {
+    const auto point = makePoint(coordinate(engine), coordinate(engine));
+    bool expected = false;
+    for (const auto & [position, sink_radius] : sinks) {
+      expected = expected or std::hypot(position.x - point.x, position.y - point.y) <= sink_radius;
+    }
+    EXPECT_EQ(grid.contains(point), expected);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <scenario_simulator_exception/exception.hpp>
+#include <string>
+#include <traffic_simulator/traffic/traffic_source.hpp>
+#include <vector>
+
+class TrafficSourceTest : public testing::Test
+{
+protected:
+  TrafficSourceTest()
+  : source(
+      "source", 1.0, geometry_msgs::msg::Pose(), 4.0, [this]() { return current_time; },
+      [this]() {
+        std::vector<std::string> names;
+        for (const auto & [name, pose] : entities) {
+          names.push_back(name);
+        }
+        return names;
+      },
+      [this](const auto & name) { return entities.at(name); },
+      [this](const auto & name, const auto & pose) {
+        spawned_names.push_back(name);
+        entities.emplace(name, pose);
+        return true;
+      })
+  {
+  }
+
+  /// @brief Move every entity 1 [m] along x and despawn those beyond 25 [m].
+  auto step() -> void
+  {
+    for (auto iter = entities.begin(); iter != entities.end();) {
+      if ((iter->second.position.x += 1.0) > 25.0) {
+        iter = entities.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+
+  double current_time = 0.0;
+  std::map<std::string, geometry_msgs::msg::Pose> entities;
+  std::vector<std::string> spawned_names;
+  traffic_simulator::traffic::TrafficSource source;
+};
+
+TEST_F(TrafficSourceTest, SpawnAtRate)
+{
+  for (int i = 0; i < 20; ++i) {
+    current_time = i * 0.1;
+    step();
+    source.execute();
+  }
+  EXPECT_EQ(spawned_names, (std::vector<std::string>{"source_0", "source_1"}));
+}
+
+TEST_F(TrafficSourceTest, WaitForClearance)
+{
+  source.execute();
+  current_time = 10.0;
+  source.execute();
+  EXPECT_EQ(spawned_names.size(), 1u);
+  entities.at("source_0").position.x = 4.0;
+  source.execute();
+  EXPECT_EQ(spawned_names.size(), 2u);
+}
+
+TEST_F(TrafficSourceTest, ReuseNamesOfDespawnedEntities)
+{
+  for (int i = 0; i < 60; ++i) {
+    current_time = i * 0.1;
+    step();
+    source.execute();
+  }
+  EXPECT_EQ(
+    spawned_names, (std::vector<std::string>{
+                     "source_0", "source_1", "source_2", "source_0", "source_1", "source_2"}));
+}
+
+TEST_F(TrafficSourceTest, SkipNamesOfOtherEntities)
+{
+  geometry_msgs::msg::Pose far_pose;
+  far_pose.position.x = 100.0;
+  entities.emplace("source_0", far_pose);
+  entities.emplace("source_2", far_pose);
+  source.execute();
+  current_time = 10.0;
+  entities.at("source_1").position.x = 4.0;
+  source.execute();
+  EXPECT_EQ(spawned_names, (std::vector<std::string>{"source_1", "source_3"}));
+}
+
+TEST(TrafficSource, RejectNonPositiveRate)
+{
+  for (const auto rate : {0.0, -1.0}) {
+    EXPECT_THROW(
+      traffic_simulator::traffic::TrafficSource(
+        "source", rate, geometry_msgs::msg::Pose(), 4.0, []() { return 0.0; },
+        []() { return std::vector<std::string>(); },
+        [](const auto &) { return geometry_msgs::msg::Pose(); },
+        [](const auto &, const auto &) { return true; }),
+      common::SemanticError);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
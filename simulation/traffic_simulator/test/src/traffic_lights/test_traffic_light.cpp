@@ -367,6 +367,50 @@ TEST(TrafficLight, TrafficLight)
   }
 }
 
+TEST(TrafficLight, Version)
+{
+  using TrafficLight = traffic_simulator::TrafficLight;
+  using Color = TrafficLight::Color;
+  using Status = TrafficLight::Status;
+  using Shape = TrafficLight::Shape;
+
+  hdmap_utils::HdMapUtils map_manager(
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm",
+    []() {
+      geographic_msgs::msg::GeoPoint geo_point;
+      geo_point.latitude = 35.61836750154;
+      geo_point.longitude = 139.78066608243;
+      return geo_point;
+    }());
+
+  auto traffic_light = TrafficLight(34802, map_manager);
+  const auto initial_version = traffic_light.getVersion();
+
+  traffic_light.set("red solidOn circle");
+  const auto red_version = traffic_light.getVersion();
+  EXPECT_NE(red_version, initial_version);
+
+  traffic_light.assign("red solidOn circle");
+  EXPECT_EQ(traffic_light.getVersion(), red_version);
+
+  traffic_light.emplace(Color::red, Status::solid_on, Shape::circle);
+  EXPECT_EQ(traffic_light.getVersion(), red_version);
+
+  traffic_light.emplace(Color::green, Status::solid_on, Shape::right);
+  const auto arrow_version = traffic_light.getVersion();
+  EXPECT_NE(arrow_version, red_version);
+
+  traffic_light.assign("red solidOn circle, green solidOn left");
+  const auto left_arrow_version = traffic_light.getVersion();
+  EXPECT_NE(left_arrow_version, arrow_version);
+
+  traffic_light.clear();
+  const auto cleared_version = traffic_light.getVersion();
+  EXPECT_NE(cleared_version, left_arrow_version);
+  traffic_light.clear();
+  EXPECT_EQ(traffic_light.getVersion(), cleared_version);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -90,6 +90,54 @@ TEST(TrafficLightManager, setArrow)
   }
 }
 
+TEST(TrafficLightManager, generateUpdateTrafficLightsDelta)
+{
+  const auto node = std::make_shared<rclcpp::Node>("generateUpdateTrafficLightsDelta");
+  std::string path =
+    ament_index_cpp::get_package_share_directory("traffic_simulator") + "/map/lanelet2_map.osm";
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = 35.61836750154;
+  origin.longitude = 139.78066608243;
+  const auto hdmap_utils_ptr = std::make_shared<hdmap_utils::HdMapUtils>(path, origin);
+  traffic_simulator::TrafficLightManager manager(hdmap_utils_ptr);
+  manager.getTrafficLight(34836).set("red");
+  manager.getTrafficLight(34802).set("green");
+
+  const auto keyframe = manager.generateUpdateTrafficLightsDelta();
+  ASSERT_TRUE(keyframe);
+  EXPECT_FALSE(keyframe->delta());
+  EXPECT_EQ(keyframe->states_size(), 2);
+  EXPECT_FALSE(manager.hasAnyLightChanged());
+  EXPECT_FALSE(manager.generateUpdateTrafficLightsDelta());
+
+  manager.getTrafficLight(34836).assign("red");
+  EXPECT_FALSE(manager.hasAnyLightChanged());
+
+  manager.getTrafficLight(34802).assign("green, green solidOn left");
+  EXPECT_TRUE(manager.hasAnyLightChanged());
+  const auto delta = manager.generateUpdateTrafficLightsDelta();
+  ASSERT_TRUE(delta);
+  EXPECT_TRUE(delta->delta());
+  ASSERT_EQ(delta->states_size(), 1);
+  EXPECT_EQ(delta->states(0).id(), 34802);
+  EXPECT_EQ(delta->states(0).traffic_light_status_size(), 2);
+
+  for (std::size_t i = 3; i < traffic_simulator::TrafficLightManager::keyframe_interval; ++i) {
+    EXPECT_FALSE(manager.generateUpdateTrafficLightsDelta());
+  }
+  const auto next_keyframe = manager.generateUpdateTrafficLightsDelta();
+  ASSERT_TRUE(next_keyframe);
+  EXPECT_FALSE(next_keyframe->delta());
+  EXPECT_EQ(next_keyframe->states_size(), 2);
+
+  manager.getTrafficLight(34836).assign("yellow");
+  const auto full = manager.generateUpdateTrafficLightsDelta(false);
+  ASSERT_TRUE(full);
+  EXPECT_FALSE(full->delta());
+  EXPECT_EQ(full->states_size(), 2);
+  EXPECT_FALSE(manager.generateUpdateTrafficLightsDelta(false));
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
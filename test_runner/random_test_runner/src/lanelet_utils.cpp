@@ -29,6 +29,10 @@
 
 LaneletUtils::LaneletUtils(const boost::filesystem::path & filename)
 {
+  /**
+   * @note The map of HdMapUtils is not shared here: its centerlines are resampled, which would
+   * change the lengths and costs of the routing graph and so the generated test cases.
+   */
   lanelet::projection::MGRSProjector projector;
   lanelet::ErrorMessages errors;
   lanelet_map_ptr_ = lanelet::load(filename.string(), projector, &errors);
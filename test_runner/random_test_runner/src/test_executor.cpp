@@ -17,6 +17,8 @@
 #include "random_test_runner/test_executor.hpp"
 
 #include <rclcpp/rclcpp.hpp>
+#include <set>
+#include <string>
 
 #include "random_test_runner/file_interactions/junit_xml_reporter.hpp"
 #include "random_test_runner/file_interactions/yaml_test_params_saver.hpp"
@@ -128,8 +130,16 @@ void TestExecutor::update(double current_time)
     }
   }
   if (simulator_type_ == SimulatorType::SIMPLE_SENSOR_SIMULATOR) {
+    std::set<std::string> npcs_colliding_with_ego;
+    for (const auto & [name0, name1] : api_->getCollidingEntities()) {
+      if (name0 == ego_name_) {
+        npcs_colliding_with_ego.insert(name1);
+      } else if (name1 == ego_name_) {
+        npcs_colliding_with_ego.insert(name0);
+      }
+    }
     for (const auto & npc : test_description_.npcs_descriptions) {
-      if (api_->entityExists(npc.name) && api_->checkCollision(ego_name_, npc.name)) {
+      if (npcs_colliding_with_ego.count(npc.name)) {
         if (ego_collision_metric_.isThereEgosCollisionWith(npc.name, current_time)) {
           std::string message = fmt::format("New collision occurred between ego and {}", npc.name);
           RCLCPP_INFO_STREAM(logger_, message);